@@ -106,6 +106,25 @@ char **pmix_argv_copy(char **argv);
 pmix_status_t pmix_setenv(const char *name, const char *value,
                           bool overwrite, char ***env);
 
+/* Retrieve information for an array of (proc, key) pairs in a single
+ * call - e.g., the same key(s) from many peers during wireup. This is
+ * not part of the PMIx Standard. Requests that can be satisfied from
+ * the local data stores are served in a single pass, the remaining
+ * ones are retrieved as per PMIx_Get. Only the PMIX_DATA_SCOPE directive
+ * is honored by the local pass - any other directive causes all
+ * requests to be handled as per PMIx_Get.
+ *
+ * The _vals_ array must be able to hold _nreqs_ pointers; each returned
+ * value must be released by the caller. The status of each request is
+ * returned in the corresponding element of the _status_ array.
+ *
+ * Returns PMIX_SUCCESS if all requests succeeded, or the status of the
+ * first failed request otherwise. */
+pmix_status_t pmix_get_batch(const pmix_proc_t procs[], const char *keys[],
+                             size_t nreqs,
+                             const pmix_info_t info[], size_t ninfo,
+                             pmix_value_t *vals[], pmix_status_t status[]);
+
 
 #if defined(c_plusplus) || defined(__cplusplus)
 }
@@ -48,7 +48,8 @@ PMIX_EXPORT pmix_class_t pmix_object_t_class = {
     0,                    /* class hierarchy depth */
     NULL,                 /* array of constructors */
     NULL,                 /* array of destructors */
-    sizeof(pmix_object_t) /* size of the pmix object */
+    sizeof(pmix_object_t), /* size of the pmix object */
+    0                     /* no object pool */
 };
 
 int pmix_class_init_epoch = 1;
@@ -69,6 +70,34 @@ static const int increment = 10;
 static void save_class(pmix_class_t *cls);
 static void expand_array(void);
 
+/*
+ * Object pools
+ */
+int pmix_obj_pool_max = 0;
+#if PMIX_HAVE_THREAD_LOCAL
+pmix_thread_local pmix_obj_pool_cache_t pmix_obj_pool_caches[PMIX_OBJ_POOL_MAX_CLASSES];
+/* bumped by every finalize of the pools, a thread registered in
+ * an older epoch has to register again */
+int pmix_obj_pool_epoch = 1;
+pmix_thread_local int pmix_obj_pool_thread_epoch = 0;
+
+static pmix_class_t *pool_classes[PMIX_OBJ_POOL_MAX_CLASSES];
+/* counters of the threads that have exited */
+static size_t pool_hits[PMIX_OBJ_POOL_MAX_CLASSES];
+static size_t pool_misses[PMIX_OBJ_POOL_MAX_CLASSES];
+/* pool 0 means no pool */
+static int num_pools = 1;
+static pthread_key_t pool_key;
+/* threads that use the pools, so their counters can be read */
+typedef struct pool_thread_t {
+    struct pool_thread_t *next;
+    struct pool_thread_t *prev;
+    pmix_obj_pool_cache_t *caches;
+} pool_thread_t;
+static pool_thread_t pool_threads = {&pool_threads, &pool_threads, NULL};
+static pmix_thread_local pool_thread_t pool_thread;
+#endif
+
 
 /*
  * Lazy initialization of class descriptor.
@@ -224,3 +253,159 @@ static void expand_array(void)
         classes[i] = NULL;
     }
 }
+
+
+#if PMIX_HAVE_THREAD_LOCAL
+/* free the objects held in the caches and fold their counters
+ * into the totals - the class mutex must be held */
+static void drain_caches(pmix_obj_pool_cache_t *caches)
+{
+    pmix_obj_pool_cache_t *cache;
+    pmix_object_t *object;
+    int i;
+
+    for (i = 1; i < PMIX_OBJ_POOL_MAX_CLASSES; ++i) {
+        cache = &caches[i];
+        while (NULL != (object = cache->head)) {
+            cache->head = *(pmix_object_t **) object;
+            free(object);
+        }
+        cache->count = 0;
+        pool_hits[i] += cache->hits;
+        pool_misses[i] += cache->misses;
+        cache->hits = 0;
+        cache->misses = 0;
+    }
+}
+
+/* called when a thread that pooled objects exits */
+static void pool_thread_exit(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&class_mutex);
+    drain_caches(pmix_obj_pool_caches);
+    pool_thread.prev->next = pool_thread.next;
+    pool_thread.next->prev = pool_thread.prev;
+    pthread_mutex_unlock(&class_mutex);
+}
+#endif
+
+
+pmix_status_t pmix_class_pool_enable(pmix_class_t *cls)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pthread_mutex_lock(&class_mutex);
+    if (0 < cls->cls_pool) {
+        /* already has one */
+    } else if (PMIX_OBJ_POOL_MAX_CLASSES <= num_pools) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+    } else {
+        if (1 == num_pools &&
+            0 != pthread_key_create(&pool_key, pool_thread_exit)) {
+            pthread_mutex_unlock(&class_mutex);
+            return PMIX_ERROR;
+        }
+        pool_classes[num_pools] = cls;
+        cls->cls_pool = num_pools;
+        ++num_pools;
+    }
+    pthread_mutex_unlock(&class_mutex);
+    return rc;
+#else
+    (void)cls;
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
+
+
+void pmix_class_pool_drain(void)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pthread_mutex_lock(&class_mutex);
+    drain_caches(pmix_obj_pool_caches);
+    pthread_mutex_unlock(&class_mutex);
+#endif
+}
+
+
+void pmix_class_pool_finalize(void)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pool_thread_t *thread;
+    int i;
+
+    pthread_mutex_lock(&class_mutex);
+    if (1 < num_pools) {
+        /* no other thread may be using PMIx objects by now, so
+         * their caches can be emptied from here */
+        for (thread = pool_threads.next; thread != &pool_threads; thread = thread->next) {
+            drain_caches(thread->caches);
+        }
+        drain_caches(pmix_obj_pool_caches);
+        pool_threads.next = &pool_threads;
+        pool_threads.prev = &pool_threads;
+        for (i = 1; i < num_pools; ++i) {
+            pool_classes[i]->cls_pool = 0;
+            pool_classes[i] = NULL;
+            pool_hits[i] = 0;
+            pool_misses[i] = 0;
+        }
+        num_pools = 1;
+        (void)pthread_key_delete(pool_key);
+    }
+    /* threads registered so far have to register with the next key */
+    if (INT_MAX == pmix_obj_pool_epoch) {
+        pmix_obj_pool_epoch = 1;
+    } else {
+        pmix_obj_pool_epoch++;
+    }
+    pthread_mutex_unlock(&class_mutex);
+#endif
+}
+
+
+void pmix_class_pool_stats(pmix_class_t *cls, size_t *hits, size_t *misses)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pool_thread_t *thread;
+    int pool = cls->cls_pool;
+#endif
+
+    *hits = 0;
+    *misses = 0;
+#if PMIX_HAVE_THREAD_LOCAL
+    pthread_mutex_lock(&class_mutex);
+    if (0 < pool && pool_classes[pool] == cls) {
+        *hits = pool_hits[pool];
+        *misses = pool_misses[pool];
+        /* the counters of running threads are read while their
+         * owners update them, so the sum is only approximate */
+        for (thread = pool_threads.next; thread != &pool_threads; thread = thread->next) {
+            *hits += thread->caches[pool].hits;
+            *misses += thread->caches[pool].misses;
+        }
+    }
+    pthread_mutex_unlock(&class_mutex);
+#else
+    (void)cls;
+#endif
+}
+
+
+void pmix_obj_pool_register_thread(void)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    /* have the pools of the thread released when it exits */
+    pthread_mutex_lock(&class_mutex);
+    pmix_obj_pool_thread_epoch = pmix_obj_pool_epoch;
+    pool_thread.caches = pmix_obj_pool_caches;
+    pool_thread.next = pool_threads.next;
+    pool_thread.prev = &pool_threads;
+    pool_threads.next->prev = &pool_thread;
+    pool_threads.next = &pool_thread;
+    pthread_mutex_unlock(&class_mutex);
+    (void)pthread_setspecific(pool_key, &pmix_obj_pool_thread_epoch);
+#endif
+}
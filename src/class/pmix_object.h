@@ -165,6 +165,7 @@ struct pmix_class_t {
     pmix_destruct_t *cls_destruct_array;
                                     /**< array of parent class destructors */
     size_t cls_sizeof;              /**< size of an object instance */
+    int cls_pool;                   /**< object pool of the class, 0 if none */
 };
 
 PMIX_EXPORT extern int pmix_class_init_epoch;
@@ -228,7 +229,7 @@ struct pmix_object_t {
         (pmix_construct_t) CONSTRUCTOR,                                 \
         (pmix_destruct_t) DESTRUCTOR,                                   \
         0, 0, NULL, NULL,                                               \
-        sizeof(NAME)                                                    \
+        sizeof(NAME), 0                                                 \
     }
 
 
@@ -322,7 +323,7 @@ static inline pmix_object_t *pmix_obj_new_debug(pmix_class_t* type, const char*
             PMIX_SET_MAGIC_ID((object), 0);                              \
             pmix_obj_run_destructors((pmix_object_t *) (object));       \
             PMIX_REMEMBER_FILE_AND_LINENO( object, __FILE__, __LINE__ ); \
-            free(object);                                               \
+            pmix_obj_free((pmix_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -331,7 +332,7 @@ static inline pmix_object_t *pmix_obj_new_debug(pmix_class_t* type, const char*
     do {                                                                \
         if (0 == pmix_obj_update((pmix_object_t *) (object), -1)) {     \
             pmix_obj_run_destructors((pmix_object_t *) (object));       \
-            free(object);                                               \
+            pmix_obj_free((pmix_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -409,6 +410,63 @@ PMIX_EXPORT void pmix_class_initialize(pmix_class_t *);
  */
 PMIX_EXPORT int pmix_class_finalize(void);
 
+/**
+ * Object pools.
+ *
+ * Classes that are created and released at a high rate can be given
+ * a pool: released objects of the class are kept on a per-thread
+ * free list (up to pmix_obj_pool_max of them) and handed out again
+ * by PMIX_NEW instead of going back to malloc. A thread's free lists
+ * are returned to the system when the thread exits.
+ */
+#define PMIX_OBJ_POOL_MAX_CLASSES  16
+
+typedef struct {
+    pmix_object_t *head;
+    int count;
+    size_t hits;
+    size_t misses;
+} pmix_obj_pool_cache_t;
+
+/* max number of objects kept per class and thread, 0 disables the pools */
+PMIX_EXPORT extern int pmix_obj_pool_max;
+#if PMIX_HAVE_THREAD_LOCAL
+PMIX_EXPORT extern pmix_thread_local pmix_obj_pool_cache_t pmix_obj_pool_caches[PMIX_OBJ_POOL_MAX_CLASSES];
+PMIX_EXPORT extern int pmix_obj_pool_epoch;
+PMIX_EXPORT extern pmix_thread_local int pmix_obj_pool_thread_epoch;
+#endif
+
+/**
+ * Give the class a pool. The pool stays with the class until
+ * pmix_class_pool_finalize.
+ *
+ * @return PMIX_SUCCESS, or PMIX_ERR_NOT_SUPPORTED if no more pools can
+ * be created or the compiler has no thread local storage
+ */
+PMIX_EXPORT pmix_status_t pmix_class_pool_enable(pmix_class_t *cls);
+
+/**
+ * Return the objects held by the calling thread to the system
+ */
+PMIX_EXPORT void pmix_class_pool_drain(void);
+
+/**
+ * Release the objects held by all threads and the pools themselves.
+ * The classes go back to malloc until their pools are enabled again.
+ * No other thread may be using PMIx objects when this is called.
+ */
+PMIX_EXPORT void pmix_class_pool_finalize(void);
+
+/**
+ * Number of PMIX_NEW calls on the class that were served from a pool
+ * (hits) or had to go to malloc (misses), summed over all threads.
+ * The counters of running threads are not synchronized, so the
+ * numbers are approximate while other threads use the pool
+ */
+PMIX_EXPORT void pmix_class_pool_stats(pmix_class_t *cls, size_t *hits, size_t *misses);
+
+PMIX_EXPORT void pmix_obj_pool_register_thread(void);
+
 /**
  * Run the hierarchy of class constructors for this object, in a
  * parent-first order.
@@ -457,6 +515,64 @@ static inline void pmix_obj_run_destructors(pmix_object_t * object)
 }
 
 
+/**
+ * Get storage for an object of the class, from the pool of the
+ * calling thread if the class has one.
+ *
+ * Do not use this function directly: use PMIX_NEW() instead.
+ */
+static inline pmix_object_t *pmix_obj_alloc(pmix_class_t *cls)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pmix_obj_pool_cache_t *cache;
+    pmix_object_t *object;
+
+    if (0 < cls->cls_pool) {
+        cache = &pmix_obj_pool_caches[cls->cls_pool];
+        if (NULL != (object = cache->head)) {
+            cache->head = *(pmix_object_t **) object;
+            cache->count--;
+            cache->hits++;
+            return object;
+        }
+        if (pmix_obj_pool_epoch != pmix_obj_pool_thread_epoch) {
+            pmix_obj_pool_register_thread();
+        }
+        cache->misses++;
+    }
+#endif
+    return (pmix_object_t *) malloc(cls->cls_sizeof);
+}
+
+/**
+ * Return the storage of a destructed object, to the pool of the
+ * calling thread if the class has one with room left.
+ *
+ * Do not use this function directly: use PMIX_RELEASE() instead.
+ */
+static inline void pmix_obj_free(pmix_object_t *object)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pmix_obj_pool_cache_t *cache;
+    int pool = object->obj_class->cls_pool;
+
+    if (0 < pool) {
+        cache = &pmix_obj_pool_caches[pool];
+        if (cache->count < pmix_obj_pool_max) {
+            if (pmix_obj_pool_epoch != pmix_obj_pool_thread_epoch) {
+                pmix_obj_pool_register_thread();
+            }
+            /* the object is dead - link it through its first word */
+            *(pmix_object_t **) object = cache->head;
+            cache->head = object;
+            cache->count++;
+            return;
+        }
+    }
+#endif
+    free(object);
+}
+
 /**
  * Create new object: dynamically allocate storage and run the class
  * constructor.
@@ -472,7 +588,7 @@ static inline pmix_object_t *pmix_obj_new(pmix_class_t * cls)
     pmix_object_t *object;
     assert(cls->cls_sizeof >= sizeof(pmix_object_t));
 
-    object = (pmix_object_t *) malloc(cls->cls_sizeof);
+    object = pmix_obj_alloc(cls);
     if (pmix_class_init_epoch != cls->cls_initialized) {
         pmix_class_initialize(cls);
     }
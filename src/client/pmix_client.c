@@ -476,8 +476,8 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc,
     rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
     rcv->tag = PMIX_PTL_TAG_IOF;
     rcv->cbfunc = client_iof_handler;
-    /* add it to the end of the list of recvs */
-    pmix_list_append(&pmix_ptl_globals.posted_recvs, &rcv->super);
+    /* add it to the recvs */
+    pmix_ptl_base_add_posted_recv(rcv);
 
 
     /* setup the globals */
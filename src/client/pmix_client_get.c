@@ -71,6 +71,11 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr,
 
 static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata);
 
+static pmix_status_t _getfn_local(pmix_peer_t *peer, const pmix_proc_t *proc,
+                                  const char *key, pmix_scope_t scope,
+                                  const pmix_info_t info[], size_t ninfo,
+                                  pmix_value_t **val);
+
 static pmix_status_t _getfn_fastpath(const pmix_proc_t *proc, const pmix_key_t key,
                                      const pmix_info_t info[], size_t ninfo,
                                      pmix_value_t **val);
@@ -130,6 +135,147 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
     return rc;
 }
 
+PMIX_EXPORT pmix_status_t pmix_get_batch(const pmix_proc_t procs[], const char *keys[],
+                                         size_t nreqs,
+                                         const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t *vals[], pmix_status_t status[])
+{
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+    pmix_scope_t scope = PMIX_SCOPE_UNDEF;
+    bool direct = true;
+    size_t n, m, nbatch = 0;
+    size_t *idx = NULL;
+    pmix_proc_t *bprocs = NULL;
+    const char **bkeys = NULL;
+    pmix_value_t **bvals = NULL;
+    pmix_status_t *bstatus = NULL;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == procs || NULL == keys || NULL == vals || NULL == status || 0 == nreqs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    for (n=0; n < nreqs; n++) {
+        if (NULL == keys[n] || 0 == strlen(keys[n]) ||
+            PMIX_MAX_KEYLEN < strlen(keys[n]) ||
+            PMIX_RANK_UNDEF == procs[n].rank) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+    for (n=0; n < nreqs; n++) {
+        vals[n] = NULL;
+        status[n] = PMIX_ERR_NOT_FOUND;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get batch of %lu requests", (unsigned long)nreqs);
+
+    /* the data scope is honored by the data stores, any other
+     * directive may require the server's involvement */
+    for (n=0; n < ninfo; n++) {
+        if (0 == strncmp(info[n].key, PMIX_DATA_SCOPE, PMIX_MAX_KEYLEN)) {
+            scope = info[n].value.data.scope;
+        } else {
+            direct = false;
+        }
+    }
+    if (!direct) {
+        goto complete;
+    }
+
+    /* our own storage takes precedence, as for PMIx_Get */
+    for (n=0; n < nreqs; n++) {
+        status[n] = _getfn_local(pmix_globals.mypeer, &procs[n], keys[n],
+                                 scope, info, ninfo, &vals[n]);
+        if (PMIX_SUCCESS != status[n]) {
+            ++nbatch;
+        }
+    }
+    if (0 == nbatch || NULL == pmix_client_globals.myserver ||
+        NULL == pmix_client_globals.myserver->nptr) {
+        goto complete;
+    }
+    PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_client_globals.myserver);
+    if (PMIX_SUCCESS != rc) {
+        goto complete;
+    }
+
+    /* serve the rest from the server's data store in a single pass */
+    idx = (size_t*)malloc(nbatch * sizeof(size_t));
+    bprocs = (pmix_proc_t*)malloc(nbatch * sizeof(pmix_proc_t));
+    bkeys = (const char**)malloc(nbatch * sizeof(char*));
+    bvals = (pmix_value_t**)malloc(nbatch * sizeof(pmix_value_t*));
+    bstatus = (pmix_status_t*)malloc(nbatch * sizeof(pmix_status_t));
+    if (NULL == idx || NULL == bprocs || NULL == bkeys ||
+        NULL == bvals || NULL == bstatus) {
+        goto complete;
+    }
+    for (n=0, m=0; n < nreqs; n++) {
+        if (PMIX_SUCCESS != status[n]) {
+            idx[m] = n;
+            /* an empty nspace refers to our own */
+            if (0 == strlen(procs[n].nspace)) {
+                PMIX_LOAD_PROCID(&bprocs[m], pmix_globals.myid.nspace, procs[n].rank);
+            } else {
+                PMIX_LOAD_PROCID(&bprocs[m], procs[n].nspace, procs[n].rank);
+            }
+            bkeys[m] = keys[n];
+            ++m;
+        }
+    }
+    PMIX_GDS_FETCH_BATCH(rc, pmix_client_globals.myserver,
+                         bprocs, bkeys, nbatch, bvals, bstatus);
+    if (PMIX_SUCCESS == rc) {
+        for (m=0; m < nbatch; m++) {
+            pmix_value_t *val = bvals[m];
+            n = idx[m];
+            rc = bstatus[m];
+            if (PMIX_SUCCESS == rc && NULL != val) {
+                PMIX_VALUE_COMPRESSED_STRING_UNPACK(val);
+            }
+            status[n] = rc;
+            vals[n] = val;
+        }
+    }
+
+  complete:
+    for (n=0; n < nreqs; n++) {
+        if (!direct || PMIX_SUCCESS != status[n]) {
+            /* anything the data stores couldn't provide goes the usual way */
+            status[n] = PMIx_Get(&procs[n], keys[n], info, ninfo, &vals[n]);
+        }
+        if (PMIX_SUCCESS != status[n] && PMIX_SUCCESS == ret) {
+            ret = status[n];
+        }
+    }
+    if (NULL != idx) {
+        free(idx);
+    }
+    if (NULL != bprocs) {
+        free(bprocs);
+    }
+    if (NULL != bkeys) {
+        free(bkeys);
+    }
+    if (NULL != bvals) {
+        free(bvals);
+    }
+    if (NULL != bstatus) {
+        free(bstatus);
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get batch completed");
+
+    return ret;
+}
+
 PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const pmix_key_t key,
                                       const pmix_info_t info[], size_t ninfo,
                                       pmix_value_cbfunc_t cbfunc, void *cbdata)
@@ -483,53 +629,62 @@ static void infocb(pmix_status_t status,
     }
 }
 
+/* look for the key in the data store of the given peer */
+static pmix_status_t _getfn_local(pmix_peer_t *peer, const pmix_proc_t *proc,
+                                  const char *key, pmix_scope_t scope,
+                                  const pmix_info_t info[], size_t ninfo,
+                                  pmix_value_t **val)
+{
+    pmix_cb_t *cb;
+    pmix_status_t rc;
+
+    PMIX_GDS_FETCH_IS_TSAFE(rc, peer);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    cb = PMIX_NEW(pmix_cb_t);
+    cb->proc = (pmix_proc_t*)proc;
+    cb->scope = scope;
+    cb->copy = true;
+    cb->key = (char*)key;
+    cb->info = (pmix_info_t*)info;
+    cb->ninfo = ninfo;
+
+    PMIX_GDS_FETCH_KV(rc, peer, cb);
+    if (PMIX_SUCCESS == rc) {
+        rc = process_values(val, cb);
+        if (NULL != *val) {
+            PMIX_VALUE_COMPRESSED_STRING_UNPACK(*val);
+        }
+    }
+    PMIX_RELEASE(cb);
+    return rc;
+}
+
 static pmix_status_t _getfn_fastpath(const pmix_proc_t *proc, const pmix_key_t key,
                                      const pmix_info_t info[], size_t ninfo,
                                      pmix_value_t **val)
 {
-    pmix_cb_t *cb = PMIX_NEW(pmix_cb_t);
-    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_scope_t scope = PMIX_SCOPE_UNDEF;
+    pmix_status_t rc;
     size_t n;
 
     /* scan the incoming directives */
     if (NULL != info) {
         for (n=0; n < ninfo; n++) {
             if (0 == strncmp(info[n].key, PMIX_DATA_SCOPE, PMIX_MAX_KEYLEN)) {
-                cb->scope = info[n].value.data.scope;
+                scope = info[n].value.data.scope;
                 break;
             }
         }
     }
-    cb->proc = (pmix_proc_t*)proc;
-    cb->copy = true;
-    cb->key = (char*)key;
-    cb->info = (pmix_info_t*)info;
-    cb->ninfo = ninfo;
 
-    PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_globals.mypeer);
+    rc = _getfn_local(pmix_globals.mypeer, proc, key, scope, info, ninfo, val);
     if (PMIX_SUCCESS == rc) {
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
-        if (PMIX_SUCCESS == rc) {
-            goto done;
-        }
-    }
-    PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_client_globals.myserver);
-    if (PMIX_SUCCESS == rc) {
-        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, cb);
-        if (PMIX_SUCCESS == rc) {
-            goto done;
-        }
-    }
-    PMIX_RELEASE(cb);
-    return rc;
-
-  done:
-    rc = process_values(val, cb);
-    if (NULL != *val) {
-        PMIX_VALUE_COMPRESSED_STRING_UNPACK(*val);
+        return rc;
     }
-    PMIX_RELEASE(cb);
-    return rc;
+    return _getfn_local(pmix_client_globals.myserver, proc, key, scope, info, ninfo, val);
 }
 
 static void _getnbfn(int fd, short flags, void *cbdata)
@@ -817,7 +817,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
     pmix_status_t rc;
     pmix_list_t trk;
     pmix_namelist_t *nm;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_range_trkr_t rngtrk;
     pmix_proc_t proc;
 
@@ -882,13 +882,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                 ++nleft;
             } else {
                 /* look up the nspace for this proc */
-                nptr = NULL;
-                PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-                    if (PMIX_CHECK_NSPACE(tmp->nspace, cd->targets[n].nspace)) {
-                        nptr = tmp;
-                        break;
-                    }
-                }
+                nptr = pmix_server_nspace_lookup(cd->targets[n].nspace);
                 /* if we don't yet know it, then nothing to do */
                 if (NULL == nptr) {
                     nleft = SIZE_MAX;
@@ -55,6 +55,12 @@ typedef enum {
 PMIX_EXPORT pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo);
 PMIX_EXPORT void pmix_hwloc_cleanup(void);
 
+/* NUMA placement helpers, PMIX_ERR_NOT_SUPPORTED without hwloc.
+ * NUMA nodes are identified by their logical index */
+PMIX_EXPORT pmix_status_t pmix_hwloc_get_numa_count(int *count);
+PMIX_EXPORT pmix_status_t pmix_hwloc_bind_area_to_numa(void *addr, size_t size, int idx);
+PMIX_EXPORT pmix_status_t pmix_hwloc_get_local_numa(int *idx);
+
 END_C_DECLS
 
 #endif /* PMIX_HWLOC_INTERNAL_H */
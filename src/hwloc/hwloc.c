@@ -105,17 +105,20 @@ pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
 
     if (NULL == info || 0 == ninfo) {
         if (0 != hwloc_topology_init(&pmix_hwloc_topology)) {
+            pmix_hwloc_topology = NULL;
             return PMIX_ERR_INIT;
         }
 
         if (0 != set_flags(pmix_hwloc_topology, 0)) {
             hwloc_topology_destroy(pmix_hwloc_topology);
+            pmix_hwloc_topology = NULL;
             return PMIX_ERR_INIT;
         }
 
         if (0 != hwloc_topology_load(pmix_hwloc_topology)) {
             PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
             hwloc_topology_destroy(pmix_hwloc_topology);
+            pmix_hwloc_topology = NULL;
             return PMIX_ERR_NOT_SUPPORTED;
         }
         return PMIX_SUCCESS;
@@ -516,6 +519,93 @@ void pmix_hwloc_cleanup(void)
     return;
 }
 
+pmix_status_t pmix_hwloc_get_numa_count(int *count)
+{
+#if PMIX_HAVE_HWLOC
+    pmix_status_t rc;
+
+    if (NULL == pmix_hwloc_topology) {
+        if (PMIX_SUCCESS != (rc = pmix_hwloc_get_topology(NULL, 0))) {
+            return rc;
+        }
+    }
+    *count = hwloc_get_nbobjs_by_type(pmix_hwloc_topology, HWLOC_OBJ_NUMANODE);
+    return PMIX_SUCCESS;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
+
+pmix_status_t pmix_hwloc_bind_area_to_numa(void *addr, size_t size, int idx)
+{
+#if PMIX_HAVE_HWLOC
+    hwloc_obj_t obj;
+    int rc;
+
+    if (NULL == pmix_hwloc_topology) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    obj = hwloc_get_obj_by_type(pmix_hwloc_topology, HWLOC_OBJ_NUMANODE, idx);
+    if (NULL == obj) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* the pages may be populated already - move them */
+#if HWLOC_API_VERSION < 0x20000
+    rc = hwloc_set_area_membind_nodeset(pmix_hwloc_topology, addr, size, obj->nodeset,
+                                        HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE);
+#else
+    rc = hwloc_set_area_membind(pmix_hwloc_topology, addr, size, obj->nodeset, HWLOC_MEMBIND_BIND,
+                                HWLOC_MEMBIND_BYNODESET | HWLOC_MEMBIND_MIGRATE);
+#endif
+    return (0 == rc) ? PMIX_SUCCESS : PMIX_ERR_NOT_SUPPORTED;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
+
+pmix_status_t pmix_hwloc_get_local_numa(int *idx)
+{
+#if PMIX_HAVE_HWLOC
+    hwloc_bitmap_t cpuset;
+    hwloc_obj_t obj = NULL;
+    pmix_status_t rc;
+
+    /* use the topology shared with the other users in this process,
+     * it is only discovered if nobody did so before */
+    if (NULL == pmix_hwloc_topology) {
+        if (PMIX_SUCCESS != (rc = pmix_hwloc_get_topology(NULL, 0))) {
+            return rc;
+        }
+    }
+    if (NULL == (cpuset = hwloc_bitmap_alloc())) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = PMIX_ERR_NOT_FOUND;
+    /* an unbound process may run anywhere, take the node it runs on now */
+    if (0 != hwloc_get_cpubind(pmix_hwloc_topology, cpuset, HWLOC_CPUBIND_PROCESS) ||
+        hwloc_bitmap_iszero(cpuset) ||
+        hwloc_bitmap_isincluded(hwloc_topology_get_topology_cpuset(pmix_hwloc_topology), cpuset)) {
+        if (0 != hwloc_get_last_cpu_location(pmix_hwloc_topology, cpuset, HWLOC_CPUBIND_THREAD)) {
+            rc = PMIX_ERR_NOT_SUPPORTED;
+            goto cleanup;
+        }
+    }
+    while (NULL != (obj = hwloc_get_next_obj_by_type(pmix_hwloc_topology, HWLOC_OBJ_NUMANODE, obj))) {
+        if (hwloc_bitmap_isincluded(cpuset, obj->cpuset)) {
+            *idx = obj->logical_index;
+            rc = PMIX_SUCCESS;
+            break;
+        }
+    }
+
+cleanup:
+    hwloc_bitmap_free(cpuset);
+    return rc;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
+
 #if PMIX_HAVE_HWLOC
 #if HWLOC_API_VERSION >= 0x20000
 
@@ -819,6 +819,9 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_value_unload(pmix_value_t *kv,
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_value_xfer(pmix_value_t *p,
                                                       const pmix_value_t *src);
 
+PMIX_EXPORT void pmix_bfrops_base_value_move(pmix_value_t *p,
+                                             pmix_value_t *src);
+
 PMIX_EXPORT pmix_value_cmp_t pmix_bfrops_base_value_cmp(pmix_value_t *p,
                                                         pmix_value_t *p1);
 
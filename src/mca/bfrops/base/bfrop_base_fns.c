@@ -719,6 +719,15 @@ pmix_status_t pmix_bfrops_base_value_xfer(pmix_value_t *p,
     return PMIX_SUCCESS;
 }
 
+/* hand the payload of a value the caller owns over to another
+ * value without copying it - the source is left empty */
+void pmix_bfrops_base_value_move(pmix_value_t *p, pmix_value_t *src)
+{
+    memcpy(p, src, sizeof(pmix_value_t));
+    src->type = PMIX_UNDEF;
+    memset(&src->data, 0, sizeof(src->data));
+}
+
 
 /**
  * Internal function that resizes (expands) an inuse buffer if
@@ -42,15 +42,19 @@
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/util/argv.h"
+#include "src/atomics/sys/atomic.h"
 #include "src/mca/pcompress/pcompress.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/hash.h"
 #include "src/mca/preg/preg.h"
+#include "src/mca/psquash/psquash.h"
+#include "src/mca/bfrops/base/base.h"
 
 #include "src/mca/gds/base/base.h"
 #include "src/mca/pshmem/base/base.h"
+#include "src/hwloc/hwloc-internal.h"
 #include "dstore_common.h"
 #include "dstore_base.h"
 #include "dstore_segment.h"
@@ -65,6 +69,16 @@
 #define ESH_INIT_SESSION_TBL_SIZE 2
 #define ESH_INIT_NS_MAP_TBL_SIZE  2
 
+#define ESH_KEY_INDEX_VERSION     1
+#define ESH_KEY_INDEX_INIT_SIZE   16
+
+/* namespace segments may be sized for the job by the server,
+ * so the layout is derived from the size of the segment itself */
+#define _ESH_MAX_META_ELEMS(segdesc) \
+    (((segdesc)->seg_info.seg_size - sizeof(size_t)) / sizeof(rank_meta_info))
+
+#define _ESH_DATA_SEG_SIZE(segdesc) ((segdesc)->seg_info.seg_size)
+
 static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
                                 pmix_rank_t rank, pmix_buffer_t *buf);
 static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_elem, ns_seg_info_t *info);
@@ -81,6 +95,13 @@ static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx,
                                            pmix_dstore_seg_desc_t *segdesc, size_t offset);
 static void _update_initial_segment_info(pmix_common_dstore_ctx_t *ds_ctx,
                                          const ns_map_data_t *ns_map);
+static int _index_init(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info);
+static void _update_ns_index(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info);
+static void _index_put(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                       pmix_rank_t rank, const char *key, size_t offset, bool create);
+static pmix_status_t _index_get(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                pmix_rank_t rank, const char *key, size_t keyhash,
+                                uint8_t **kval_addr);
 static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx);
 static inline ssize_t _get_univ_size(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace);
 
@@ -147,6 +168,15 @@ ns_map_data_t * (*_esh_session_map_search)(const char *nspace) = NULL;
 #define _ESH_SESSION_ns_info(session_array, tbl_idx) \
     (PMIX_VALUE_ARRAY_GET_BASE(session_array, session_t)[tbl_idx].ns_info)
 
+/* The generation of the session is kept in the last word of its
+ * first initial segment. The server increments it whenever segments
+ * are added for any namespace of the session, so the clients may
+ * skip the synchronization while it stays the same. 0 means that
+ * the server doesn't maintain the generation. */
+#define _ESH_SESSION_gen(ds_ctx, tbl_idx) \
+    ((volatile size_t*)(_ESH_SESSION_sm_seg_first((ds_ctx)->session_array, tbl_idx)->seg_info.seg_base_addr + \
+                        (ds_ctx)->initial_segment_size - sizeof(size_t)))
+
 #ifdef ESH_PTHREAD_LOCK
 #define _ESH_SESSION_pthread_rwlock(tbl_idx) (PMIX_VALUE_ARRAY_GET_BASE(_session_array, session_t)[tbl_idx].rwlock)
 #define _ESH_SESSION_pthread_seg(tbl_idx)   (PMIX_VALUE_ARRAY_GET_BASE(_session_array, session_t)[tbl_idx].rwlock_seg)
@@ -166,18 +196,58 @@ __pmix_attribute_extension__ ({                                                \
     rc;                                                                        \
 })
 
+/* readers go through the optimistic read side of the lock if it has
+ * one, the state is kept by the caller for the duration of the read */
+#define _ESH_RD_BEGIN(ds_ctx, session_id, state)                               \
+__pmix_attribute_extension__ ({                                                \
+    pmix_status_t rc;                                                          \
+    if (NULL != ds_ctx->lock_cbs->rd_begin) {                                  \
+        rc = ds_ctx->lock_cbs->rd_begin(_ESH_SESSION_lock(ds_ctx->session_array, \
+                                                    session_id), state);       \
+    } else {                                                                   \
+        rc = _ESH_LOCK(ds_ctx, session_id, rd_lock);                           \
+    }                                                                          \
+    rc;                                                                        \
+})
+
+#define _ESH_RD_END(ds_ctx, session_id, state)                                 \
+__pmix_attribute_extension__ ({                                                \
+    pmix_status_t rc;                                                          \
+    if (NULL != ds_ctx->lock_cbs->rd_end) {                                    \
+        rc = ds_ctx->lock_cbs->rd_end(_ESH_SESSION_lock(ds_ctx->session_array,   \
+                                                    session_id), state);       \
+    } else {                                                                   \
+        rc = _ESH_LOCK(ds_ctx, session_id, rd_unlock);                         \
+    }                                                                          \
+    rc;                                                                        \
+})
+
 static void ncon(ns_track_elem_t *p) {
     memset(&p->ns_map, 0, sizeof(p->ns_map));
     p->meta_seg = NULL;
     p->data_seg = NULL;
     p->num_meta_seg = 0;
     p->num_data_seg = 0;
+    p->idx_meta_seg = NULL;
+    p->idx_data_seg = NULL;
+    p->num_idx_meta_seg = 0;
+    p->num_idx_data_seg = 0;
+    p->idx_checked = false;
+    p->meta_seg_size = 0;
+    p->data_seg_size = 0;
+    p->gen = 0;
+    p->rep_seg = NULL;
+    p->rep_checked = false;
     p->in_use = true;
+    p->dead_bytes = 0;
 }
 
 static void ndes(ns_track_elem_t *p) {
     pmix_common_dstor_delete_sm_desc(p->meta_seg);
     pmix_common_dstor_delete_sm_desc(p->data_seg);
+    pmix_common_dstor_delete_sm_desc(p->idx_meta_seg);
+    pmix_common_dstor_delete_sm_desc(p->idx_data_seg);
+    pmix_common_dstor_delete_sm_desc(p->rep_seg);
     memset(&p->ns_map, 0, sizeof(p->ns_map));
     p->in_use = false;
 }
@@ -510,6 +580,7 @@ static int _esh_session_init(pmix_common_dstore_ctx_t *ds_ctx, size_t idx, ns_ma
     pmix_dstore_seg_desc_t *seg = NULL;
     session_t *s = &(PMIX_VALUE_ARRAY_GET_ITEM(ds_ctx->session_array, session_t, idx));
     pmix_status_t rc = PMIX_SUCCESS;
+    size_t gen;
 
     s->setjobuid = setjobuid;
     s->jobuid = jobuid;
@@ -539,6 +610,10 @@ static int _esh_session_init(pmix_common_dstore_ctx_t *ds_ctx, size_t idx, ns_ma
             PMIX_ERROR_LOG(rc);
             return rc;
         }
+        /* start the session generation */
+        gen = 1;
+        memcpy(seg->seg_info.seg_base_addr + ds_ctx->initial_segment_size - sizeof(size_t),
+               &gen, sizeof(size_t));
     }
     else {
         seg = pmix_common_dstor_attach_new_segment(PMIX_DSTORE_INITIAL_SEGMENT, ds_ctx->base_path, m->name, 0);
@@ -554,6 +629,19 @@ static int _esh_session_init(pmix_common_dstore_ctx_t *ds_ctx, size_t idx, ns_ma
     return PMIX_SUCCESS;
 }
 
+/* must be called under the write lock */
+static inline void _esh_session_gen_bump(pmix_common_dstore_ctx_t *ds_ctx, size_t tbl_idx)
+{
+    volatile size_t *gen = _ESH_SESSION_gen(ds_ctx, tbl_idx);
+
+    /* the new segments must be visible before the generation */
+    pmix_atomic_wmb();
+    (*gen)++;
+    if (0 == *gen) {
+        *gen = 1;
+    }
+}
+
 static void _esh_session_release(pmix_common_dstore_ctx_t *ds_ctx, size_t idx)
 {
     session_t *s = &(PMIX_VALUE_ARRAY_GET_ITEM(ds_ctx->session_array, session_t, idx));
@@ -612,9 +700,30 @@ static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx)
             ds_ctx->direct_mode = 1;
         }
     }
+    if (NULL != (str = getenv(ESH_ENV_KEY_INDEX))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            ds_ctx->key_index = 1;
+        }
+    }
+    ds_ctx->compact_threshold = ESH_COMPACT_THRESHOLD;
+    if (NULL != (str = getenv(ESH_ENV_COMPACT_THRESHOLD))) {
+        ds_ctx->compact_threshold = strtoul(str, NULL, 10);
+    }
+    if (NULL != (str = getenv(ESH_ENV_NUMA_REPLICAS))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            ds_ctx->numa_replicas = 1;
+        }
+    }
+    ds_ctx->numa_idx = -1;
+    if (NULL != (str = getenv(ESH_ENV_PRESIZE))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            ds_ctx->presize = 1;
+        }
+    }
 
     ds_ctx->lock_segment_size = page_size;
-    ds_ctx->max_ns_num = (ds_ctx->initial_segment_size - sizeof(size_t) * 2) / sizeof(ns_seg_info_t);
+    /* leave the last word of the initial segment for the session generation */
+    ds_ctx->max_ns_num = (ds_ctx->initial_segment_size - sizeof(size_t) * 3) / sizeof(ns_seg_info_t);
     ds_ctx->max_meta_elems = (ds_ctx->meta_segment_size - sizeof(size_t)) / sizeof(rank_meta_info);
 
     pmix_common_dstor_init_segment_info(ds_ctx->initial_segment_size, ds_ctx->meta_segment_size,
@@ -651,9 +760,9 @@ static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns
     /* synchronize number of meta segments for the target namespace. */
     for (i = ns_elem->num_meta_seg; i < info->num_meta_seg; i++) {
         if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
-            seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_META_SEGMENT, ds_ctx->base_path,
-                                                       info->ns_map.name, i, ds_ctx->jobuid,
-                                                       ds_ctx->setjobuid);
+            seg = pmix_common_dstor_create_sized_segment(PMIX_DSTORE_NS_META_SEGMENT, ds_ctx->base_path,
+                                                         info->ns_map.name, i, ns_elem->meta_seg_size,
+                                                         ds_ctx->jobuid, ds_ctx->setjobuid);
             if (NULL == seg) {
                 rc = PMIX_ERR_OUT_OF_RESOURCE;
                 PMIX_ERROR_LOG(rc);
@@ -686,9 +795,9 @@ static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns
     /* synchronize number of data segments for the target namespace. */
     for (i = ns_elem->num_data_seg; i < info->num_data_seg; i++) {
         if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
-            seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_DATA_SEGMENT, ds_ctx->base_path,
-                                                       info->ns_map.name, i, ds_ctx->jobuid,
-                                                       ds_ctx->setjobuid);
+            seg = pmix_common_dstor_create_sized_segment(PMIX_DSTORE_NS_DATA_SEGMENT, ds_ctx->base_path,
+                                                         info->ns_map.name, i, ns_elem->data_seg_size,
+                                                         ds_ctx->jobuid, ds_ctx->setjobuid);
             if (NULL == seg) {
                 rc = PMIX_ERR_OUT_OF_RESOURCE;
                 PMIX_ERROR_LOG(rc);
@@ -871,6 +980,10 @@ static rank_meta_info *_get_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, pmi
         /* go through all existing meta segments for this namespace */
         do {
             num_elems = *((size_t*)(tmp->seg_info.seg_base_addr));
+            /* an optimistic reader may see a torn counter */
+            if (num_elems > _ESH_MAX_META_ELEMS(segdesc)) {
+                num_elems = _ESH_MAX_META_ELEMS(segdesc);
+            }
             for (i = 0; i < num_elems; i++) {
                 cur_elem = (rank_meta_info*)((uint8_t*)(tmp->seg_info.seg_base_addr) + sizeof(size_t) + i * sizeof(rank_meta_info));
                 if (rcount == cur_elem->rank) {
@@ -884,8 +997,8 @@ static rank_meta_info *_get_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, pmi
     } else {
         /* directly compute index of meta segment (id) and relative offset (rel_offset)
          * inside this segment for fast lookup a rank_meta_info object for the requested rank. */
-        id = rcount/ds_ctx->max_meta_elems;
-        rel_offset = (rcount % ds_ctx->max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
+        id = rcount/_ESH_MAX_META_ELEMS(segdesc);
+        rel_offset = (rcount % _ESH_MAX_META_ELEMS(segdesc)) * sizeof(rank_meta_info) + sizeof(size_t);
         /* go through all existing meta segments for this namespace.
          * Stop at id number if it exists. */
         while (NULL != tmp->next && 0 != id) {
@@ -930,7 +1043,7 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
             tmp = tmp->next;
         }
         num_elems = *((size_t*)(tmp->seg_info.seg_base_addr));
-        if (ds_ctx->max_meta_elems <= num_elems) {
+        if (_ESH_MAX_META_ELEMS(ns_info->meta_seg) <= num_elems) {
             PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
                         "%s:%d:%s: extend meta segment for nspace %s",
                         __FILE__, __LINE__, __func__, ns_info->ns_map.name));
@@ -962,8 +1075,8 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
         /* directly compute index of meta segment (id) and relative offset (rel_offset)
          * inside this segment for fast lookup a rank_meta_info object for the requested rank. */
         size_t rcount = rinfo->rank == PMIX_RANK_WILDCARD ? 0 : rinfo->rank + 1;
-        id = rcount/ds_ctx->max_meta_elems;
-        rel_offset = (rcount % ds_ctx->max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
+        id = rcount/_ESH_MAX_META_ELEMS(ns_info->meta_seg);
+        rel_offset = (rcount % _ESH_MAX_META_ELEMS(ns_info->meta_seg)) * sizeof(rank_meta_info) + sizeof(size_t);
         count = id;
         /* go through all existing meta segments for this namespace.
          * Stop at id number if it exists. */
@@ -1001,7 +1114,11 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
     return PMIX_SUCCESS;
 }
 
-static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *segdesc, size_t offset)
+/* translate the global offset into the address inside the data segments,
+ * the end of the segment holding it is returned in end if requested
+ * (NULL if the offset lies beyond the segments) */
+static uint8_t *_get_data_region(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *segdesc,
+                                 size_t offset, uint8_t **end)
 {
     pmix_dstore_seg_desc_t *tmp = segdesc;
     size_t rel_offset = offset;
@@ -1011,12 +1128,18 @@ static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx, pmi
                          "%s:%d:%s",
                          __FILE__, __LINE__, __func__));
 
+    if (NULL != end) {
+        *end = NULL;
+    }
     /* go through all existing data segments for this namespace */
     do {
-        if (rel_offset >= ds_ctx->data_segment_size) {
-            rel_offset -= ds_ctx->data_segment_size;
+        if (rel_offset >= _ESH_DATA_SEG_SIZE(segdesc)) {
+            rel_offset -= _ESH_DATA_SEG_SIZE(segdesc);
         } else {
             dataaddr = tmp->seg_info.seg_base_addr + rel_offset;
+            if (NULL != end) {
+                *end = tmp->seg_info.seg_base_addr + _ESH_DATA_SEG_SIZE(segdesc);
+            }
         }
         tmp = tmp->next;
     } while (NULL != tmp && NULL == dataaddr);
@@ -1024,6 +1147,455 @@ static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx, pmi
     return dataaddr;
 }
 
+static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *segdesc, size_t offset)
+{
+    return _get_data_region(ds_ctx, segdesc, offset, NULL);
+}
+
+/* check that the key-value pair at addr, its key name and its data
+ * lie inside [addr, end). A reader that doesn't hold the lock may see
+ * a torn pair, nothing but the checked fields may be used before. */
+static bool _kv_in_bounds(pmix_common_dstore_ctx_t *ds_ctx, uint8_t *addr, uint8_t *end)
+{
+    uint8_t *kname, *data_ptr;
+    size_t kv_size;
+
+    if (NULL == addr || addr >= end || (size_t)(end - addr) < sizeof(size_t)) {
+        return false;
+    }
+    kname = (uint8_t*)PMIX_DS_KNAME_PTR(ds_ctx, addr);
+    if (kname < addr || kname >= end || NULL == memchr(kname, '\0', end - kname)) {
+        return false;
+    }
+    kv_size = PMIX_DS_KV_SIZE(ds_ctx, addr);
+    if (kv_size > (size_t)(end - addr)) {
+        return false;
+    }
+    data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+    if (data_ptr <= addr || data_ptr > addr + kv_size) {
+        return false;
+    }
+    return PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr) <= (size_t)(addr + kv_size - data_ptr);
+}
+
+#define _ESH_IDX_HDR(ns_info) \
+    ((rank_index_hdr*)((ns_info)->idx_meta_seg->seg_info.seg_base_addr))
+
+/* FNV-1a hash of the key name, used to place keys into the key index */
+static inline uint64_t _esh_key_index_hash(const char *key)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    while ('\0' != *key) {
+        hash ^= (uint8_t)*key++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static inline size_t _esh_max_idx_elems(pmix_common_dstore_ctx_t *ds_ctx)
+{
+    return (ds_ctx->meta_segment_size - sizeof(rank_index_hdr)) / sizeof(rank_index_info);
+}
+
+/* this function is used by the server to create the key index
+ * segments at the same time with meta and data segments of the namespace */
+static int _index_init(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info)
+{
+    rank_index_hdr *hdr;
+    size_t offs;
+
+    ns_info->idx_checked = true;
+    if (!ds_ctx->key_index) {
+        return PMIX_SUCCESS;
+    }
+
+    ns_info->idx_meta_seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_IDX_META_SEGMENT,
+                                                                 ds_ctx->base_path, ns_info->ns_map.name, 0,
+                                                                 ds_ctx->jobuid, ds_ctx->setjobuid);
+    ns_info->idx_data_seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_IDX_DATA_SEGMENT,
+                                                                 ds_ctx->base_path, ns_info->ns_map.name, 0,
+                                                                 ds_ctx->jobuid, ds_ctx->setjobuid);
+    if (NULL == ns_info->idx_meta_seg || NULL == ns_info->idx_data_seg) {
+        /* the index is optional - keep going with the linear search */
+        PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+        pmix_common_dstor_delete_sm_desc(ns_info->idx_meta_seg);
+        pmix_common_dstor_delete_sm_desc(ns_info->idx_data_seg);
+        ns_info->idx_meta_seg = NULL;
+        ns_info->idx_data_seg = NULL;
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    offs = sizeof(size_t);//shift on offset field itself
+    memcpy(ns_info->idx_data_seg->seg_info.seg_base_addr, &offs, sizeof(size_t));
+    ns_info->num_idx_meta_seg = 1;
+    ns_info->num_idx_data_seg = 1;
+
+    hdr = _ESH_IDX_HDR(ns_info);
+    hdr->num_meta_seg = ns_info->num_idx_meta_seg;
+    hdr->num_data_seg = ns_info->num_idx_data_seg;
+    hdr->version = ESH_KEY_INDEX_VERSION;
+
+    return PMIX_SUCCESS;
+}
+
+static int _index_attach_segments(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                  pmix_dstore_segment_type type, pmix_dstore_seg_desc_t **segdesc,
+                                  size_t *num_seg, size_t target_num)
+{
+    pmix_dstore_seg_desc_t *seg, *tmp = *segdesc;
+    size_t i;
+
+    if (NULL != tmp) {
+        while (NULL != tmp->next) {
+            tmp = tmp->next;
+        }
+    }
+    for (i = *num_seg; i < target_num; i++) {
+        seg = pmix_common_dstor_attach_new_segment(type, ds_ctx->base_path, ns_info->ns_map.name, i);
+        if (NULL == seg) {
+            return PMIX_ERR_NOT_AVAILABLE;
+        }
+        if (NULL == tmp) {
+            *segdesc = seg;
+        } else {
+            tmp->next = seg;
+        }
+        tmp = seg;
+        (*num_seg)++;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* clients should sync local key index info with the one provided by the server.
+ * Failures are not fatal here, the lookup just falls back to the linear search */
+static void _update_ns_index(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info)
+{
+    pmix_dstore_seg_desc_t *seg;
+    rank_index_hdr *hdr;
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        return;
+    }
+
+    if (!ns_info->idx_checked) {
+        /* the server creates the index segments along with the first
+         * meta and data segments, so if they are missing now, then the
+         * server doesn't maintain the index for this namespace */
+        ns_info->idx_checked = true;
+        if (!pmix_common_dstor_segment_exists(PMIX_DSTORE_NS_IDX_META_SEGMENT, ds_ctx->base_path,
+                                              ns_info->ns_map.name, 0)) {
+            return;
+        }
+        seg = pmix_common_dstor_attach_new_segment(PMIX_DSTORE_NS_IDX_META_SEGMENT, ds_ctx->base_path,
+                                                   ns_info->ns_map.name, 0);
+        if (NULL == seg) {
+            return;
+        }
+        if (ESH_KEY_INDEX_VERSION != ((rank_index_hdr*)seg->seg_info.seg_base_addr)->version) {
+            PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                                 "%s:%d:%s: unsupported key index version for nspace %s",
+                                 __FILE__, __LINE__, __func__, ns_info->ns_map.name));
+            pmix_common_dstor_delete_sm_desc(seg);
+            return;
+        }
+        ns_info->idx_meta_seg = seg;
+        ns_info->num_idx_meta_seg = 1;
+    }
+    if (NULL == ns_info->idx_meta_seg) {
+        return;
+    }
+
+    hdr = _ESH_IDX_HDR(ns_info);
+    _index_attach_segments(ds_ctx, ns_info, PMIX_DSTORE_NS_IDX_META_SEGMENT, &ns_info->idx_meta_seg,
+                           &ns_info->num_idx_meta_seg, hdr->num_meta_seg);
+    _index_attach_segments(ds_ctx, ns_info, PMIX_DSTORE_NS_IDX_DATA_SEGMENT, &ns_info->idx_data_seg,
+                           &ns_info->num_idx_data_seg, hdr->num_data_seg);
+}
+
+static rank_index_info *_get_rank_index_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                             pmix_rank_t rank, bool create)
+{
+    pmix_dstore_seg_desc_t *tmp = ns_info->idx_meta_seg;
+    size_t rcount = rank == PMIX_RANK_WILDCARD ? 0 : rank + 1;
+    size_t max_elems = _esh_max_idx_elems(ds_ctx);
+    size_t id = rcount / max_elems;
+
+    if (NULL == tmp) {
+        return NULL;
+    }
+    if (id >= ns_info->num_idx_meta_seg) {
+        if (!create) {
+            return NULL;
+        }
+        /* create all missing segments till the id number */
+        while (ns_info->num_idx_meta_seg <= id) {
+            if (NULL == pmix_common_dstor_extend_segment(tmp, ds_ctx->base_path, ns_info->ns_map.name,
+                                                         ds_ctx->jobuid, ds_ctx->setjobuid)) {
+                PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+                return NULL;
+            }
+            ns_info->num_idx_meta_seg++;
+        }
+        _ESH_IDX_HDR(ns_info)->num_meta_seg = ns_info->num_idx_meta_seg;
+    }
+    while (NULL != tmp && 0 < id) {
+        tmp = tmp->next;
+        id--;
+    }
+    if (NULL == tmp) {
+        return NULL;
+    }
+    return (rank_index_info*)(tmp->seg_info.seg_base_addr + sizeof(rank_index_hdr) +
+                              (rcount % max_elems) * sizeof(rank_index_info));
+}
+
+static rank_index_entry *_get_index_table(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                          size_t offset)
+{
+    pmix_dstore_seg_desc_t *tmp = ns_info->idx_data_seg;
+    size_t id = offset / ds_ctx->data_segment_size;
+
+    while (NULL != tmp && 0 < id) {
+        tmp = tmp->next;
+        id--;
+    }
+    if (NULL == tmp) {
+        return NULL;
+    }
+    return (rank_index_entry*)(tmp->seg_info.seg_base_addr + offset % ds_ctx->data_segment_size);
+}
+
+/* allocate space for a hash table at the end of the index data segments,
+ * returns global offset of the table or 0 in case of error */
+static size_t _index_alloc_table(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                 size_t size)
+{
+    pmix_dstore_seg_desc_t *tmp = ns_info->idx_data_seg;
+    size_t nbytes = size * sizeof(rank_index_entry);
+    size_t offset, data_ended, id = 0;
+
+    if (nbytes + sizeof(size_t) > ds_ctx->data_segment_size) {
+        /* the table doesn't fit into a single segment */
+        return 0;
+    }
+    while (NULL != tmp->next) {
+        tmp = tmp->next;
+        id++;
+    }
+    memcpy(&offset, tmp->seg_info.seg_base_addr, sizeof(size_t));
+    if (offset + nbytes > ds_ctx->data_segment_size) {
+        tmp = pmix_common_dstor_extend_segment(tmp, ds_ctx->base_path, ns_info->ns_map.name,
+                                               ds_ctx->jobuid, ds_ctx->setjobuid);
+        if (NULL == tmp) {
+            PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+            return 0;
+        }
+        ns_info->num_idx_data_seg++;
+        _ESH_IDX_HDR(ns_info)->num_data_seg = ns_info->num_idx_data_seg;
+        id++;
+        offset = sizeof(size_t);
+    }
+    memset(tmp->seg_info.seg_base_addr + offset, 0, nbytes);
+    data_ended = offset + nbytes;
+    memcpy(tmp->seg_info.seg_base_addr, &data_ended, sizeof(size_t));
+
+    return id * ds_ctx->data_segment_size + offset;
+}
+
+/* check if the index entry may be reused for the key: either it
+ * refers to the same key or to an invalidated key-value pair */
+static bool _index_entry_match(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                               rank_index_entry *entry, const char *key)
+{
+    uint8_t *addr = _get_data_region_by_offset(ds_ctx, ns_info->data_seg, entry->offset);
+
+    if (NULL == addr) {
+        return false;
+    }
+    if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+        return true;
+    }
+    return (0 == strcmp(PMIX_DS_KNAME_PTR(ds_ctx, addr), key));
+}
+
+static int _index_grow(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                       rank_index_info *info)
+{
+    rank_index_entry *old_table, *table;
+    size_t size = info->size * 2;
+    size_t mask = size - 1;
+    size_t offset, count = 0, i, j;
+    uint8_t *addr;
+
+    if (0 == (offset = _index_alloc_table(ds_ctx, ns_info, size))) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    old_table = _get_index_table(ds_ctx, ns_info, info->offset);
+    table = _get_index_table(ds_ctx, ns_info, offset);
+    if (NULL == old_table || NULL == table) {
+        return PMIX_ERROR;
+    }
+    for (i = 0; i < info->size; i++) {
+        if (0 == old_table[i].offset) {
+            continue;
+        }
+        /* drop entries that refer to the invalidated key-value pairs */
+        addr = _get_data_region_by_offset(ds_ctx, ns_info->data_seg, old_table[i].offset);
+        if (NULL == addr || PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+            continue;
+        }
+        for (j = old_table[i].hash & mask; 0 != table[j].offset; j = (j + 1) & mask);
+        table[j] = old_table[i];
+        count++;
+    }
+    /* the old table space is not reused */
+    info->offset = offset;
+    info->size = size;
+    info->count = count;
+
+    return PMIX_SUCCESS;
+}
+
+/* put the offset of the key-value pair to the key index of the rank.
+ * The table for the rank is created only when the first key-value
+ * pair for this rank is stored (create == true), so the index
+ * always refers to all keys of the rank. */
+static void _index_put(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                       pmix_rank_t rank, const char *key, size_t offset, bool create)
+{
+    rank_index_info *info;
+    rank_index_entry *table;
+    uint64_t hash;
+    size_t i, mask;
+
+    if (NULL == ns_info->idx_meta_seg) {
+        return;
+    }
+    if (NULL == (info = _get_rank_index_info(ds_ctx, ns_info, rank, create))) {
+        return;
+    }
+    if (0 == info->offset) {
+        if (!create) {
+            /* the rank has no index, clients use the linear search */
+            return;
+        }
+        if (0 == (info->offset = _index_alloc_table(ds_ctx, ns_info, ESH_KEY_INDEX_INIT_SIZE))) {
+            return;
+        }
+        info->size = ESH_KEY_INDEX_INIT_SIZE;
+        info->count = 0;
+    } else if (2 * (info->count + 1) > info->size) {
+        /* keep the load factor under 1/2 */
+        if (PMIX_SUCCESS != _index_grow(ds_ctx, ns_info, info)) {
+            /* drop the index for this rank so that clients fall back
+             * to the linear search */
+            PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                                 "%s:%d:%s: drop key index for rank %u",
+                                 __FILE__, __LINE__, __func__, rank));
+            info->offset = 0;
+            info->size = 0;
+            info->count = 0;
+            return;
+        }
+    }
+    if (NULL == (table = _get_index_table(ds_ctx, ns_info, info->offset))) {
+        info->offset = 0;
+        return;
+    }
+
+    hash = _esh_key_index_hash(key);
+    mask = info->size - 1;
+    for (i = hash & mask; ; i = (i + 1) & mask) {
+        if (0 == table[i].offset) {
+            table[i].hash = hash;
+            table[i].offset = offset;
+            info->count++;
+            return;
+        }
+        if (table[i].hash == hash && _index_entry_match(ds_ctx, ns_info, &table[i], key)) {
+            table[i].offset = offset;
+            return;
+        }
+    }
+}
+
+/* drop all entries of the rank key index, the table itself is kept */
+static void _index_reset(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                         pmix_rank_t rank)
+{
+    rank_index_info *info;
+    rank_index_entry *table;
+
+    if (NULL == ns_info->idx_meta_seg) {
+        return;
+    }
+    info = _get_rank_index_info(ds_ctx, ns_info, rank, false);
+    if (NULL == info || 0 == info->offset) {
+        return;
+    }
+    if (NULL == (table = _get_index_table(ds_ctx, ns_info, info->offset))) {
+        return;
+    }
+    memset(table, 0, info->size * sizeof(rank_index_entry));
+    info->count = 0;
+}
+
+/* look for the key-value pair of the rank in the key index. Returns:
+ * PMIX_SUCCESS - the pair is found, kval_addr points to it
+ * PMIX_ERR_NOT_FOUND - the rank has no such key
+ * PMIX_ERR_NOT_AVAILABLE - there is no index for the rank */
+static pmix_status_t _index_get(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                pmix_rank_t rank, const char *key, size_t keyhash,
+                                uint8_t **kval_addr)
+{
+    rank_index_info *info;
+    rank_index_entry *table;
+    uint64_t hash;
+    size_t i, n, mask, offset, size;
+    uint8_t *addr, *end;
+
+    if (NULL == ns_info->idx_meta_seg) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    info = _get_rank_index_info(ds_ctx, ns_info, rank, false);
+    if (NULL == info) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    /* take a copy - an optimistic reader may see them change */
+    offset = info->offset;
+    size = info->size;
+    if (0 == offset || 0 == size || 0 != (size & (size - 1)) ||
+        size > ds_ctx->data_segment_size / sizeof(rank_index_entry) ||
+        offset % ds_ctx->data_segment_size + size * sizeof(rank_index_entry) >
+        ds_ctx->data_segment_size) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    if (NULL == (table = _get_index_table(ds_ctx, ns_info, offset))) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+
+    hash = _esh_key_index_hash(key);
+    mask = size - 1;
+    for (n = 0, i = hash & mask; n < size; n++, i = (i + 1) & mask) {
+        if (0 == table[i].offset) {
+            break;
+        }
+        if (table[i].hash != hash) {
+            continue;
+        }
+        addr = _get_data_region(ds_ctx, ns_info->data_seg, table[i].offset, &end);
+        if (!_kv_in_bounds(ds_ctx, addr, end)) {
+            return PMIX_ERR_NOT_AVAILABLE;
+        }
+        if (!PMIX_DS_KEY_IS_INVALID(ds_ctx, addr) &&
+            PMIX_DS_KEY_MATCH(ds_ctx, addr, key, keyhash)) {
+            *kval_addr = addr;
+            return PMIX_SUCCESS;
+        }
+    }
+    return PMIX_ERR_NOT_FOUND;
+}
+
 static size_t get_free_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *data_seg)
 {
     size_t offset;
@@ -1040,7 +1612,7 @@ static size_t get_free_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_
         /* this is the first created data segment, the first 8 bytes are used to place the free offset value itself */
         offset = sizeof(size_t);
     }
-    return (id * ds_ctx->data_segment_size + offset);
+    return (id * _ESH_DATA_SEG_SIZE(data_seg) + offset);
 }
 
 static int put_empty_ext_slot(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *dataseg)
@@ -1050,8 +1622,8 @@ static int put_empty_ext_slot(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_
     pmix_status_t rc;
 
     global_offset = get_free_offset(ds_ctx, dataseg);
-    rel_offset = global_offset % ds_ctx->data_segment_size;
-    if (rel_offset + PMIX_DS_SLOT_SIZE(ds_ctx) > ds_ctx->data_segment_size) {
+    rel_offset = global_offset % _ESH_DATA_SEG_SIZE(dataseg);
+    if (rel_offset + PMIX_DS_SLOT_SIZE(ds_ctx) > _ESH_DATA_SEG_SIZE(dataseg)) {
         PMIX_ERROR_LOG(PMIX_ERROR);
         return PMIX_ERROR;
     }
@@ -1087,12 +1659,12 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
         id++;
     }
     global_offset = get_free_offset(ds_ctx, dataseg);
-    offset = global_offset % ds_ctx->data_segment_size;
+    offset = global_offset % _ESH_DATA_SEG_SIZE(dataseg);
 
     /* We should provide additional space at the end of segment to
      * place EXTENSION_SLOT to have an ability to enlarge data for this rank.*/
     if ((sizeof(size_t) + PMIX_DS_KEY_SIZE(ds_ctx, key, size) + PMIX_DS_SLOT_SIZE(ds_ctx)) >
-            ds_ctx->data_segment_size) {
+            _ESH_DATA_SEG_SIZE(dataseg)) {
         /* this is an error case: segment is so small that cannot place evem a single key-value pair.
          * warn a user about it and fail. */
         offset = 0; /* offset cannot be 0 in normal case, so we use this value to indicate a problem. */
@@ -1110,7 +1682,7 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
      * so if offset is 0 here - we need to allocate the segment as well
      */
     if ( (0 == offset) || ( (offset + PMIX_DS_KEY_SIZE(ds_ctx, key, size) +
-                             PMIX_DS_SLOT_SIZE(ds_ctx)) > ds_ctx->data_segment_size) ) {
+                             PMIX_DS_SLOT_SIZE(ds_ctx)) > _ESH_DATA_SEG_SIZE(dataseg)) ) {
         id++;
         /* create a new data segment. */
         tmp = pmix_common_dstor_extend_segment(tmp, ds_ctx->base_path, ns_info->ns_map.name,
@@ -1131,7 +1703,7 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
         elem->num_data_seg++;
         offset = sizeof(size_t);
     }
-    global_offset = offset + id * ds_ctx->data_segment_size;
+    global_offset = offset + id * _ESH_DATA_SEG_SIZE(dataseg);
     addr = (uint8_t*)(tmp->seg_info.seg_base_addr)+offset;
     PMIX_DS_PUT_KEY(rc, ds_ctx, addr, key, buffer, size);
     if (rc != PMIX_SUCCESS) {
@@ -1148,7 +1720,7 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
                          __FILE__, __LINE__, __func__,
                          key, (unsigned long)offset,
                          (unsigned long)data_ended,
-                         (unsigned long)(id * ds_ctx->data_segment_size),
+                         (unsigned long)(id * _ESH_DATA_SEG_SIZE(dataseg)),
                          (unsigned long)size));
     return global_offset;
 }
@@ -1169,7 +1741,11 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
     datadesc = ns_info->data_seg;
     /* pack value to the buffer */
     PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
-    PMIX_BFROPS_PACK(rc, _client_peer(ds_ctx), &buffer, kval->value, 1, PMIX_VALUE);
+    if (PMIX_DS_HAS_VALUE_FMT(ds_ctx)) {
+        rc = ds_ctx->file_cbs->value_pack(_client_peer(ds_ctx), &buffer, kval->value);
+    } else {
+        PMIX_BFROPS_PACK(rc, _client_peer(ds_ctx), &buffer, kval->value, 1, PMIX_VALUE);
+    }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto exit;
@@ -1187,6 +1763,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
             PMIX_ERROR_LOG(rc);
             goto exit;
         }
+        _index_put(ds_ctx, ns_info, rank, kval->key, offset, (NULL == *rinfo));
         /* if it's the first time when we put data for this rank, then *rinfo == NULL,
          * and even if segment was extended, and data was put into the next segment,
          * we don't need to extension slot at the end of previous segment.
@@ -1263,6 +1840,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                 //if (1) { /* if we want to test replacing values for existing keys. */
                     /* invalidate current value and store another one at the end of data region. */
                     PMIX_DS_KEY_SET_INVALID(ds_ctx, addr);
+                    ns_info->dead_bytes += PMIX_DS_KV_SIZE(ds_ctx, addr);
                     /* decrementing count, it will be incremented back when we add a new value for this key at the end of region. */
                     (*rinfo)->count--;
                     kval_cnt--;
@@ -1340,7 +1918,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                 }
 
                 /* Calculate the offset of the end of the extension slot */
-                offs_cur_segment = free_offset % ds_ctx->data_segment_size;
+                offs_cur_segment = free_offset % _ESH_DATA_SEG_SIZE(datadesc);
                 segstart = ldesc->seg_info.seg_base_addr;
                 offs_past_extslot = (addr + PMIX_DS_KV_SIZE(ds_ctx, addr)) - segstart;
 
@@ -1370,6 +1948,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                 PMIX_ERROR_LOG(rc);
                 goto exit;
             }
+            _index_put(ds_ctx, ns_info, rank, kval->key, offset, false);
             /* we just reached the end of data for the target rank, and there can be two cases:
              * (1) - we are in the middle of data segment; data for this rank is separated from
              * data for different ranks, and that's why next element is EXTENSION_SLOT.
@@ -1510,57 +2089,482 @@ static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_
     return rc;
 }
 
-static inline ssize_t _get_univ_size(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace)
+/* number of bytes used in the data segments of the namespace */
+static size_t _data_used_bytes(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info)
 {
-    ssize_t nprocs = 0;
-    pmix_value_t *val;
-    int rc;
+    pmix_dstore_seg_desc_t *tmp;
+    size_t used = 0;
 
-    rc = _dstore_fetch(ds_ctx, nspace, PMIX_RANK_WILDCARD, PMIX_UNIV_SIZE, &val);
-    if( PMIX_SUCCESS != rc ) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    if( val->type != PMIX_UINT32 ){
-        rc = PMIX_ERR_BAD_PARAM;
-        PMIX_ERROR_LOG(rc);
-        return rc;
+    for (tmp = ns_info->data_seg; NULL != tmp; tmp = tmp->next) {
+        used += *((size_t*)(tmp->seg_info.seg_base_addr));
     }
-    nprocs = (ssize_t)val->data.uint32;
-    PMIX_VALUE_RELEASE(val);
-    return nprocs;
+    return used;
 }
 
-PMIX_EXPORT pmix_status_t pmix_common_dstor_cache_job_info(pmix_common_dstore_ctx_t *ds_ctx,
-                                struct pmix_namespace_t *ns,
-                                pmix_info_t info[], size_t ninfo)
+/* live key-value pairs of a rank, collected for the compaction */
+typedef struct {
+    rank_meta_info *rinfo;
+    size_t count;
+    size_t size;
+} compact_rank_t;
+
+/* iterate through all rank_meta_info objects of the namespace */
+static rank_meta_info *_next_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx,
+                                            pmix_dstore_seg_desc_t **seg, size_t *idx)
 {
-    return PMIX_SUCCESS;
-}
+    rank_meta_info *rinfo;
+    size_t num_elems;
 
+    while (NULL != *seg) {
+        if (1 == ds_ctx->direct_mode) {
+            num_elems = *((size_t*)((*seg)->seg_info.seg_base_addr));
+        } else {
+            num_elems = _ESH_MAX_META_ELEMS(*seg);
+        }
+        while (*idx < num_elems) {
+            rinfo = (rank_meta_info*)((uint8_t*)((*seg)->seg_info.seg_base_addr) +
+                                      sizeof(size_t) + (*idx)++ * sizeof(rank_meta_info));
+            if (0 != rinfo->offset) {
+                return rinfo;
+            }
+        }
+        *seg = (*seg)->next;
+        *idx = 0;
+    }
+    return NULL;
+}
 
-pmix_common_dstore_ctx_t *pmix_common_dstor_init(const char *ds_name, pmix_info_t info[], size_t ninfo,
-                                                 pmix_common_lock_callbacks_t *lock_cb,
-                                                 pmix_common_dstore_file_cbs_t *file_cb)
+/* Rewrite the live key-value pairs of the namespace contiguously from the
+ * beginning of the data segments, dropping the invalidated ones. Every
+ * rank gets a single data blob followed by an empty extension slot, as
+ * if its data was stored at once. Must be called under the write lock. */
+static int _compact_data_segments(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info)
 {
-    pmix_status_t rc;
-    size_t n;
-    char *dstor_tmpdir = NULL;
-    size_t tbl_idx = 0;
-    ns_map_data_t *ns_map = NULL;
-    pmix_common_dstore_ctx_t *ds_ctx = NULL;
-
-    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                        "pmix:gds:dstore init");
+    pmix_dstore_seg_desc_t *seg, *tmp;
+    compact_rank_t *ranks = NULL, *r;
+    rank_meta_info *rinfo;
+    uint8_t *data = NULL, *ptr, *addr;
+    size_t nranks = 0, data_size = 0, data_used = 0;
+    size_t i, n, idx, kv_size, offset, id, slot_size;
+    size_t zero = 0, released = 0, *old_ends = NULL;
+    ns_seg_info_t *elem;
+    pmix_status_t rc = PMIX_SUCCESS;
 
-    ds_ctx = (pmix_common_dstore_ctx_t*) malloc(sizeof(*ds_ctx));
-    if (NULL == ds_ctx) {
-        PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
-        return NULL;
-    }
-    memset(ds_ctx, 0, sizeof(*ds_ctx));
+    slot_size = PMIX_DS_SLOT_SIZE(ds_ctx);
 
-    /* assign lock callbacks */
+    /* copy the live data out of the segments */
+    seg = ns_info->meta_seg;
+    idx = 0;
+    while (NULL != (rinfo = _next_rank_meta_info(ds_ctx, &seg, &idx))) {
+        if (0 == (nranks % 64)) {
+            r = (compact_rank_t*)realloc(ranks, (nranks + 64) * sizeof(compact_rank_t));
+            if (NULL == r) {
+                rc = PMIX_ERR_NOMEM;
+                goto exit;
+            }
+            ranks = r;
+        }
+        r = &ranks[nranks++];
+        r->rinfo = rinfo;
+        r->count = 0;
+        r->size = 0;
+
+        addr = _get_data_region_by_offset(ds_ctx, ns_info->data_seg, rinfo->offset);
+        n = rinfo->count;
+        while (NULL != addr && 0 < n) {
+            if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+                addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+                continue;
+            }
+            if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
+                memcpy(&offset, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
+                addr = (0 < offset) ?
+                    _get_data_region_by_offset(ds_ctx, ns_info->data_seg, offset) : NULL;
+                continue;
+            }
+            kv_size = PMIX_DS_KV_SIZE(ds_ctx, addr);
+            if (data_used + kv_size > data_size) {
+                data_size = 2 * (data_used + kv_size);
+                ptr = (uint8_t*)realloc(data, data_size);
+                if (NULL == ptr) {
+                    rc = PMIX_ERR_NOMEM;
+                    goto exit;
+                }
+                data = ptr;
+            }
+            memcpy(data + data_used, addr, kv_size);
+            data_used += kv_size;
+            r->count++;
+            r->size += kv_size;
+            addr += kv_size;
+            n--;
+        }
+        if (0 < n) {
+            /* the data of the rank is broken, leave everything as is */
+            rc = PMIX_ERROR;
+            PMIX_ERROR_LOG(rc);
+            goto exit;
+        }
+    }
+
+    /* make sure the new layout fits into the existing segments before
+     * anything is overwritten, the segments can't be extended halfway */
+    id = 0;
+    offset = sizeof(size_t);
+    ptr = data;
+    for (i = 0; i < nranks; i++) {
+        for (n = 0; n < ranks[i].count; n++) {
+            kv_size = PMIX_DS_KV_SIZE(ds_ctx, ptr);
+            if (offset + kv_size + slot_size > _ESH_DATA_SEG_SIZE(ns_info->data_seg)) {
+                id++;
+                offset = sizeof(size_t);
+            }
+            offset += kv_size;
+            ptr += kv_size;
+        }
+        if (offset + slot_size > _ESH_DATA_SEG_SIZE(ns_info->data_seg)) {
+            /* a rank without live pairs may not fit after the previous one */
+            id++;
+            offset = sizeof(size_t);
+        }
+        offset += slot_size;
+    }
+    seg = ns_info->data_seg;
+    for (n = 0; n < id; n++) {
+        if (NULL == seg->next) {
+            tmp = pmix_common_dstor_extend_segment(seg, ds_ctx->base_path, ns_info->ns_map.name,
+                                                   ds_ctx->jobuid, ds_ctx->setjobuid);
+            if (NULL == tmp) {
+                rc = PMIX_ERR_OUT_OF_RESOURCE;
+                PMIX_ERROR_LOG(rc);
+                goto exit;
+            }
+            ns_info->num_data_seg++;
+            elem = _get_ns_info_from_initial_segment(ds_ctx, &ns_info->ns_map);
+            if (NULL == elem) {
+                rc = PMIX_ERROR;
+                PMIX_ERROR_LOG(rc);
+                goto exit;
+            }
+            elem->num_data_seg = ns_info->num_data_seg;
+        }
+        seg = seg->next;
+    }
+
+    /* remember the used space of every segment, the pages which
+     * are not used after the compaction are given back */
+    old_ends = (size_t*)calloc(ns_info->num_data_seg, sizeof(size_t));
+    if (NULL == old_ends) {
+        rc = PMIX_ERR_NOMEM;
+        goto exit;
+    }
+    for (n = 0, seg = ns_info->data_seg; NULL != seg && n < ns_info->num_data_seg;
+         n++, seg = seg->next) {
+        memcpy(&old_ends[n], seg->seg_info.seg_base_addr, sizeof(size_t));
+    }
+
+    /* write the data back */
+    seg = ns_info->data_seg;
+    id = 0;
+    offset = sizeof(size_t);
+    ptr = data;
+    for (i = 0; i < nranks; i++) {
+        rinfo = ranks[i].rinfo;
+        rinfo->offset = 0;
+        /* the pairs are going to move, rebuild the key index of the rank */
+        _index_reset(ds_ctx, ns_info, rinfo->rank);
+        for (n = 0; n < ranks[i].count; n++) {
+            kv_size = PMIX_DS_KV_SIZE(ds_ctx, ptr);
+            if (offset + kv_size + slot_size > _ESH_DATA_SEG_SIZE(ns_info->data_seg)) {
+                if (0 < rinfo->offset) {
+                    /* continue the blob of the rank in the next segment */
+                    size_t next = (id + 1) * _ESH_DATA_SEG_SIZE(ns_info->data_seg) + sizeof(size_t);
+                    addr = (uint8_t*)(seg->seg_info.seg_base_addr) + offset;
+                    PMIX_DS_PUT_KEY(rc, ds_ctx, addr, ESH_REGION_EXTENSION, &next, sizeof(size_t));
+                    offset += slot_size;
+                }
+                memcpy(seg->seg_info.seg_base_addr, &offset, sizeof(size_t));
+                seg = seg->next;
+                id++;
+                offset = sizeof(size_t);
+            }
+            addr = (uint8_t*)(seg->seg_info.seg_base_addr) + offset;
+            memcpy(addr, ptr, kv_size);
+            if (0 == rinfo->offset) {
+                rinfo->offset = id * _ESH_DATA_SEG_SIZE(ns_info->data_seg) + offset;
+            }
+            _index_put(ds_ctx, ns_info, rinfo->rank, PMIX_DS_KNAME_PTR(ds_ctx, addr),
+                       id * _ESH_DATA_SEG_SIZE(ns_info->data_seg) + offset, false);
+            offset += kv_size;
+            ptr += kv_size;
+        }
+        if (offset + slot_size > _ESH_DATA_SEG_SIZE(ns_info->data_seg)) {
+            /* only a rank without live pairs gets here, there is
+             * nothing to continue - start it in the next segment */
+            memcpy(seg->seg_info.seg_base_addr, &offset, sizeof(size_t));
+            seg = seg->next;
+            id++;
+            offset = sizeof(size_t);
+        }
+        addr = (uint8_t*)(seg->seg_info.seg_base_addr) + offset;
+        PMIX_DS_PUT_KEY(rc, ds_ctx, addr, ESH_REGION_EXTENSION, &zero, sizeof(size_t));
+        if (0 == rinfo->offset) {
+            rinfo->offset = id * _ESH_DATA_SEG_SIZE(ns_info->data_seg) + offset;
+        }
+        rinfo->count = ranks[i].count;
+        offset += slot_size;
+    }
+    memcpy(seg->seg_info.seg_base_addr, &offset, sizeof(size_t));
+    /* the remaining segments are empty now, new data goes to the last one */
+    for (seg = seg->next; NULL != seg; seg = seg->next) {
+        memcpy(seg->seg_info.seg_base_addr, &zero, sizeof(size_t));
+    }
+
+    /* the segments stay mapped by the clients, but the pages
+     * no longer used can be given back to the system */
+    for (n = 0, seg = ns_info->data_seg; NULL != seg && n < ns_info->num_data_seg;
+         n++, seg = seg->next) {
+        memcpy(&offset, seg->seg_info.seg_base_addr, sizeof(size_t));
+        if (offset < sizeof(size_t)) {
+            offset = sizeof(size_t);
+        }
+        if (old_ends[n] > offset) {
+            released += pmix_common_dstor_release_segment_range(seg, offset, old_ends[n]);
+        }
+    }
+
+    ns_info->dead_bytes = 0;
+    ds_ctx->reclaimed_bytes += released;
+    PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: nspace %s, compacted to %lu live bytes, released %lu, reclaimed %lu bytes total",
+                         __FILE__, __LINE__, __func__, ns_info->ns_map.name,
+                         (unsigned long)data_used,
+                         (unsigned long)released, (unsigned long)ds_ctx->reclaimed_bytes));
+    rc = PMIX_SUCCESS;
+
+exit:
+    if (NULL != old_ends) {
+        free(old_ends);
+    }
+    if (NULL != ranks) {
+        free(ranks);
+    }
+    if (NULL != data) {
+        free(data);
+    }
+    return rc;
+}
+
+/* Copy the job-level data of the namespace into a replica bound to
+ * each NUMA node. The replicas are created along with the job-level
+ * data and rewritten whenever it changes, a replica which can't hold
+ * the data is marked stale and clients fall back to the data segments.
+ * Must be called under the write lock. */
+static int _update_numa_replicas(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info)
+{
+    pmix_dstore_seg_desc_t *seg, *tmp = NULL;
+    rank_meta_info *rinfo;
+    rank_replica_hdr *hdr;
+    uint8_t *addr, *base;
+    size_t n, kv_size, offset, offset_next, slot_size, count = 0;
+    size_t zero = 0;
+    int i, nnodes;
+    pmix_status_t rc;
+
+    rinfo = _get_rank_meta_info(ds_ctx, PMIX_RANK_WILDCARD, ns_info->meta_seg);
+    if (NULL == rinfo) {
+        return PMIX_SUCCESS;
+    }
+
+    if (NULL == ns_info->rep_seg) {
+        if (ns_info->rep_checked) {
+            /* replicas are not used for this namespace */
+            return PMIX_SUCCESS;
+        }
+        ns_info->rep_checked = true;
+        if (PMIX_SUCCESS != pmix_hwloc_get_numa_count(&nnodes) || 2 > nnodes) {
+            return PMIX_SUCCESS;
+        }
+        for (i = 0; i < nnodes; i++) {
+            seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_REP_SEGMENT, ds_ctx->base_path,
+                                                       ns_info->ns_map.name, i, ds_ctx->jobuid,
+                                                       ds_ctx->setjobuid);
+            if (NULL == seg) {
+                /* clients of the remaining nodes use the data segments */
+                PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+                break;
+            }
+            if (PMIX_SUCCESS != pmix_hwloc_bind_area_to_numa(seg->seg_info.seg_base_addr,
+                                                             seg->seg_info.seg_size, i)) {
+                PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                                     "%s:%d:%s: can't bind replica %d of nspace %s",
+                                     __FILE__, __LINE__, __func__, i, ns_info->ns_map.name));
+            }
+            if (NULL == tmp) {
+                ns_info->rep_seg = seg;
+            } else {
+                tmp->next = seg;
+            }
+            tmp = seg;
+        }
+        if (NULL == ns_info->rep_seg) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    /* fill the first replica and copy it to the others */
+    base = ns_info->rep_seg->seg_info.seg_base_addr;
+    hdr = (rank_replica_hdr*)base;
+    slot_size = PMIX_DS_SLOT_SIZE(ds_ctx);
+    offset = sizeof(rank_replica_hdr);
+    addr = _get_data_region_by_offset(ds_ctx, ns_info->data_seg, rinfo->offset);
+    n = rinfo->count;
+    while (NULL != addr && 0 < n) {
+        if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+            continue;
+        }
+        if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
+            memcpy(&offset_next, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
+            addr = (0 < offset_next) ?
+                _get_data_region_by_offset(ds_ctx, ns_info->data_seg, offset_next) : NULL;
+            continue;
+        }
+        kv_size = PMIX_DS_KV_SIZE(ds_ctx, addr);
+        if (offset + kv_size + slot_size > ns_info->rep_seg->seg_info.seg_size) {
+            break;
+        }
+        memcpy(base + offset, addr, kv_size);
+        offset += kv_size;
+        addr += kv_size;
+        count++;
+        n--;
+    }
+    if (0 < n) {
+        PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                             "%s:%d:%s: job data of nspace %s doesn't fit the replica",
+                             __FILE__, __LINE__, __func__, ns_info->ns_map.name));
+        offset = 0;
+    } else {
+        PMIX_DS_PUT_KEY(rc, ds_ctx, base + offset, ESH_REGION_EXTENSION, &zero, sizeof(size_t));
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            offset = 0;
+        } else {
+            offset += slot_size;
+        }
+    }
+    hdr->count = count;
+    hdr->size = offset;
+
+    for (tmp = ns_info->rep_seg->next; NULL != tmp; tmp = tmp->next) {
+        if (0 < offset) {
+            memcpy(tmp->seg_info.seg_base_addr, base, offset);
+        } else {
+            ((rank_replica_hdr*)tmp->seg_info.seg_base_addr)->size = 0;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* clients attach to the replica of the job-level data on their NUMA node.
+ * Failures are not fatal here, the data segments are used instead */
+static void _update_ns_replica(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info)
+{
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) || ns_info->rep_checked) {
+        return;
+    }
+    /* the server creates the replicas along with the job-level data,
+     * which is stored before the clients of the namespace start up */
+    ns_info->rep_checked = true;
+    if (!pmix_common_dstor_segment_exists(PMIX_DSTORE_NS_REP_SEGMENT, ds_ctx->base_path,
+                                          ns_info->ns_map.name, 0)) {
+        return;
+    }
+    if (-1 == ds_ctx->numa_idx &&
+        PMIX_SUCCESS != pmix_hwloc_get_local_numa(&ds_ctx->numa_idx)) {
+        ds_ctx->numa_idx = -2;
+    }
+    if (0 > ds_ctx->numa_idx ||
+        !pmix_common_dstor_segment_exists(PMIX_DSTORE_NS_REP_SEGMENT, ds_ctx->base_path,
+                                          ns_info->ns_map.name, ds_ctx->numa_idx)) {
+        return;
+    }
+    ns_info->rep_seg = pmix_common_dstor_attach_new_segment(PMIX_DSTORE_NS_REP_SEGMENT, ds_ctx->base_path,
+                                                            ns_info->ns_map.name, ds_ctx->numa_idx);
+}
+
+/* the job-level data is read from the NUMA local replica unless it is stale */
+static uint8_t *_get_replica_data(ns_track_elem_t *ns_info, pmix_rank_t rank, size_t *count,
+                                  uint8_t **end)
+{
+    rank_replica_hdr *hdr;
+
+    if (PMIX_RANK_WILDCARD != rank || NULL == ns_info->rep_seg ||
+        PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        return NULL;
+    }
+    hdr = (rank_replica_hdr*)ns_info->rep_seg->seg_info.seg_base_addr;
+    if (0 == hdr->size) {
+        return NULL;
+    }
+    *count = hdr->count;
+    *end = ns_info->rep_seg->seg_info.seg_base_addr + ns_info->rep_seg->seg_info.seg_size;
+    return (uint8_t*)hdr + sizeof(rank_replica_hdr);
+}
+
+static inline ssize_t _get_univ_size(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace)
+{
+    ssize_t nprocs = 0;
+    pmix_value_t *val;
+    int rc;
+
+    rc = _dstore_fetch(ds_ctx, nspace, PMIX_RANK_WILDCARD, PMIX_UNIV_SIZE, &val);
+    if( PMIX_SUCCESS != rc ) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if( val->type != PMIX_UINT32 ){
+        PMIX_VALUE_RELEASE(val);
+        rc = PMIX_ERR_BAD_PARAM;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    nprocs = (ssize_t)val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+    return nprocs;
+}
+
+PMIX_EXPORT pmix_status_t pmix_common_dstor_cache_job_info(pmix_common_dstore_ctx_t *ds_ctx,
+                                struct pmix_namespace_t *ns,
+                                pmix_info_t info[], size_t ninfo)
+{
+    return PMIX_SUCCESS;
+}
+
+
+pmix_common_dstore_ctx_t *pmix_common_dstor_init(const char *ds_name, pmix_info_t info[], size_t ninfo,
+                                                 pmix_common_lock_callbacks_t *lock_cb,
+                                                 pmix_common_dstore_file_cbs_t *file_cb)
+{
+    pmix_status_t rc;
+    size_t n;
+    char *dstor_tmpdir = NULL;
+    size_t tbl_idx = 0;
+    ns_map_data_t *ns_map = NULL;
+    pmix_common_dstore_ctx_t *ds_ctx = NULL;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "pmix:gds:dstore init");
+
+    ds_ctx = (pmix_common_dstore_ctx_t*) malloc(sizeof(*ds_ctx));
+    if (NULL == ds_ctx) {
+        PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+        return NULL;
+    }
+    memset(ds_ctx, 0, sizeof(*ds_ctx));
+
+    /* assign lock callbacks */
     ds_ctx->lock_cbs = lock_cb;
     ds_ctx->file_cbs = file_cb;
 
@@ -1786,6 +2790,66 @@ PMIX_EXPORT void pmix_common_dstor_finalize(pmix_common_dstore_ctx_t *ds_ctx)
     free(ds_ctx);
 }
 
+/* number of the shared segments of the namespace, only grows
+ * while the namespace exists */
+static inline size_t _ns_segments_count(ns_track_elem_t *ns_info)
+{
+    pmix_dstore_seg_desc_t *seg;
+    size_t count = ns_info->num_meta_seg + ns_info->num_data_seg +
+                   ns_info->num_idx_meta_seg + ns_info->num_idx_data_seg;
+
+    for (seg = ns_info->rep_seg; NULL != seg; seg = seg->next) {
+        count++;
+    }
+    return count;
+}
+
+/* Size the segments of a new namespace to hold the data of the whole
+ * job: a meta record for each rank and the job-level data along with
+ * the expected per-rank data. Segments are never made smaller than
+ * the defaults, and the chaining still handles a wrong estimate. */
+static void _presize_ns_segments(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                 size_t job_info_size)
+{
+    pmix_namespace_t *nptr;
+    size_t page_size = pmix_common_dstor_getpagesize();
+    size_t nprocs, size;
+
+    nptr = pmix_server_nspace_lookup(ns_info->ns_map.name);
+    if (NULL == nptr || 0 == nptr->nprocs) {
+        /* nothing is known about the job */
+        return;
+    }
+    /* the job may have more local procs than its size tells, if the
+     * nspace is spread over the servers in a non-uniform way */
+    nprocs = nptr->nprocs;
+    if (nprocs < nptr->nlocalprocs) {
+        nprocs = nptr->nlocalprocs;
+    }
+
+    size = sizeof(size_t) + (nprocs + 1) * sizeof(rank_meta_info);
+    size = ((size + page_size - 1) / page_size) * page_size;
+    if (size > ds_ctx->meta_segment_size) {
+        ns_info->meta_seg_size = (size < ESH_PRESIZE_MAX_SEG_SIZE) ?
+                                 size : ESH_PRESIZE_MAX_SEG_SIZE;
+    }
+
+    /* the per-rank job info is derived from the job-level data,
+     * account for it twice */
+    size = sizeof(size_t) + 2 * job_info_size + nprocs * ESH_PRESIZE_RANK_DATA;
+    size = ((size + page_size - 1) / page_size) * page_size;
+    if (size > ds_ctx->data_segment_size) {
+        ns_info->data_seg_size = (size < ESH_PRESIZE_MAX_SEG_SIZE) ?
+                                 size : ESH_PRESIZE_MAX_SEG_SIZE;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: nspace %s nprocs %lu meta %lu data %lu",
+                         __FILE__, __LINE__, __func__, ns_info->ns_map.name,
+                         (unsigned long)nprocs, (unsigned long)ns_info->meta_seg_size,
+                         (unsigned long)ns_info->data_seg_size));
+}
+
 static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
                                    ns_map_data_t *ns_map,
                                    pmix_rank_t rank,
@@ -1795,6 +2859,7 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
     ns_track_elem_t *elem;
     pmix_buffer_t xfer;
     ns_seg_info_t ns_info;
+    size_t nsegs = 0;
 
     if (NULL == kv) {
         return PMIX_ERROR;
@@ -1818,8 +2883,9 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
     if (NULL == elem) {
         rc = PMIX_ERR_OUT_OF_RESOURCE;
         PMIX_ERROR_LOG(rc);
-        goto exit;
+        return rc;
     }
+    nsegs = _ns_segments_count(elem);
 
     /* If a new element was just created, we need to create corresponding meta and
      * data segments and update corresponding element's fields. */
@@ -1829,15 +2895,18 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
         ns_info.ns_map.tbl_idx = ns_map->tbl_idx;
         ns_info.num_meta_seg = 1;
         ns_info.num_data_seg = 1;
+        if (ds_ctx->presize) {
+            _presize_ns_segments(ds_ctx, elem, kv->value->data.bo.size);
+        }
         rc = _update_ns_elem(ds_ctx, elem, &ns_info);
         if (PMIX_SUCCESS != rc || NULL == elem->meta_seg || NULL == elem->data_seg) {
             PMIX_ERROR_LOG(rc);
             goto exit;
         }
 
-        /* zero created shared memory segments for this namespace */
-        memset(elem->meta_seg->seg_info.seg_base_addr, 0, ds_ctx->meta_segment_size);
-        memset(elem->data_seg->seg_info.seg_base_addr, 0, ds_ctx->data_segment_size);
+        /* the segments are backed by freshly created files, so they
+         * come zero-filled and touching them here would only fault in
+         * every page of a presized segment up front */
 
         /* put ns's shared segments info to the global meta segment. */
         rc = _put_ns_info_to_initial_segment(ds_ctx, ns_map, &elem->meta_seg->seg_info, &elem->data_seg->seg_info);
@@ -1845,6 +2914,9 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
             PMIX_ERROR_LOG(rc);
             goto exit;
         }
+
+        /* the key index is optional, it's fine to go on without it */
+        (void)_index_init(ds_ctx, elem);
     }
 
     /* Now we know info about meta segment for this namespace. If meta segment
@@ -1861,7 +2933,27 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
         goto exit;
     }
 
+    /* reclaim the space of the replaced values, we are under the
+     * write lock and readers block on the read lock, so they will
+     * see the new layout at once. Optimistic readers don't wait for
+     * the writer and would have to chase the moving pairs */
+    if (0 < ds_ctx->compact_threshold && NULL == ds_ctx->lock_cbs->rd_begin &&
+        0 < elem->dead_bytes &&
+        elem->dead_bytes * 100 >= _data_used_bytes(ds_ctx, elem) * ds_ctx->compact_threshold) {
+        /* compaction is an optimization, the store stays valid anyway */
+        (void)_compact_data_segments(ds_ctx, elem);
+    }
+
+    /* keep the NUMA replicas in sync with the job-level data */
+    if (ds_ctx->numa_replicas && PMIX_RANK_WILDCARD == rank) {
+        (void)_update_numa_replicas(ds_ctx, elem);
+    }
+
 exit:
+    /* let the clients know they have segments to attach */
+    if (nsegs != _ns_segments_count(elem)) {
+        _esh_session_gen_bump(ds_ctx, ns_map->tbl_idx);
+    }
     return rc;
 }
 
@@ -1927,21 +3019,269 @@ exit:
     return rc;
 }
 
+/* unpack the key-value pair data into the value */
+static pmix_status_t _decode_value(pmix_common_dstore_ctx_t *ds_ctx,
+                                   uint8_t *data_ptr, size_t data_size,
+                                   pmix_value_t *val)
+{
+    pmix_buffer_t buffer;
+    pmix_status_t rc;
+    int cnt = 1;
+
+    if (PMIX_DS_HAS_VALUE_FMT(ds_ctx)) {
+        return ds_ctx->file_cbs->value_unpack(_client_peer(ds_ctx), data_ptr, data_size, val);
+    }
+
+    PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(_client_peer(ds_ctx), &buffer, data_ptr, data_size);
+    PMIX_BFROPS_UNPACK(rc, _client_peer(ds_ctx), &buffer, val, &cnt, PMIX_VALUE);
+    buffer.base_ptr = NULL;
+    buffer.bytes_used = 0;
+    PMIX_DESTRUCT(&buffer);
+    return rc;
+}
+
+/* synchronize the local tracker of the namespace with the shared memory,
+ * the reader lock must be held by the caller */
+static pmix_status_t _dstore_sync_ns(pmix_common_dstore_ctx_t *ds_ctx,
+                                     ns_map_data_t *ns_map,
+                                     ns_track_elem_t **elem)
+{
+    ns_seg_info_t *ns_info = NULL;
+    size_t gen;
+    pmix_status_t rc;
+
+    /* the segments of the session didn't change since the namespace
+     * was synchronized the last time, nothing to do */
+    gen = *_ESH_SESSION_gen(ds_ctx, ns_map->tbl_idx);
+    pmix_atomic_rmb();
+    if (0 < gen && 0 <= ns_map->track_idx) {
+        *elem = pmix_value_array_get_item(ds_ctx->ns_track_array, ns_map->track_idx);
+        if (NULL != *elem && NULL != (*elem)->meta_seg && gen == (*elem)->gen) {
+            return PMIX_SUCCESS;
+        }
+    }
+
+    /* First of all, we go through all initial segments and look at their field.
+     * If it's 1, then generate name of next initial segment incrementing id by one and attach to it.
+     * We need this step to synchronize initial shared segments with our local track list.
+     * Then we look for the target namespace in all initial segments.
+     * If it is found, we get numbers of meta & data segments and
+     * compare these numbers with the number of trackable meta & data
+     * segments for this namespace in the local track list.
+     * If the first number exceeds the last, or the local track list
+     * doesn't track current namespace yet, then we update it (attach
+     * to additional segments).
+     */
+
+    /* first update local information about initial segments. they can be extended, so then we need to attach to new segments. */
+    _update_initial_segment_info(ds_ctx, ns_map);
+
+    ns_info = _get_ns_info_from_initial_segment(ds_ctx, ns_map);
+    if (NULL == ns_info) {
+        /* no data for this namespace is found in the shared memory. */
+        PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
+                    "%s:%d:%s:  no data for ns %s is found in the shared memory.",
+                    __FILE__, __LINE__, __func__, ns_map->name));
+        return PMIX_ERR_PROC_ENTRY_NOT_FOUND;
+    }
+
+    /* get ns_track_elem_t object for the target namespace from the local track list. */
+    *elem = _get_track_elem_for_namespace(ds_ctx, ns_map);
+    if (NULL == *elem) {
+        /* Shouldn't happen! */
+        rc = PMIX_ERR_FATAL;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* need to update tracker:
+     * attach to shared memory regions for this namespace and store its info locally
+     * to operate with address and detach/unlink afterwards. */
+    rc = _update_ns_elem(ds_ctx, *elem, ns_info);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    _update_ns_index(ds_ctx, *elem);
+    _update_ns_replica(ds_ctx, *elem);
+    (*elem)->gen = gen;
+
+    return PMIX_SUCCESS;
+}
+
+/* the walk over the data of a rank visits every byte of the data
+ * segments at most once, a chain that doesn't end within this number
+ * of steps was torn by a concurrent update */
+static inline size_t _walk_steps(ns_track_elem_t *elem)
+{
+    return (elem->num_data_seg + 1) * _ESH_DATA_SEG_SIZE(elem->data_seg) / sizeof(size_t);
+}
+
+/* move the walk over the invalidated pairs and the extension slots
+ * to the next live key-value pair of the rank. Returns:
+ * PMIX_SUCCESS - addr points to the pair, it is within the bounds
+ * PMIX_ERR_NOT_FOUND - there is no more data for the rank
+ * PMIX_ERR_FATAL - the data of the rank is broken */
+static pmix_status_t _next_kv(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *elem,
+                              uint8_t **addr, uint8_t **end, size_t *steps)
+{
+    uint8_t *data_ptr;
+    size_t offset;
+
+    for (; 0 < *steps; (*steps)--) {
+        /* data is stored in the following format:
+         * key_val_pair {
+         *     size_t size;
+         *     char key[KNAME_LEN(addr)];
+         *     byte_t byte[size]; // should be loaded to pmix_buffer_t and unpacked.
+         * };
+         * segment_format {
+         *     key_val_pair kv_array[n];
+         *     EXTENSION slot;
+         * }
+         * EXTENSION slot which has key = EXTENSION_SLOT and a size_t value for offset
+         * to next data address for this process.
+         */
+        if (!_kv_in_bounds(ds_ctx, *addr, *end)) {
+            return PMIX_ERR_FATAL;
+        }
+        if (PMIX_DS_KEY_IS_INVALID(ds_ctx, *addr)) {
+            PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                        "%s:%d:%s: for %s, skip %s region",
+                        __FILE__, __LINE__, __func__, elem->ns_map.name, ESH_REGION_INVALIDATED));
+            /* skip it
+             * go to next item, updating address */
+            *addr += PMIX_DS_KV_SIZE(ds_ctx, *addr);
+        } else if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, *addr)) {
+            data_ptr = PMIX_DS_DATA_PTR(ds_ctx, *addr);
+            if (sizeof(size_t) > PMIX_DS_DATA_SIZE(ds_ctx, *addr, data_ptr)) {
+                return PMIX_ERR_FATAL;
+            }
+            memcpy(&offset, data_ptr, sizeof(size_t));
+            PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                        "%s:%d:%s: for %s, reached %s with %lu value",
+                        __FILE__, __LINE__, __func__, elem->ns_map.name, ESH_REGION_EXTENSION, offset));
+            if (0 == offset) {
+                /* no more data for this rank */
+                return PMIX_ERR_NOT_FOUND;
+            }
+            /* go to next item, updating address */
+            *addr = _get_data_region(ds_ctx, elem->data_seg, offset, end);
+            if (NULL == *addr) {
+                return PMIX_ERR_FATAL;
+            }
+        } else {
+            return PMIX_SUCCESS;
+        }
+    }
+    return PMIX_ERR_FATAL;
+}
+
+/* look for the key-value pair of the rank in the shared memory,
+ * the reader lock must be held by the caller. Returns:
+ * PMIX_SUCCESS - the pair is found, kval_addr points to it
+ * PMIX_ERR_NOT_FOUND - the rank has no such key
+ * PMIX_ERR_PROC_ENTRY_NOT_FOUND - there is no data for the rank
+ * PMIX_ERR_FATAL - the data of the rank is broken */
+static pmix_status_t _dstore_find_key(pmix_common_dstore_ctx_t *ds_ctx,
+                                      ns_track_elem_t *elem, pmix_rank_t rank,
+                                      const char *key, size_t keyhash,
+                                      uint8_t **kval_addr)
+{
+    rank_meta_info *rinfo;
+    size_t kval_cnt, steps;
+    uint8_t *addr, *end;
+    pmix_status_t rc;
+
+    if (NULL == (addr = _get_replica_data(elem, rank, &kval_cnt, &end))) {
+        /* Get the rank meta info in the shared meta segment. */
+        rinfo = _get_rank_meta_info(ds_ctx, rank, elem->meta_seg);
+        if (NULL == rinfo) {
+            PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
+                        "%s:%d:%s:  no data for this rank is found in the shared memory. rank %u",
+                        __FILE__, __LINE__, __func__, rank));
+            return PMIX_ERR_PROC_ENTRY_NOT_FOUND;
+        }
+        addr = _get_data_region(ds_ctx, elem->data_seg, rinfo->offset, &end);
+        if (NULL == addr) {
+            /* This means that meta-info is broken */
+            return PMIX_ERR_FATAL;
+        }
+        kval_cnt = rinfo->count;
+
+        /* try the key index first: it either points directly to the
+         * target key-value pair or tells that there is no such key */
+        rc = _index_get(ds_ctx, elem, rank, key, keyhash, kval_addr);
+        if (PMIX_ERR_NOT_AVAILABLE != rc) {
+            return rc;
+        }
+    }
+
+    steps = _walk_steps(elem);
+    while (0 < kval_cnt) {
+        rc = _next_kv(ds_ctx, elem, &addr, &end, &steps);
+        if (PMIX_ERR_NOT_FOUND == rc) {
+            PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
+                        "%s:%d:%s:  no more data for this rank is found in the shared memory. rank %u key %s not found",
+                        __FILE__, __LINE__, __func__, rank, key));
+            break;
+        }
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        if (PMIX_DS_KEY_MATCH(ds_ctx, addr, key, keyhash)) {
+            PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                        "%s:%d:%s: for rank %s:%u, found target key %s",
+                        __FILE__, __LINE__, __func__, elem->ns_map.name, rank, key));
+            *kval_addr = addr;
+            return PMIX_SUCCESS;
+        }
+        PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                    "%s:%d:%s: for rank %s:%u, skip key %s look for key %s",
+                    __FILE__, __LINE__, __func__, elem->ns_map.name, rank,
+                    PMIX_DS_KNAME_PTR(ds_ctx, addr), key));
+        /* go to next item, updating address */
+        addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        kval_cnt--;
+    }
+
+    return PMIX_ERR_NOT_FOUND;
+}
+
+static pmix_status_t _unpack_value(pmix_common_dstore_ctx_t *ds_ctx,
+                                   uint8_t *data_ptr, size_t data_size,
+                                   pmix_value_t **val)
+{
+    pmix_status_t rc;
+
+    *val = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+    if (NULL == *val) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_VALUE_CONSTRUCT(*val);
+
+    rc = _decode_value(ds_ctx, data_ptr, data_size, *val);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_VALUE_RELEASE(*val);
+        *val = NULL;
+    }
+    return rc;
+}
+
 static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                                    const char *nspace, pmix_rank_t rank,
                                    const char *key, pmix_value_t **kvs)
 {
-    ns_seg_info_t *ns_info = NULL;
     pmix_status_t rc = PMIX_ERROR, lock_rc;
     ns_track_elem_t *elem;
     rank_meta_info *rinfo = NULL;
-    size_t kval_cnt = 0;
-    pmix_dstore_seg_desc_t *meta_seg, *data_seg;
-    uint8_t *addr;
-    pmix_buffer_t buffer;
+    size_t kval_cnt = 0, steps;
+    pmix_dstore_seg_desc_t *meta_seg;
+    uint8_t *addr, *end;
     pmix_value_t val, *kval = NULL;
-    uint32_t nprocs;
-    pmix_rank_t cur_rank;
+    uint32_t nprocs, req_nprocs;
+    pmix_rank_t cur_rank, req_rank;
     ns_map_data_t *ns_map = NULL;
     bool all_ranks_found = true;
     bool key_found = false;
@@ -1949,6 +3289,7 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
     size_t ninfo;
     size_t keyhash = 0;
     bool lock_is_set = false;
+    pmix_common_dstor_rd_state_t rd_state = {0};
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                          "%s:%d:%s: for %s:%u look for key %s",
@@ -1997,61 +3338,25 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
         nprocs = 1;
         cur_rank = rank;
     }
+    req_nprocs = nprocs;
+    req_rank = cur_rank;
 
+retry:
     /* grab shared lock */
-    lock_rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, rd_lock);
+    lock_rc = _ESH_RD_BEGIN(ds_ctx, ns_map->tbl_idx, &rd_state);
     if (PMIX_SUCCESS != lock_rc) {
         /* Something wrong with the lock. The error is fatal */
         rc = lock_rc;
         goto error;
     }
 
-    /* First of all, we go through all initial segments and look at their field.
-     * If it's 1, then generate name of next initial segment incrementing id by one and attach to it.
-     * We need this step to synchronize initial shared segments with our local track list.
-     * Then we look for the target namespace in all initial segments.
-     * If it is found, we get numbers of meta & data segments and
-     * compare these numbers with the number of trackable meta & data
-     * segments for this namespace in the local track list.
-     * If the first number exceeds the last, or the local track list
-     * doesn't track current namespace yet, then we update it (attach
-     * to additional segments).
-     */
-
-    /* first update local information about initial segments. they can be extended, so then we need to attach to new segments. */
-    _update_initial_segment_info(ds_ctx, ns_map);
-
-    ns_info = _get_ns_info_from_initial_segment(ds_ctx, ns_map);
-    if (NULL == ns_info) {
-        /* no data for this namespace is found in the shared memory. */
-        PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
-                    "%s:%d:%s:  no data for ns %s is found in the shared memory.",
-                    __FILE__, __LINE__, __func__, ns_map->name));
-        rc = PMIX_ERR_PROC_ENTRY_NOT_FOUND;
-        goto done;
-    }
-
-    /* get ns_track_elem_t object for the target namespace from the local track list. */
-    elem = _get_track_elem_for_namespace(ds_ctx, ns_map);
-    if (NULL == elem) {
-        /* Shouldn't happen! */
-        rc = PMIX_ERR_FATAL;
-        PMIX_ERROR_LOG(rc);
-        goto done;
-    }
-
-    /* need to update tracker:
-     * attach to shared memory regions for this namespace and store its info locally
-     * to operate with address and detach/unlink afterwards. */
-    rc = _update_ns_elem(ds_ctx, elem, ns_info);
+    rc = _dstore_sync_ns(ds_ctx, ns_map, &elem);
     if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
         goto done;
     }
 
     /* Now we have the data from meta segment for this namespace. */
     meta_seg = elem->meta_seg;
-    data_seg = elem->data_seg;
 
     if( NULL != key ) {
         keyhash = PMIX_DS_KEY_HASH(ds_ctx, key);
@@ -2065,27 +3370,60 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
         }
     }
 
+    /* the values are decoded into kval and handed over to the
+     * caller only once the read is known to be consistent */
     while (nprocs--) {
-        /* Get the rank meta info in the shared meta segment. */
-        rinfo = _get_rank_meta_info(ds_ctx, cur_rank, meta_seg);
-        if (NULL == rinfo) {
-            PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
-                        "%s:%d:%s:  no data for this rank is found in the shared memory. rank %u",
-                        __FILE__, __LINE__, __func__, cur_rank));
-            all_ranks_found = false;
+        if (NULL != key) {
+            rc = _dstore_find_key(ds_ctx, elem, cur_rank, key, keyhash, &addr);
+            if (PMIX_SUCCESS == rc) {
+                /* target key is found, get value */
+                uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+                size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
+                rc = _unpack_value(ds_ctx, data_ptr, data_size, &kval);
+                if (PMIX_SUCCESS != rc) {
+                    goto done;
+                }
+                key_found = true;
+                goto done;
+            }
+            if (PMIX_ERR_PROC_ENTRY_NOT_FOUND == rc) {
+                all_ranks_found = false;
+            } else if (PMIX_ERR_NOT_FOUND != rc) {
+                goto done;
+            }
+            rc = PMIX_SUCCESS;
+            if (PMIX_RANK_UNDEF == rank) {
+                cur_rank++;
+            }
             continue;
         }
-        addr = _get_data_region_by_offset(ds_ctx, data_seg, rinfo->offset);
-        if (NULL == addr) {
-            /* This means that meta-info is broken - error is fatal */
+
+        if (NULL == (addr = _get_replica_data(elem, cur_rank, &kval_cnt, &end))) {
+            /* Get the rank meta info in the shared meta segment. */
+            rinfo = _get_rank_meta_info(ds_ctx, cur_rank, meta_seg);
+            if (NULL == rinfo) {
+                PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
+                            "%s:%d:%s:  no data for this rank is found in the shared memory. rank %u",
+                            __FILE__, __LINE__, __func__, cur_rank));
+                all_ranks_found = false;
+                continue;
+            }
+            addr = _get_data_region(ds_ctx, elem->data_seg, rinfo->offset, &end);
+            if (NULL == addr) {
+                /* This means that meta-info is broken - error is fatal */
+                rc = PMIX_ERR_FATAL;
+                goto done;
+            }
+            kval_cnt = rinfo->count;
+        }
+        if (kval_cnt > _walk_steps(elem)) {
+            /* an optimistic reader may see a torn counter */
             rc = PMIX_ERR_FATAL;
-            PMIX_ERROR_LOG(rc);
             goto done;
         }
-        kval_cnt = rinfo->count;
 
         /*  Initialize array for all keys of rank */
-        if ((NULL == key) && (kval_cnt > 0)) {
+        if (kval_cnt > 0) {
             kval = (pmix_value_t*)malloc(sizeof(pmix_value_t));
             if (NULL == kval) {
                 rc = PMIX_ERR_NOMEM;
@@ -2109,112 +3447,44 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
             kval->data.darray->type = PMIX_INFO;
             kval->data.darray->size = ninfo;
             kval->data.darray->array = info;
-            *kvs = kval;
         }
 
         rc = PMIX_SUCCESS;
+        steps = _walk_steps(elem);
         while (0 < kval_cnt) {
-            /* data is stored in the following format:
-             * key_val_pair {
-             *     size_t size;
-             *     char key[KNAME_LEN(addr)];
-             *     byte_t byte[size]; // should be loaded to pmix_buffer_t and unpacked.
-             * };
-             * segment_format {
-             *     key_val_pair kv_array[n];
-             *     EXTENSION slot;
-             * }
-             * EXTENSION slot which has key = EXTENSION_SLOT and a size_t value for offset
-             * to next data address for this process.
-             */
-            if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
-                PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                            "%s:%d:%s: for rank %s:%u, skip %s region",
-                            __FILE__, __LINE__, __func__, nspace, cur_rank, ESH_REGION_INVALIDATED));
-                /* skip it
-                 * go to next item, updating address */
-                addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
-            } else if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
-                size_t offset;
-                memcpy(&offset, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
-                PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                            "%s:%d:%s: for rank %s:%u, reached %s with %lu value",
-                            __FILE__, __LINE__, __func__, nspace, cur_rank, ESH_REGION_EXTENSION, offset));
-                if (0 < offset) {
-                    /* go to next item, updating address */
-                    addr = _get_data_region_by_offset(ds_ctx, data_seg, offset);
-                    if (NULL == addr) {
-                        /* This shouldn't happen - error is fatal */
-                        rc = PMIX_ERR_FATAL;
-                        PMIX_ERROR_LOG(rc);
-                        goto done;
-                    }
-                } else {
-                    /* no more data for this rank */
-                    PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
-                                "%s:%d:%s:  no more data for this rank is found in the shared memory. rank %u key %s not found",
-                                __FILE__, __LINE__, __func__, cur_rank, key));
-                    break;
-                }
-            } else if (NULL == key) {
-                PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                            "%s:%d:%s: for rank %s:%u, found target key %s",
-                            __FILE__, __LINE__, __func__, nspace, cur_rank, PMIX_DS_KNAME_PTR(ds_ctx, addr)));
-
-                uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
-                size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
-                PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
-                PMIX_LOAD_BUFFER(_client_peer(ds_ctx), &buffer, data_ptr, data_size);
-                int cnt = 1;
-                /* unpack value for this key from the buffer. */
-                PMIX_VALUE_CONSTRUCT(&val);
-                PMIX_BFROPS_UNPACK(rc, _client_peer(ds_ctx), &buffer, &val, &cnt, PMIX_VALUE);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto done;
-                }
-                pmix_strncpy(info[kval_cnt - 1].key, PMIX_DS_KNAME_PTR(ds_ctx, addr),
-                        PMIX_DS_KNAME_LEN(ds_ctx, addr));
-                pmix_value_xfer(&info[kval_cnt - 1].value, &val);
+            rc = _next_kv(ds_ctx, elem, &addr, &end, &steps);
+            if (PMIX_ERR_NOT_FOUND == rc) {
+                /* no more data for this rank */
+                PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
+                            "%s:%d:%s:  no more data for this rank is found in the shared memory. rank %u",
+                            __FILE__, __LINE__, __func__, cur_rank));
+                rc = PMIX_SUCCESS;
+                break;
+            }
+            if (PMIX_SUCCESS != rc) {
+                goto done;
+            }
+            PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                        "%s:%d:%s: for rank %s:%u, found target key %s",
+                        __FILE__, __LINE__, __func__, nspace, cur_rank, PMIX_DS_KNAME_PTR(ds_ctx, addr)));
+
+            uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+            size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
+            /* unpack value for this key */
+            PMIX_VALUE_CONSTRUCT(&val);
+            rc = _decode_value(ds_ctx, data_ptr, data_size, &val);
+            if (PMIX_SUCCESS != rc) {
                 PMIX_VALUE_DESTRUCT(&val);
-                buffer.base_ptr = NULL;
-                buffer.bytes_used = 0;
-                PMIX_DESTRUCT(&buffer);
-                key_found = true;
-
-                kval_cnt--;
-                addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
-            } else if (PMIX_DS_KEY_MATCH(ds_ctx, addr, key, keyhash)) {
-                PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                            "%s:%d:%s: for rank %s:%u, found target key %s",
-                            __FILE__, __LINE__, __func__, nspace, cur_rank, key));
-                /* target key is found, get value */
-                uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
-                size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
-                PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
-                PMIX_LOAD_BUFFER(_client_peer(ds_ctx), &buffer, data_ptr, data_size);
-                int cnt = 1;
-                /* unpack value for this key from the buffer. */
-                *kvs = (pmix_value_t*)malloc(sizeof(pmix_value_t));
-                PMIX_BFROPS_UNPACK(rc, _client_peer(ds_ctx), &buffer, (void*)*kvs, &cnt, PMIX_VALUE);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto done;
-                }
-                buffer.base_ptr = NULL;
-                buffer.bytes_used = 0;
-                PMIX_DESTRUCT(&buffer);
-                key_found = true;
                 goto done;
-            } else {
-                PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                            "%s:%d:%s: for rank %s:%u, skip key %s look for key %s",
-                            __FILE__, __LINE__, __func__, nspace, cur_rank,
-                            PMIX_DS_KNAME_PTR(ds_ctx, addr), key));
-                /* go to next item, updating address */
-                addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
-                kval_cnt--;
             }
+            pmix_strncpy(info[kval_cnt - 1].key, PMIX_DS_KNAME_PTR(ds_ctx, addr),
+                    PMIX_DS_KNAME_LEN(ds_ctx, addr));
+            /* the decoded value is ours - hand it over */
+            pmix_bfrops_base_value_move(&info[kval_cnt - 1].value, &val);
+            key_found = true;
+
+            kval_cnt--;
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
         }
 
         if (PMIX_RANK_UNDEF == rank) {
@@ -2224,7 +3494,34 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
 
 done:
     /* unset lock */
-    lock_rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, rd_unlock);
+    lock_rc = _ESH_RD_END(ds_ctx, ns_map->tbl_idx, &rd_state);
+    if (PMIX_ERR_RESOURCE_BUSY == lock_rc || PMIX_SUCCESS != rc) {
+        /* drop whatever was collected, it is not published yet */
+        if (NULL != kval) {
+            if (PMIX_DATA_ARRAY != kval->type && NULL != info) {
+                PMIX_INFO_FREE(info, ninfo);
+            }
+            PMIX_VALUE_RELEASE(kval);
+        }
+        kval = NULL;
+        info = NULL;
+    }
+    if (PMIX_ERR_RESOURCE_BUSY == lock_rc) {
+        /* the store was modified while we were reading it,
+         * the data may be torn - read it again */
+        kval_cnt = 0;
+        key_found = false;
+        all_ranks_found = true;
+        nprocs = req_nprocs;
+        cur_rank = req_rank;
+        if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) && !lock_is_set) {
+            if (0 != (rc = pthread_mutex_lock(&ds_ctx->lock))) {
+                goto error;
+            }
+            lock_is_set = true;
+        }
+        goto retry;
+    }
     if (PMIX_SUCCESS != lock_rc) {
         PMIX_ERROR_LOG(lock_rc);
     }
@@ -2235,21 +3532,20 @@ done:
     }
 
     if( rc != PMIX_SUCCESS ){
-        if ((NULL == key) && (kval_cnt > 0)) {
-            if( NULL != info ) {
-                PMIX_INFO_FREE(info, ninfo);
-            }
-            if (NULL != kval) {
-                PMIX_VALUE_RELEASE(kval);
-            }
+        if (PMIX_ERR_NOT_FOUND != rc && PMIX_ERR_PROC_ENTRY_NOT_FOUND != rc) {
+            PMIX_ERROR_LOG(rc);
         }
         return rc;
     }
 
     if( key_found ){
-        /* the key is found - nothing to do */
+        /* the read is consistent - publish the value */
+        *kvs = kval;
         return PMIX_SUCCESS;
     }
+    if (NULL != kval) {
+        PMIX_VALUE_RELEASE(kval);
+    }
 
     if( !all_ranks_found ){
         /* Not all ranks was found - need to request
@@ -2269,6 +3565,147 @@ error:
     return rc;
 }
 
+PMIX_EXPORT size_t pmix_common_dstor_reclaimed_bytes(pmix_common_dstore_ctx_t *ds_ctx)
+{
+    return ds_ctx->reclaimed_bytes;
+}
+
+PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch_batch(pmix_common_dstore_ctx_t *ds_ctx,
+                                                          const pmix_proc_t procs[],
+                                                          const char *keys[], size_t nreqs,
+                                                          pmix_value_t *vals[],
+                                                          pmix_status_t status[])
+{
+    ns_map_data_t *ns_map;
+    ns_track_elem_t *elem = NULL;
+    pmix_status_t rc, lock_rc;
+    size_t n, first, last, keyhash = 0;
+    const char *hashed = NULL;
+    uint8_t *addr;
+    bool lock_is_set;
+    pmix_common_dstor_rd_state_t rd_state;
+    pmix_value_t **svals;
+    pmix_status_t *sstatus;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "gds: dstore fetch batch of %lu", (unsigned long)nreqs);
+
+    for (n = 0; n < nreqs; n++) {
+        vals[n] = NULL;
+        status[n] = PMIX_ERR_NOT_FOUND;
+    }
+
+    /* the values of a group are decoded into the scratch arrays and
+     * published only once the read of the group is consistent */
+    svals = (pmix_value_t**)calloc(nreqs, sizeof(pmix_value_t*));
+    sstatus = (pmix_status_t*)calloc(nreqs, sizeof(pmix_status_t));
+    if (NULL == svals || NULL == sstatus) {
+        free(svals);
+        free(sstatus);
+        return PMIX_ERR_NOMEM;
+    }
+
+    /* consecutive requests to the same namespace share the segments
+     * synchronization and the locking */
+    for (first = 0; first < nreqs; first = last) {
+        for (last = first + 1; last < nreqs; last++) {
+            if (0 != strncmp(procs[first].nspace, procs[last].nspace, PMIX_MAX_NSLEN)) {
+                break;
+            }
+        }
+        memset(&rd_state, 0, sizeof(rd_state));
+
+retry:
+        lock_is_set = false;
+        if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+            if (0 != pthread_mutex_lock(&ds_ctx->lock)) {
+                rc = PMIX_ERROR;
+                goto exit;
+            }
+            lock_is_set = true;
+        }
+
+        if (NULL == (ns_map = ds_ctx->session_map_search(ds_ctx, procs[first].nspace))) {
+            if (lock_is_set) {
+                pthread_mutex_unlock(&ds_ctx->lock);
+            }
+            continue;
+        }
+
+        /* grab shared lock */
+        lock_rc = _ESH_RD_BEGIN(ds_ctx, ns_map->tbl_idx, &rd_state);
+        if (PMIX_SUCCESS != lock_rc) {
+            /* Something wrong with the lock. The error is fatal */
+            PMIX_ERROR_LOG(lock_rc);
+            if (lock_is_set) {
+                pthread_mutex_unlock(&ds_ctx->lock);
+            }
+            rc = lock_rc;
+            goto exit;
+        }
+
+        rc = _dstore_sync_ns(ds_ctx, ns_map, &elem);
+
+        /* all segment data updated, ctx lock may released */
+        if (lock_is_set) {
+            pthread_mutex_unlock(&ds_ctx->lock);
+        }
+
+        for (n = first; n < last; n++) {
+            svals[n] = NULL;
+            if (PMIX_SUCCESS != rc) {
+                sstatus[n] = rc;
+                continue;
+            }
+            if (NULL == keys[n] || '\0' == keys[n][0] ||
+                PMIX_RANK_UNDEF == procs[n].rank) {
+                sstatus[n] = PMIX_ERR_BAD_PARAM;
+                continue;
+            }
+            /* the same key is typically requested for many ranks */
+            if (NULL == hashed || 0 != strcmp(keys[n], hashed)) {
+                keyhash = PMIX_DS_KEY_HASH(ds_ctx, keys[n]);
+                hashed = keys[n];
+            }
+            sstatus[n] = _dstore_find_key(ds_ctx, elem, procs[n].rank, keys[n], keyhash, &addr);
+            if (PMIX_SUCCESS == sstatus[n]) {
+                uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+                size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
+                sstatus[n] = _unpack_value(ds_ctx, data_ptr, data_size, &svals[n]);
+            }
+        }
+
+        /* unset lock */
+        lock_rc = _ESH_RD_END(ds_ctx, ns_map->tbl_idx, &rd_state);
+        if (PMIX_ERR_RESOURCE_BUSY == lock_rc) {
+            /* the store was modified while the group was read */
+            for (n = first; n < last; n++) {
+                if (NULL != svals[n]) {
+                    PMIX_VALUE_RELEASE(svals[n]);
+                }
+            }
+            goto retry;
+        }
+        if (PMIX_SUCCESS != lock_rc) {
+            PMIX_ERROR_LOG(lock_rc);
+        }
+        for (n = first; n < last; n++) {
+            vals[n] = svals[n];
+            status[n] = sstatus[n];
+            if (PMIX_SUCCESS != status[n] && PMIX_ERR_NOT_FOUND != status[n] &&
+                PMIX_ERR_PROC_ENTRY_NOT_FOUND != status[n] && PMIX_ERR_BAD_PARAM != status[n]) {
+                PMIX_ERROR_LOG(status[n]);
+            }
+        }
+    }
+    rc = PMIX_SUCCESS;
+
+exit:
+    free(svals);
+    free(sstatus);
+    return rc;
+}
+
 PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                                                     const pmix_proc_t *proc,
                                                     pmix_scope_t scope, bool copy,
@@ -2306,15 +3743,17 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_c
                     return rc;
                 }
                 kv->key = strdup(info[n].key);
-                PMIX_VALUE_XFER(rc, kv->value, &info[n].value);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
+                kv->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+                if (NULL == kv->key || NULL == kv->value) {
                     PMIX_RELEASE(kv);
                     PMIX_VALUE_RELEASE(val);
-                    return rc;
+                    return PMIX_ERR_NOMEM;
                 }
+                /* the array is ours - hand the values over */
+                pmix_bfrops_base_value_move(kv->value, &info[n].value);
                 pmix_list_append(kvs, &kv->super);
             }
+            PMIX_VALUE_RELEASE(val);
 
             return PMIX_SUCCESS;
         }
@@ -29,6 +29,13 @@ BEGIN_C_DECLS
 #define INITIAL_SEG_SIZE 4096
 #define NS_META_SEG_SIZE (1<<22)
 #define NS_DATA_SEG_SIZE (1<<22)
+/* expected amount of data stored for each rank of a presized namespace */
+#define ESH_PRESIZE_RANK_DATA 2048
+/* upper limit of a presized segment, larger jobs chain segments */
+#define ESH_PRESIZE_MAX_SEG_SIZE (1<<28)
+/* percentage of invalidated data triggering the compaction,
+ * the compaction is off unless requested */
+#define ESH_COMPACT_THRESHOLD 0
 
 #define PMIX_DSTORE_ESH_BASE_PATH "PMIX_DSTORE_ESH_BASE_PATH"
 #define PMIX_DSTORE_VER_BASE_PATH_FMT "PMIX_DSTORE_%d_BASE_PATH"
@@ -71,6 +78,27 @@ struct pmix_common_dstore_ctx_s {
      * sparse communication patterns when direct modex is usually used.
      */
     int direct_mode;
+    /* If key_index is set, the server maintains a per-rank hashed
+     * index of the keys stored in the data segments, so clients can
+     * find a key without walking all key-value records of the rank.
+     * Clients detect the index by the presence of its segments. */
+    int key_index;
+    /* Data segments of a namespace are compacted once invalidated
+     * key-value pairs take this percentage of the used space,
+     * 0 disables the compaction. It is only done with a blocking
+     * read lock as the pairs move under optimistic readers. */
+    size_t compact_threshold;
+    /* total number of bytes the compaction gave back to the system */
+    size_t reclaimed_bytes;
+    /* If numa_replicas is set, the server keeps a copy of the job-level
+     * data of every namespace on each NUMA node. Clients read from the
+     * replica of their node, found by the presence of its segment. */
+    int numa_replicas;
+    /* NUMA node of the client, -1 if not known yet, -2 if unknown */
+    int numa_idx;
+    /* If presize is set, the server sizes the meta and data segments
+     * of a namespace from the job geometry so they don't get chained */
+    int presize;
     /* dstore ctx protect lock, uses for clients only */
     pthread_mutex_t lock;
 };
@@ -100,6 +128,8 @@ struct ns_map_s {
  * size_t num_elems;
  * size_t full; //indicate to client that it needs to attach to the next segment
  * ns_seg_info_t ns_seg_info[max_ns_num];
+ * ...
+ * size_t gen; //last word of the first initial segment: generation of the session
  */
 
 typedef struct {
@@ -119,6 +149,51 @@ typedef struct {
     size_t count;
 } rank_meta_info;
 
+/* key index meta segment format:
+ * rank_index_hdr hdr; // valid in the first segment only
+ * rank_index_info idx_info[max_idx_elems];
+ *
+ * rank_index_info objects are placed by the same rank based
+ * offsets as rank_meta_info objects in the meta segment.
+ */
+
+typedef struct {
+    size_t version;
+    size_t num_meta_seg;
+    size_t num_data_seg;
+} rank_index_hdr;
+
+typedef struct {
+    size_t offset;  /* global offset of the hash table in the index data segments, 0 if none */
+    size_t size;    /* number of buckets, always a power of two */
+    size_t count;   /* number of used buckets */
+} rank_index_info;
+
+/* key index data segment format:
+ * size_t free_offset;
+ * rank_index_entry table[rank_index_info.size];
+ * ...
+ *
+ * Empty buckets have a zero offset as no key-value pair
+ * can be placed at the very beginning of a data segment.
+ */
+
+typedef struct {
+    uint64_t hash;
+    size_t offset;  /* global offset of the key-value pair in the data segments */
+} rank_index_entry;
+
+/* NUMA replica segment format:
+ * rank_replica_hdr hdr;
+ * key-value pairs of PMIX_RANK_WILDCARD, as in the data segments;
+ * empty EXTENSION slot.
+ */
+
+typedef struct {
+    size_t size;    /* bytes used including the header, 0 if the replica is stale */
+    size_t count;   /* number of key-value pairs */
+} rank_replica_hdr;
+
 typedef struct {
     pmix_value_array_t super;
     ns_map_data_t ns_map;
@@ -126,7 +201,18 @@ typedef struct {
     size_t num_data_seg;
     pmix_dstore_seg_desc_t *meta_seg;
     pmix_dstore_seg_desc_t *data_seg;
+    size_t num_idx_meta_seg;
+    size_t num_idx_data_seg;
+    pmix_dstore_seg_desc_t *idx_meta_seg;
+    pmix_dstore_seg_desc_t *idx_data_seg;
+    bool idx_checked;
+    size_t meta_seg_size;   /* server: size of the segments to create, 0 for default */
+    size_t data_seg_size;
+    pmix_dstore_seg_desc_t *rep_seg;    /* server: one per NUMA node, clients: the local one */
+    bool rep_checked;
     bool in_use;
+    size_t dead_bytes;  /* invalidated data since the last compaction */
+    size_t gen;         /* clients: session generation of the last sync */
 } ns_track_elem_t;
 
 typedef struct {
@@ -34,6 +34,20 @@ typedef pmix_status_t (*pmix_common_dstor_lock_rd_rel_fn_t)(pmix_common_dstor_lo
 typedef pmix_status_t (*pmix_common_dstor_lock_wr_get_fn_t)(pmix_common_dstor_lock_ctx_t ctx);
 typedef pmix_status_t (*pmix_common_dstor_lock_wr_rel_fn_t)(pmix_common_dstor_lock_ctx_t ctx);
 
+/* read side state of an optimistic reader. It is owned by the caller
+ * for the duration of a single read, so concurrent and nested reads
+ * never share it */
+typedef struct {
+    int32_t seq;        /* sequence observed when the read started */
+    int retries;        /* number of reads repeated so far */
+    bool locked;        /* the reader fell back to the blocking lock */
+} pmix_common_dstor_rd_state_t;
+
+typedef pmix_status_t (*pmix_common_dstor_lock_rd_begin_fn_t)(pmix_common_dstor_lock_ctx_t ctx,
+                                                             pmix_common_dstor_rd_state_t *state);
+typedef pmix_status_t (*pmix_common_dstor_lock_rd_end_fn_t)(pmix_common_dstor_lock_ctx_t ctx,
+                                                           pmix_common_dstor_rd_state_t *state);
+
 typedef struct {
     pmix_common_dstor_lock_init_fn_t init;
     pmix_common_dstor_lock_finalize_fn_t finalize;
@@ -41,6 +55,11 @@ typedef struct {
     pmix_common_dstor_lock_rd_rel_fn_t rd_unlock;
     pmix_common_dstor_lock_wr_get_fn_t wr_lock;
     pmix_common_dstor_lock_wr_rel_fn_t wr_unlock;
+    /* optional optimistic read side: readers don't block the writer,
+     * rd_end returns PMIX_ERR_RESOURCE_BUSY if the data was modified
+     * while it was read and the read has to be repeated */
+    pmix_common_dstor_lock_rd_begin_fn_t rd_begin;
+    pmix_common_dstor_lock_rd_end_fn_t rd_end;
 } pmix_common_lock_callbacks_t;
 
 typedef struct pmix_common_dstore_ctx_s pmix_common_dstore_ctx_t;
@@ -73,8 +92,19 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_c
                                 const char *key,
                                 pmix_info_t info[], size_t ninfo,
                                 pmix_list_t *kvs);
+/* fetch the values of nreqs (proc, key) pairs at once. Values and
+ * per-request status are returned in the vals and status arrays.
+ * Consecutive requests to the same namespace are served within a
+ * single segments synchronization and lock acquisition */
+PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch_batch(pmix_common_dstore_ctx_t *ds_ctx,
+                                const pmix_proc_t procs[],
+                                const char *keys[], size_t nreqs,
+                                pmix_value_t *vals[],
+                                pmix_status_t status[]);
 PMIX_EXPORT pmix_status_t pmix_common_dstor_store_modex(pmix_common_dstore_ctx_t *ds_ctx,
                                 struct pmix_namespace_t *nspace,
                                 pmix_buffer_t *buff,
                                 void *cbdata);
+/* number of bytes reclaimed by the data segments compaction */
+PMIX_EXPORT size_t pmix_common_dstor_reclaimed_bytes(pmix_common_dstore_ctx_t *ds_ctx);
 #endif
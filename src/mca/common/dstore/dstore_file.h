@@ -16,6 +16,14 @@ typedef void (*pmix_common_dstore_set_invalid_fn)(uint8_t *addr);
 typedef size_t (*pmix_common_dstore_key_hash_fn)(const char *key);
 typedef bool (*pmix_common_dstore_key_match_fn)(uint8_t *addr, const char *key,
                                                   size_t key_hash);
+/* optional value encoding of the record format, the values
+ * are stored as bfrops-packed PMIX_VALUE if not provided */
+typedef pmix_status_t (*pmix_common_dstore_value_pack_fn)(pmix_peer_t *peer,
+                                                          pmix_buffer_t *buf,
+                                                          pmix_value_t *val);
+typedef pmix_status_t (*pmix_common_dstore_value_unpack_fn)(pmix_peer_t *peer,
+                                                            uint8_t *data, size_t size,
+                                                            pmix_value_t *val);
 
 typedef struct {
     const char *name;
@@ -32,6 +40,8 @@ typedef struct {
     pmix_common_dstore_set_invalid_fn set_invalid;
     pmix_common_dstore_key_hash_fn key_hash;
     pmix_common_dstore_key_match_fn key_match;
+    pmix_common_dstore_value_pack_fn value_pack;
+    pmix_common_dstore_value_unpack_fn value_unpack;
 } pmix_common_dstore_file_cbs_t;
 
 #define ESH_REGION_EXTENSION        "EXTENSION_SLOT"
@@ -40,6 +50,10 @@ typedef struct {
 #define ESH_ENV_NS_META_SEG_SIZE    "NS_META_SEG_SIZE"
 #define ESH_ENV_NS_DATA_SEG_SIZE    "NS_DATA_SEG_SIZE"
 #define ESH_ENV_LINEAR              "SM_USE_LINEAR_SEARCH"
+#define ESH_ENV_KEY_INDEX           "SM_USE_KEY_INDEX"
+#define ESH_ENV_COMPACT_THRESHOLD   "SM_COMPACT_THRESHOLD"
+#define ESH_ENV_NUMA_REPLICAS       "SM_NUMA_REPLICAS"
+#define ESH_ENV_PRESIZE             "SM_PRESIZE_SEGMENTS"
 
 #define ESH_MIN_KEY_LEN             (sizeof(ESH_REGION_INVALIDATED))
 
@@ -148,6 +162,10 @@ __pmix_attribute_extension__ ({                                     \
         }                                                           \
     } while(0)
 
+#define PMIX_DS_HAS_VALUE_FMT(ctx)                                  \
+    ((ctx)->file_cbs && (ctx)->file_cbs->value_pack &&              \
+     (ctx)->file_cbs->value_unpack)
+
 #define PMIX_DS_KEY_IS_EXTSLOT(ctx, addr)                           \
 __pmix_attribute_extension__ ({                                     \
     int ret = 0;                                                    \
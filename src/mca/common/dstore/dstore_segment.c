@@ -27,6 +27,9 @@
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
+#include <sys/mman.h>
+#include <errno.h>
+#include <string.h>
 
 #ifdef HAVE_SYS_AUXV_H
 #include <sys/auxv.h>
@@ -52,6 +55,86 @@ static size_t _initial_segment_size;
 static size_t _meta_segment_size;
 static size_t _data_segment_size;
 
+static size_t _segment_size(pmix_dstore_segment_type type)
+{
+    switch (type) {
+        case PMIX_DSTORE_INITIAL_SEGMENT:
+            return _initial_segment_size;
+        case PMIX_DSTORE_NS_META_SEGMENT:
+        case PMIX_DSTORE_NS_IDX_META_SEGMENT:
+            return _meta_segment_size;
+        case PMIX_DSTORE_NS_DATA_SEGMENT:
+        case PMIX_DSTORE_NS_IDX_DATA_SEGMENT:
+        case PMIX_DSTORE_NS_REP_SEGMENT:
+            return _data_segment_size;
+        default:
+            return 0;
+    }
+}
+
+static void _segment_file_name(pmix_dstore_segment_type type, const char *base_path,
+                               const char *name, uint32_t id, char *file_name)
+{
+    switch (type) {
+        case PMIX_DSTORE_INITIAL_SEGMENT:
+            snprintf(file_name, PMIX_PATH_MAX, "%s/initial-pmix_shared-segment-%u",
+                base_path, id);
+            break;
+        case PMIX_DSTORE_NS_META_SEGMENT:
+            snprintf(file_name, PMIX_PATH_MAX, "%s/smseg-%s-%u", base_path, name, id);
+            break;
+        case PMIX_DSTORE_NS_DATA_SEGMENT:
+            snprintf(file_name, PMIX_PATH_MAX, "%s/smdataseg-%s-%d", base_path, name, id);
+            break;
+        case PMIX_DSTORE_NS_IDX_META_SEGMENT:
+            snprintf(file_name, PMIX_PATH_MAX, "%s/smidxseg-%s-%u", base_path, name, id);
+            break;
+        case PMIX_DSTORE_NS_IDX_DATA_SEGMENT:
+            snprintf(file_name, PMIX_PATH_MAX, "%s/smidxdataseg-%s-%u", base_path, name, id);
+            break;
+        case PMIX_DSTORE_NS_REP_SEGMENT:
+            snprintf(file_name, PMIX_PATH_MAX, "%s/smrepseg-%s-%u", base_path, name, id);
+            break;
+        default:
+            file_name[0] = '\0';
+            break;
+    }
+}
+
+/* give the pages of the segment between the from and to offsets back
+ * to the system. The mapping stays valid and reads back zeroes. Returns
+ * the number of bytes actually released */
+PMIX_EXPORT size_t pmix_common_dstor_release_segment_range(pmix_dstore_seg_desc_t *desc,
+                                                           size_t from, size_t to)
+{
+#ifdef MADV_REMOVE
+    size_t page = pmix_common_dstor_getpagesize();
+
+    /* only whole pages can be released */
+    from = (from + page - 1) & ~(page - 1);
+    if (to > desc->seg_info.seg_size) {
+        to = desc->seg_info.seg_size;
+    }
+    to = (to + page - 1) & ~(page - 1);
+    if (to > (desc->seg_info.seg_size & ~(page - 1))) {
+        to = desc->seg_info.seg_size & ~(page - 1);
+    }
+    if (from >= to) {
+        return 0;
+    }
+    if (0 != madvise(desc->seg_info.seg_base_addr + from, to - from, MADV_REMOVE)) {
+        PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                             "%s:%d:%s: can't release %lu bytes of %s: %s",
+                             __FILE__, __LINE__, __func__, (unsigned long)(to - from),
+                             desc->seg_info.seg_name, strerror(errno)));
+        return 0;
+    }
+    return to - from;
+#else
+    return 0;
+#endif
+}
+
 PMIX_EXPORT int pmix_common_dstor_getpagesize(void)
 {
 #if defined(_SC_PAGESIZE )
@@ -163,34 +246,28 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_lock_seg(const
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_dstore_segment_type type,
                         const char *base_path, const char *name, uint32_t id,
                         uid_t uid, bool setuid)
+{
+    return pmix_common_dstor_create_sized_segment(type, base_path, name, id, 0, uid, setuid);
+}
+
+/* create a segment of the given size, 0 means the default size for the type */
+PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_sized_segment(pmix_dstore_segment_type type,
+                        const char *base_path, const char *name, uint32_t id,
+                        size_t size, uid_t uid, bool setuid)
 {
     pmix_status_t rc;
     char file_name[PMIX_PATH_MAX];
-    size_t size;
     pmix_dstore_seg_desc_t *new_seg = NULL;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                         "%s:%d:%s: segment type %d, nspace %s, id %u",
-                         __FILE__, __LINE__, __func__, type, name, id));
+                         "%s:%d:%s: segment type %d, nspace %s, id %u, size %lu",
+                         __FILE__, __LINE__, __func__, type, name, id, (unsigned long)size));
 
-    switch (type) {
-        case PMIX_DSTORE_INITIAL_SEGMENT:
-            size = _initial_segment_size;
-            snprintf(file_name, PMIX_PATH_MAX, "%s/initial-pmix_shared-segment-%u",
-                base_path, id);
-            break;
-        case PMIX_DSTORE_NS_META_SEGMENT:
-            size = _meta_segment_size;
-            snprintf(file_name, PMIX_PATH_MAX, "%s/smseg-%s-%u", base_path, name, id);
-            break;
-        case PMIX_DSTORE_NS_DATA_SEGMENT:
-            size = _data_segment_size;
-            snprintf(file_name, PMIX_PATH_MAX, "%s/smdataseg-%s-%d", base_path, name, id);
-            break;
-        default:
-            PMIX_ERROR_LOG(PMIX_ERROR);
-            return NULL;
+    if (0 == size && 0 == (size = _segment_size(type))) {
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        return NULL;
     }
+    _segment_file_name(type, base_path, name, id, file_name);
     new_seg = (pmix_dstore_seg_desc_t*)malloc(sizeof(pmix_dstore_seg_desc_t));
     if (new_seg) {
         new_seg->id = id;
@@ -229,6 +306,7 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_ds
                                                  const char *name, uint32_t id)
 {
     pmix_status_t rc;
+    struct stat st;
     pmix_dstore_seg_desc_t *new_seg = NULL;
     new_seg = (pmix_dstore_seg_desc_t*)malloc(sizeof(pmix_dstore_seg_desc_t));
     new_seg->id = id;
@@ -239,26 +317,19 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_ds
                          "%s:%d:%s: segment type %d, nspace %s, id %u",
                          __FILE__, __LINE__, __func__, type, name, id));
 
-    switch (type) {
-        case PMIX_DSTORE_INITIAL_SEGMENT:
-            new_seg->seg_info.seg_size = _initial_segment_size;
-            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/initial-pmix_shared-segment-%u",
-                base_path, id);
-            break;
-        case PMIX_DSTORE_NS_META_SEGMENT:
-            new_seg->seg_info.seg_size = _meta_segment_size;
-            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/smseg-%s-%u",
-                base_path, name, id);
-            break;
-        case PMIX_DSTORE_NS_DATA_SEGMENT:
-            new_seg->seg_info.seg_size = _data_segment_size;
-            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/smdataseg-%s-%d",
-                base_path, name, id);
-            break;
-        default:
-            free(new_seg);
-            PMIX_ERROR_LOG(PMIX_ERROR);
-            return NULL;
+    _segment_file_name(type, base_path, name, id, new_seg->seg_info.seg_name);
+    /* the server may size the namespace segments for the job,
+     * so take the actual size from the segment file */
+    if ((PMIX_DSTORE_NS_META_SEGMENT == type || PMIX_DSTORE_NS_DATA_SEGMENT == type) &&
+        0 == stat(new_seg->seg_info.seg_name, &st) && 0 < st.st_size) {
+        new_seg->seg_info.seg_size = (size_t)st.st_size;
+    } else {
+        new_seg->seg_info.seg_size = _segment_size(type);
+    }
+    if (0 == new_seg->seg_info.seg_size) {
+        free(new_seg);
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        return NULL;
     }
     rc = pmix_pshmem.segment_attach(&new_seg->seg_info, PMIX_PSHMEM_RONLY);
     if (PMIX_SUCCESS != rc) {
@@ -269,6 +340,18 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_ds
     return new_seg;
 }
 
+/* check if the segment was already created by the server without
+ * attaching to it - used for the optional segments which the
+ * server may not provide */
+PMIX_EXPORT bool pmix_common_dstor_segment_exists(pmix_dstore_segment_type type, const char *base_path,
+                                                  const char *name, uint32_t id)
+{
+    char file_name[PMIX_PATH_MAX];
+
+    _segment_file_name(type, base_path, name, id, file_name);
+    return (0 == access(file_name, R_OK));
+}
+
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_extend_segment(pmix_dstore_seg_desc_t *segdesc, const char *base_path,
                                              const char *name, uid_t uid, bool setuid)
 {
@@ -282,8 +365,10 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_extend_segment(pmix_dstore
     while (NULL != tmp->next) {
         tmp = tmp->next;
     }
-    /* create another segment, the old one is full. */
-    seg = pmix_common_dstor_create_new_segment(segdesc->type, base_path, name, tmp->id + 1, uid, setuid);
+    /* create another segment, the old one is full. All segments
+     * of the chain have the same size to keep the offsets global */
+    seg = pmix_common_dstor_create_sized_segment(segdesc->type, base_path, name, tmp->id + 1,
+                                                 segdesc->seg_info.seg_size, uid, setuid);
     tmp->next = seg;
 
     return seg;
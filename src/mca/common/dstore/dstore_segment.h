@@ -38,6 +38,9 @@ typedef enum {
     PMIX_DSTORE_NS_META_SEGMENT,
     PMIX_DSTORE_NS_DATA_SEGMENT,
     PMIX_DSTORE_NS_LOCK_SEGMENT,
+    PMIX_DSTORE_NS_IDX_META_SEGMENT,
+    PMIX_DSTORE_NS_IDX_DATA_SEGMENT,
+    PMIX_DSTORE_NS_REP_SEGMENT,
 } pmix_dstore_segment_type;
 
 struct pmix_dstore_seg_desc_t {
@@ -55,13 +58,21 @@ PMIX_EXPORT void pmix_common_dstor_init_segment_info(size_t initial_segment_size
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_dstore_segment_type type,
                         const char *base_path, const char *name, uint32_t id,
                         uid_t uid, bool setuid);
+PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_sized_segment(pmix_dstore_segment_type type,
+                        const char *base_path, const char *name, uint32_t id,
+                        size_t size, uid_t uid, bool setuid);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_dstore_segment_type type,
                         const char *base_path,
                         const char *name, uint32_t id);
+PMIX_EXPORT bool pmix_common_dstor_segment_exists(pmix_dstore_segment_type type,
+                        const char *base_path,
+                        const char *name, uint32_t id);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_extend_segment(pmix_dstore_seg_desc_t *segdesc,
                         const char *base_path,
                         const char *name, uid_t uid, bool setuid);
 PMIX_EXPORT void pmix_common_dstor_delete_sm_desc(pmix_dstore_seg_desc_t *desc);
+PMIX_EXPORT size_t pmix_common_dstor_release_segment_range(pmix_dstore_seg_desc_t *desc,
+                        size_t from, size_t to);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_lock_seg(const char *base_path, size_t size,
                         const char *name, uint32_t id, uid_t uid, bool setuid);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_lock_seg(const char *base_path,
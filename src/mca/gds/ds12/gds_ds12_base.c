@@ -134,6 +134,14 @@ static pmix_status_t ds12_fetch(const pmix_proc_t *proc,
     return pmix_common_dstor_fetch(ds12_ctx, proc, scope, copy, key, info, ninfo, kvs);
 }
 
+static pmix_status_t ds12_fetch_batch(const pmix_proc_t procs[],
+                                      const char *keys[], size_t nreqs,
+                                      pmix_value_t *vals[],
+                                      pmix_status_t status[])
+{
+    return pmix_common_dstor_fetch_batch(ds12_ctx, procs, keys, nreqs, vals, status);
+}
+
 static pmix_status_t ds12_setup_fork(const pmix_proc_t *peer, char ***env)
 {
     return pmix_common_dstor_setup_fork(ds12_ctx, PMIX_DSTORE_ESH_BASE_PATH, peer, env);
@@ -163,6 +171,7 @@ pmix_gds_base_module_t pmix_ds12_module = {
     .store = ds12_store,
     .store_modex = ds12_store_modex,
     .fetch = ds12_fetch,
+    .fetch_batch = ds12_fetch_batch,
     .setup_fork = ds12_setup_fork,
     .add_nspace = ds12_add_nspace,
     .del_nspace = ds12_del_nspace,
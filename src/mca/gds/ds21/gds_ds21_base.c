@@ -19,6 +19,7 @@
 #include "src/util/error.h"
 #include "src/mca/gds/base/base.h"
 #include "src/util/argv.h"
+#include "src/util/pmix_environ.h"
 
 #include "src/mca/common/dstore/dstore_common.h"
 #include "gds_ds21_base.h"
@@ -31,10 +32,21 @@ static pmix_common_dstore_ctx_t *ds21_ctx;
 static pmix_status_t ds21_init(pmix_info_t info[], size_t ninfo)
 {
     pmix_status_t rc = PMIX_SUCCESS;
+    pmix_common_lock_callbacks_t *lock_module = &pmix_ds21_lock_module;
+    pmix_common_dstore_file_cbs_t *file_module = &pmix_ds21_file_module;
 
-    ds21_ctx = pmix_common_dstor_init("ds21", info, ninfo,
-                                      &pmix_ds21_lock_module,
-                                      &pmix_ds21_file_module);
+    if (NULL != mca_gds_ds21_component.lock &&
+        0 == strcmp(mca_gds_ds21_component.lock, "seq")) {
+        lock_module = &pmix_ds21_seqlock_module;
+    }
+    if (NULL != mca_gds_ds21_component.format &&
+        0 == strcmp(mca_gds_ds21_component.format, "typed")) {
+        file_module = &pmix_ds21_typed_file_module;
+    }
+
+    ds21_ctx = pmix_common_dstor_init(file_module->name, info, ninfo,
+                                      lock_module,
+                                      file_module);
     if (NULL == ds21_ctx) {
         rc = PMIX_ERR_INIT;
     }
@@ -122,6 +134,14 @@ static pmix_status_t ds21_fetch(const pmix_proc_t *proc,
     return pmix_common_dstor_fetch(ds21_ctx, proc, scope, copy, key, info, ninfo, kvs);
 }
 
+static pmix_status_t ds21_fetch_batch(const pmix_proc_t procs[],
+                                      const char *keys[], size_t nreqs,
+                                      pmix_value_t *vals[],
+                                      pmix_status_t status[])
+{
+    return pmix_common_dstor_fetch_batch(ds21_ctx, procs, keys, nreqs, vals, status);
+}
+
 static pmix_status_t ds21_setup_fork(const pmix_proc_t *peer, char ***env)
 {
     pmix_status_t rc;
@@ -141,6 +161,23 @@ static pmix_status_t ds21_setup_fork(const pmix_proc_t *peer, char ***env)
     }
     rc = pmix_common_dstor_setup_fork(ds21_ctx, env_name, peer, env);
     free(env_name);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* clients must use the same lock layout as the server */
+    if (NULL != mca_gds_ds21_component.lock) {
+        rc = pmix_setenv("PMIX_MCA_gds_ds21_lock",
+                         mca_gds_ds21_component.lock, true, env);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    /* and the same record format */
+    if (NULL != mca_gds_ds21_component.format) {
+        rc = pmix_setenv("PMIX_MCA_gds_ds21_format",
+                         mca_gds_ds21_component.format, true, env);
+    }
 
     return rc;
 }
@@ -169,6 +206,7 @@ pmix_gds_base_module_t pmix_ds21_module = {
     .store = ds21_store,
     .store_modex = ds21_store_modex,
     .fetch = ds21_fetch,
+    .fetch_batch = ds21_fetch_batch,
     .setup_fork = ds21_setup_fork,
     .add_nspace = ds21_add_nspace,
     .del_nspace = ds21_del_nspace,
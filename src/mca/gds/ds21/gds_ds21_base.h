@@ -14,8 +14,16 @@
 
 #include "src/mca/gds/gds.h"
 
+typedef struct {
+    pmix_gds_base_component_t super;
+    /* shared memory lock type: "pthread" or "seq" */
+    char *lock;
+    /* value record format: "packed" or "typed" */
+    char *format;
+} pmix_gds_ds21_component_t;
+
 /* the component must be visible data for the linker to find it */
-PMIX_EXPORT extern pmix_gds_base_component_t mca_gds_ds21_component;
+PMIX_EXPORT extern pmix_gds_ds21_component_t mca_gds_ds21_component;
 extern pmix_gds_base_module_t pmix_ds21_module;
 
 #endif // GDS_DSTORE_21_H
@@ -35,6 +35,7 @@
 #include "src/mca/gds/gds.h"
 #include "gds_ds21_base.h"
 
+static pmix_status_t component_register(void);
 static pmix_status_t component_open(void);
 static pmix_status_t component_close(void);
 static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
@@ -43,28 +44,57 @@ static pmix_status_t component_query(pmix_mca_base_module_t **module, int *prior
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
  */
-pmix_gds_base_component_t mca_gds_ds21_component = {
-    .base = {
-        PMIX_GDS_BASE_VERSION_1_0_0,
-
-        /* Component name and version */
-        .pmix_mca_component_name = "ds21",
-        PMIX_MCA_BASE_MAKE_VERSION(component,
-                                   PMIX_MAJOR_VERSION,
-                                   PMIX_MINOR_VERSION,
-                                   PMIX_RELEASE_VERSION),
-
-        /* Component open and close functions */
-        .pmix_mca_open_component = component_open,
-        .pmix_mca_close_component = component_close,
-        .pmix_mca_query_component = component_query,
+pmix_gds_ds21_component_t mca_gds_ds21_component = {
+    .super = {
+        .base = {
+            PMIX_GDS_BASE_VERSION_1_0_0,
+
+            /* Component name and version */
+            .pmix_mca_component_name = "ds21",
+            PMIX_MCA_BASE_MAKE_VERSION(component,
+                                       PMIX_MAJOR_VERSION,
+                                       PMIX_MINOR_VERSION,
+                                       PMIX_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .pmix_mca_open_component = component_open,
+            .pmix_mca_close_component = component_close,
+            .pmix_mca_query_component = component_query,
+            .pmix_mca_register_component_params = component_register,
+        },
+        .data = {
+            /* The component is checkpoint ready */
+            PMIX_MCA_BASE_METADATA_PARAM_CHECKPOINT
+        }
     },
-    .data = {
-        /* The component is checkpoint ready */
-        PMIX_MCA_BASE_METADATA_PARAM_CHECKPOINT
-    }
+    .lock = "pthread",
+    .format = "packed"
 };
 
+static int component_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_gds_ds21_component.super.base;
+
+    (void)pmix_mca_base_component_var_register(component, "lock",
+                                               "Lock protecting the shared memory store: \"pthread\" (default) "
+                                               "for process-shared rwlocks, or \"seq\" for a sequence lock "
+                                               "that lets readers proceed without writing to shared memory",
+                                               PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_gds_ds21_component.lock);
+
+    (void)pmix_mca_base_component_var_register(component, "format",
+                                               "Format of the values in the shared memory store: "
+                                               "\"packed\" (default) for packed PMIx values, or \"typed\" "
+                                               "for aligned native values that are read without unpacking",
+                                               PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_gds_ds21_component.format);
+    return PMIX_SUCCESS;
+}
+
 
 static int component_open(void)
 {
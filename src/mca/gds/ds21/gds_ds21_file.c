@@ -14,6 +14,7 @@
 
 #include "src/include/pmix_globals.h"
 #include "src/mca/gds/base/base.h"
+#include "src/mca/bfrops/base/base.h"
 
 #include "src/mca/common/dstore/dstore_file.h"
 #include "gds_ds21_file.h"
@@ -186,3 +187,284 @@ pmix_common_dstore_file_cbs_t pmix_ds21_file_module = {
     .key_hash = pmix_ds21_key_hash,
     .key_match = pmix_ds21_kname_match
 };
+
+/*
+ * Typed record format: the same layout as above, but the key name
+ * and the value are padded to ESH_VAL_ALIGN so that every value starts
+ * at an aligned address. The value is stored as:
+ * 1. Value type        sizeof(pmix_data_type_t), padded to ESH_VAL_ALIGN
+ * 2. For strings and byte objects - data length, sizeof(size_t)
+ * 3. Value data in the native format
+ * Types without a native encoding are stored with the PMIX_UNDEF type
+ * followed by the bfrops-packed PMIX_VALUE.
+ */
+#define ESH_VAL_ALIGN               8
+#define ESH_VAL_ALIGNED(sz)                                 \
+    (((sz) + ESH_VAL_ALIGN - 1) & ~((size_t)ESH_VAL_ALIGN - 1))
+#define ESH_VAL_HDR_SIZE            ESH_VAL_ALIGN
+
+#define ESH_KNAME_LEN_V21T(key)                             \
+    ESH_VAL_ALIGNED(strlen(key) + 1)
+
+#define ESH_DATA_PTR_V21T(addr)                             \
+__pmix_attribute_extension__ ({                             \
+    char *key_ptr = ESH_KNAME_PTR_V21(addr);                \
+    size_t kname_len = ESH_KNAME_LEN_V21T(key_ptr);         \
+    uint8_t *data_ptr =                                     \
+        addr + (key_ptr - (char*)addr) + kname_len;         \
+    data_ptr;                                               \
+})
+
+#define ESH_KEY_SIZE_V21T(key, size)                        \
+    (2 * sizeof(size_t) + ESH_KNAME_LEN_V21T((char*)key) +  \
+     ESH_VAL_ALIGNED(size))
+
+#define EXT_SLOT_SIZE_V21T()                                \
+    (ESH_KEY_SIZE_V21T("", sizeof(size_t)))
+
+static size_t pmix_ds21t_key_name_len(char *key)
+{
+    return ESH_KNAME_LEN_V21T(key);
+}
+
+static uint8_t* pmix_ds21t_data_ptr(uint8_t *addr)
+{
+    return ESH_DATA_PTR_V21T(addr);
+}
+
+static size_t pmix_ds21t_data_size(uint8_t *addr, uint8_t* data_ptr)
+{
+    return ESH_DATA_SIZE_V21(addr, data_ptr);
+}
+
+static size_t pmix_ds21t_key_size(char *addr, size_t data_size)
+{
+    return ESH_KEY_SIZE_V21T(addr, data_size);
+}
+
+static size_t pmix_ds21t_ext_slot_size(void)
+{
+    return EXT_SLOT_SIZE_V21T();
+}
+
+static int pmix_ds21t_put_key(uint8_t *addr, char *key,
+                              void* buffer, size_t size)
+{
+    size_t flag = 0;
+    size_t hash = 0;
+    char *addr_ch = (char*)addr;
+    if( !strcmp(key, ESH_REGION_EXTENSION) ) {
+        /* we have a flag for this special key */
+        key = "";
+        flag |= ESH_REGION_EXTENSION_FLG;
+    }
+    size_t sz = ESH_KEY_SIZE_V21T(key, size);
+    if( ESH_REGION_SIZE_MASK < sz ) {
+        return PMIX_ERROR;
+    }
+    sz |= flag;
+    memcpy(addr_ch, &sz, sizeof(size_t));
+    hash = pmix_ds21_key_hash(key);
+    memcpy(addr_ch + sizeof(size_t), &hash, sizeof(size_t));
+    /* strncpy zero-fills the key name padding */
+    strncpy(addr_ch + 2 * sizeof(size_t), key, ESH_KNAME_LEN_V21T(key));
+    memcpy(ESH_DATA_PTR_V21T(addr), buffer, size);
+    return PMIX_SUCCESS;
+}
+
+/* size of the natively stored scalar types, 0 if the type
+ * has no native encoding */
+static size_t _native_size(pmix_data_type_t type)
+{
+    switch (type) {
+    case PMIX_BOOL:
+        return sizeof(bool);
+    case PMIX_BYTE:
+    case PMIX_INT8:
+    case PMIX_UINT8:
+        return 1;
+    case PMIX_INT16:
+    case PMIX_UINT16:
+        return 2;
+    case PMIX_INT32:
+    case PMIX_UINT32:
+        return 4;
+    case PMIX_INT64:
+    case PMIX_UINT64:
+        return 8;
+    case PMIX_INT:
+    case PMIX_UINT:
+        return sizeof(int);
+    case PMIX_SIZE:
+        return sizeof(size_t);
+    case PMIX_PID:
+        return sizeof(pid_t);
+    case PMIX_FLOAT:
+        return sizeof(float);
+    case PMIX_DOUBLE:
+        return sizeof(double);
+    case PMIX_STATUS:
+        return sizeof(pmix_status_t);
+    case PMIX_PROC_RANK:
+        return sizeof(pmix_rank_t);
+    default:
+        return 0;
+    }
+}
+
+static pmix_status_t pmix_ds21t_value_pack(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                           pmix_value_t *val)
+{
+    pmix_data_type_t type = val->type;
+    size_t size, len = 0, pad;
+    uint8_t *ptr;
+    const void *data = &val->data;
+    pmix_status_t rc;
+
+    switch (type) {
+    case PMIX_STRING:
+        len = (NULL == val->data.string) ? 0 : strlen(val->data.string) + 1;
+        data = val->data.string;
+        size = sizeof(size_t) + len;
+        break;
+    case PMIX_BYTE_OBJECT:
+        len = val->data.bo.size;
+        data = val->data.bo.bytes;
+        size = sizeof(size_t) + len;
+        break;
+    default:
+        if (0 == (size = _native_size(type))) {
+            type = PMIX_UNDEF;
+        }
+        break;
+    }
+
+    ptr = (uint8_t*)pmix_bfrop_buffer_extend(buf, ESH_VAL_HDR_SIZE + size);
+    if (NULL == ptr) {
+        return PMIX_ERR_NOMEM;
+    }
+    memset(ptr, 0, ESH_VAL_HDR_SIZE);
+    memcpy(ptr, &type, sizeof(pmix_data_type_t));
+    ptr += ESH_VAL_HDR_SIZE;
+    if (PMIX_STRING == type || PMIX_BYTE_OBJECT == type) {
+        memcpy(ptr, &len, sizeof(size_t));
+        if (0 < len) {
+            memcpy(ptr + sizeof(size_t), data, len);
+        }
+    } else if (PMIX_UNDEF != type) {
+        memcpy(ptr, data, size);
+    }
+    buf->pack_ptr += ESH_VAL_HDR_SIZE + size;
+    buf->bytes_used += ESH_VAL_HDR_SIZE + size;
+
+    if (PMIX_UNDEF == type) {
+        /* no native encoding for this type - keep it packed */
+        PMIX_BFROPS_PACK(rc, peer, buf, val, 1, PMIX_VALUE);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    /* keep the next record aligned */
+    pad = ESH_VAL_ALIGNED(buf->bytes_used) - buf->bytes_used;
+    if (0 < pad) {
+        ptr = (uint8_t*)pmix_bfrop_buffer_extend(buf, pad);
+        if (NULL == ptr) {
+            return PMIX_ERR_NOMEM;
+        }
+        memset(ptr, 0, pad);
+        buf->pack_ptr += pad;
+        buf->bytes_used += pad;
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t pmix_ds21t_value_unpack(pmix_peer_t *peer, uint8_t *data,
+                                             size_t size, pmix_value_t *val)
+{
+    pmix_data_type_t type;
+    pmix_buffer_t buffer;
+    pmix_status_t rc;
+    uint8_t *copy;
+    size_t len;
+    int cnt = 1;
+
+    if (ESH_VAL_HDR_SIZE > size) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    memcpy(&type, data, sizeof(pmix_data_type_t));
+    data += ESH_VAL_HDR_SIZE;
+    size -= ESH_VAL_HDR_SIZE;
+
+    switch (type) {
+    case PMIX_UNDEF:
+        PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(peer, &buffer, data, size);
+        PMIX_BFROPS_UNPACK(rc, peer, &buffer, val, &cnt, PMIX_VALUE);
+        buffer.base_ptr = NULL;
+        buffer.bytes_used = 0;
+        PMIX_DESTRUCT(&buffer);
+        return rc;
+    case PMIX_STRING:
+    case PMIX_BYTE_OBJECT:
+        if (sizeof(size_t) > size) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        memcpy(&len, data, sizeof(size_t));
+        data += sizeof(size_t);
+        if (len > size - sizeof(size_t)) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        val->type = type;
+        if (0 == len) {
+            if (PMIX_STRING == type) {
+                val->data.string = NULL;
+            } else {
+                val->data.bo.bytes = NULL;
+                val->data.bo.size = 0;
+            }
+            return PMIX_SUCCESS;
+        }
+        copy = (uint8_t*)malloc(len);
+        if (NULL == copy) {
+            return PMIX_ERR_NOMEM;
+        }
+        memcpy(copy, data, len);
+        if (PMIX_STRING == type) {
+            val->data.string = (char*)copy;
+        } else {
+            val->data.bo.bytes = (char*)copy;
+            val->data.bo.size = len;
+        }
+        return PMIX_SUCCESS;
+    default:
+        len = _native_size(type);
+        if (0 == len || len > size) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        val->type = type;
+        memcpy(&val->data, data, len);
+        return PMIX_SUCCESS;
+    }
+}
+
+pmix_common_dstore_file_cbs_t pmix_ds21_typed_file_module = {
+    /* the record format version is the dstore version,
+     * peers not knowing it won't find the store */
+    .name = "ds22",
+    .kval_size = pmix_ds21_kval_size,
+    .kname_ptr = pmix_ds21_key_name_ptr,
+    .kname_len = pmix_ds21t_key_name_len,
+    .data_ptr = pmix_ds21t_data_ptr,
+    .data_size = pmix_ds21t_data_size,
+    .key_size = pmix_ds21t_key_size,
+    .ext_slot_size = pmix_ds21t_ext_slot_size,
+    .put_key = pmix_ds21t_put_key,
+    .is_invalid = pmix_ds21_is_invalid,
+    .is_extslot = pmix_ds21_is_ext_slot,
+    .set_invalid = pmix_ds21_set_invalid,
+    .key_hash = pmix_ds21_key_hash,
+    .key_match = pmix_ds21_kname_match,
+    .value_pack = pmix_ds21t_value_pack,
+    .value_unpack = pmix_ds21t_value_unpack
+};
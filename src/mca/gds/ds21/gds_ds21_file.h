@@ -15,5 +15,6 @@
 #include <pmix_common.h>
 
 extern pmix_common_dstore_file_cbs_t pmix_ds21_file_module;
+extern pmix_common_dstore_file_cbs_t pmix_ds21_typed_file_module;
 
 #endif // GDS_DS21_FILE_H
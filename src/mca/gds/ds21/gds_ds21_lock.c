@@ -23,3 +23,14 @@ pmix_common_lock_callbacks_t pmix_ds21_lock_module = {
     .wr_lock = pmix_ds21_lock_wr_get,
     .wr_unlock = pmix_ds21_lock_wr_rel
 };
+
+pmix_common_lock_callbacks_t pmix_ds21_seqlock_module = {
+    .init = pmix_gds_ds21_seqlock_init,
+    .finalize = pmix_ds21_seqlock_finalize,
+    .rd_lock = pmix_ds21_seqlock_rd_get,
+    .rd_unlock = pmix_ds21_seqlock_rd_rel,
+    .wr_lock = pmix_ds21_seqlock_wr_get,
+    .wr_unlock = pmix_ds21_seqlock_wr_rel,
+    .rd_begin = pmix_ds21_seqlock_rd_begin,
+    .rd_end = pmix_ds21_seqlock_rd_end
+};
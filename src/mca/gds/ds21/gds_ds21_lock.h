@@ -25,6 +25,20 @@ pmix_status_t pmix_ds21_lock_wr_get(pmix_common_dstor_lock_ctx_t lock_ctx);
 pmix_status_t pmix_ds21_lock_rd_rel(pmix_common_dstor_lock_ctx_t lock_ctx);
 pmix_status_t pmix_ds21_lock_wr_rel(pmix_common_dstor_lock_ctx_t lock_ctx);
 
+pmix_status_t pmix_gds_ds21_seqlock_init(pmix_common_dstor_lock_ctx_t *lock_ctx,
+                                         const char *base_path,  const char *name,
+                                         uint32_t local_size, uid_t uid, bool setuid);
+void pmix_ds21_seqlock_finalize(pmix_common_dstor_lock_ctx_t *lock_ctx);
+pmix_status_t pmix_ds21_seqlock_rd_get(pmix_common_dstor_lock_ctx_t lock_ctx);
+pmix_status_t pmix_ds21_seqlock_wr_get(pmix_common_dstor_lock_ctx_t lock_ctx);
+pmix_status_t pmix_ds21_seqlock_rd_rel(pmix_common_dstor_lock_ctx_t lock_ctx);
+pmix_status_t pmix_ds21_seqlock_wr_rel(pmix_common_dstor_lock_ctx_t lock_ctx);
+pmix_status_t pmix_ds21_seqlock_rd_begin(pmix_common_dstor_lock_ctx_t lock_ctx,
+                                         pmix_common_dstor_rd_state_t *state);
+pmix_status_t pmix_ds21_seqlock_rd_end(pmix_common_dstor_lock_ctx_t lock_ctx,
+                                       pmix_common_dstor_rd_state_t *state);
+
 extern pmix_common_lock_callbacks_t pmix_ds21_lock_module;
+extern pmix_common_lock_callbacks_t pmix_ds21_seqlock_module;
 
 #endif // DS21_LOCK_H
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2018      Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ *
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_common.h>
+
+#include <stdio.h>
+#include <pthread.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#include "src/atomics/sys/atomic.h"
+#include "src/mca/common/dstore/dstore_common.h"
+#include "src/mca/gds/base/base.h"
+#include "src/mca/pshmem/pshmem.h"
+#include "src/class/pmix_list.h"
+#include "src/threads/thread_usage.h"
+
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include "gds_ds21_lock.h"
+#include "src/mca/common/dstore/dstore_segment.h"
+
+/*
+ * Sequence lock: the server is the only writer of the store and
+ * makes the sequence counter odd for the duration of an update.
+ * Optimistic readers don't write to the lock segment: they wait for
+ * an even counter, read the store and compare the counter once done.
+ * If it has changed, the data may be torn and the read must be
+ * repeated - rd_end reports this with PMIX_ERR_RESOURCE_BUSY.
+ *
+ * The writer also holds a process shared rwlock for the duration of
+ * the update. A reader that doesn't see an even counter within a
+ * bounded spin, or had to repeat its read too many times, takes the
+ * read side of that lock instead. rd_lock/rd_unlock always use it.
+ *
+ * Lock segment format:
+ * 1. Segment size             sizeof(size_t)
+ * 2. Sequence counter         sizeof(int32_t)
+ * 3. Read-write lock          sizeof(pthread_rwlock_t)
+ */
+typedef struct {
+    size_t seg_size;
+    pmix_atomic_int32_t seq;
+    pthread_rwlock_t rwlock;
+} segment_hdr_t;
+
+/* number of sequence reads before a reader falls back to the rwlock */
+#define _SEQLOCK_SPIN_MAX       1024
+/* number of repeated optimistic reads before the same */
+#define _SEQLOCK_RETRY_MAX      4
+
+typedef struct {
+    pmix_list_item_t super;
+
+    char *lockfile;
+    pmix_dstore_seg_desc_t *seg_desc;
+} seqlock_item_t;
+
+typedef struct {
+    pmix_list_t lock_traker;
+} seqlock_ctx_t;
+
+static void ncon(seqlock_item_t *p) {
+    p->lockfile = NULL;
+    p->seg_desc = NULL;
+}
+
+static void ldes(seqlock_item_t *p) {
+    if(PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        if (p->seg_desc) {
+            segment_hdr_t *seg_hdr = (segment_hdr_t *)p->seg_desc->seg_info.seg_base_addr;
+            pthread_rwlock_destroy(&seg_hdr->rwlock);
+        }
+        if (p->lockfile) {
+            unlink(p->lockfile);
+        }
+    }
+    if (p->lockfile) {
+        free(p->lockfile);
+    }
+    if (p->seg_desc) {
+        pmix_common_dstor_delete_sm_desc(p->seg_desc);
+    }
+}
+
+PMIX_CLASS_INSTANCE(seqlock_item_t,
+                    pmix_list_item_t,
+                    ncon, ldes);
+
+pmix_status_t pmix_gds_ds21_seqlock_init(pmix_common_dstor_lock_ctx_t *ctx, const char *base_path,
+                                         const char * name, uint32_t local_size,
+                                         uid_t uid, bool setuid)
+{
+    size_t size = pmix_common_dstor_getpagesize();
+    segment_hdr_t *seg_hdr;
+    seqlock_item_t *lock_item = NULL;
+    seqlock_ctx_t *lock_ctx = (seqlock_ctx_t*)*ctx;
+    pmix_list_t *lock_tracker;
+    pthread_rwlockattr_t attr;
+    char *lock_name = NULL;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (NULL == *ctx) {
+        lock_ctx = (seqlock_ctx_t*)malloc(sizeof(seqlock_ctx_t));
+        if (NULL == lock_ctx) {
+            rc = PMIX_ERR_INIT;
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+        memset(lock_ctx, 0, sizeof(seqlock_ctx_t));
+        PMIX_CONSTRUCT(&lock_ctx->lock_traker, pmix_list_t);
+        *ctx = lock_ctx;
+    }
+
+    lock_tracker = &lock_ctx->lock_traker;
+    lock_item = PMIX_NEW(seqlock_item_t);
+
+    if (NULL == lock_item) {
+        rc = PMIX_ERR_INIT;
+        PMIX_ERROR_LOG(rc);
+        goto error;
+    }
+    pmix_list_append(lock_tracker, &lock_item->super);
+
+    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+        "%s:%d:%s local_size %d", __FILE__, __LINE__, __func__, local_size));
+
+    /* use a distinct segment name so that a peer configured
+     * for the pthread lock fails to attach instead of
+     * misinterpreting the segment */
+    if (0 > asprintf(&lock_name, "seq-%s", name)) {
+        rc = PMIX_ERR_NOMEM;
+        PMIX_ERROR_LOG(rc);
+        goto error;
+    }
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        lock_item->seg_desc = pmix_common_dstor_create_new_lock_seg(base_path,
+                                    size, lock_name, 0, uid, setuid);
+        if (NULL == lock_item->seg_desc) {
+            rc = PMIX_ERR_OUT_OF_RESOURCE;
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+        seg_hdr = (segment_hdr_t*)lock_item->seg_desc->seg_info.seg_base_addr;
+        seg_hdr->seg_size = size;
+        seg_hdr->seq = 0;
+        if (0 != pthread_rwlockattr_init(&attr)) {
+            rc = PMIX_ERR_INIT;
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+        if (0 != pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED)) {
+            pthread_rwlockattr_destroy(&attr);
+            rc = PMIX_ERR_INIT;
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+#ifdef HAVE_PTHREAD_SETKIND
+        if (0 != pthread_rwlockattr_setkind_np(&attr,
+                                PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP)) {
+            pthread_rwlockattr_destroy(&attr);
+            rc = PMIX_ERR_INIT;
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+#endif
+        if (0 != pthread_rwlock_init(&seg_hdr->rwlock, &attr)) {
+            pthread_rwlockattr_destroy(&attr);
+            rc = PMIX_ERR_INIT;
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+        pthread_rwlockattr_destroy(&attr);
+        pmix_atomic_wmb();
+    } else {
+        lock_item->seg_desc = pmix_common_dstor_attach_new_lock_seg(base_path, size, lock_name, 0);
+        if (NULL == lock_item->seg_desc) {
+            rc = PMIX_ERR_NOT_FOUND;
+            goto error;
+        }
+    }
+    lock_item->lockfile = strdup(lock_item->seg_desc->seg_info.seg_name);
+    free(lock_name);
+
+    return rc;
+
+error:
+    if (NULL != lock_name) {
+        free(lock_name);
+    }
+    if (NULL != lock_item) {
+        pmix_list_remove_item(lock_tracker, &lock_item->super);
+        PMIX_RELEASE(lock_item);
+        lock_item = NULL;
+    }
+    *ctx = NULL;
+
+    return rc;
+}
+
+void pmix_ds21_seqlock_finalize(pmix_common_dstor_lock_ctx_t *lock_ctx)
+{
+    seqlock_item_t *lock_item, *item_next;
+    pmix_list_t *lock_tracker = &((seqlock_ctx_t*)*lock_ctx)->lock_traker;
+
+    if (NULL == lock_tracker) {
+        return;
+    }
+
+    PMIX_LIST_FOREACH_SAFE(lock_item, item_next, lock_tracker, seqlock_item_t) {
+        pmix_list_remove_item(lock_tracker, &lock_item->super);
+        PMIX_RELEASE(lock_item);
+    }
+    if (pmix_list_is_empty(lock_tracker)) {
+        PMIX_LIST_DESTRUCT(lock_tracker);
+        free(lock_tracker);
+        lock_tracker = NULL;
+    }
+    *lock_ctx = NULL;
+}
+
+pmix_status_t pmix_ds21_seqlock_wr_get(pmix_common_dstor_lock_ctx_t lock_ctx)
+{
+    seqlock_item_t *lock_item;
+    pmix_list_t *lock_tracker = &((seqlock_ctx_t*)lock_ctx)->lock_traker;
+    segment_hdr_t *seg_hdr;
+
+    if (NULL == lock_tracker) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    PMIX_LIST_FOREACH(lock_item, lock_tracker, seqlock_item_t) {
+        seg_hdr = (segment_hdr_t *)lock_item->seg_desc->seg_info.seg_base_addr;
+        if (0 != pthread_rwlock_wrlock(&seg_hdr->rwlock)) {
+            PMIX_ERROR_LOG(PMIX_ERR_NO_PERMISSIONS);
+            return PMIX_ERR_NO_PERMISSIONS;
+        }
+        /* odd sequence tells readers that an update is in progress,
+         * it must be visible before any of the data modifications */
+        (void)pmix_atomic_add_fetch_32(&seg_hdr->seq, 1);
+        pmix_atomic_wmb();
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_ds21_seqlock_wr_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
+{
+    seqlock_item_t *lock_item;
+    pmix_list_t *lock_tracker = &((seqlock_ctx_t*)lock_ctx)->lock_traker;
+    segment_hdr_t *seg_hdr;
+
+    if (NULL == lock_tracker) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    PMIX_LIST_FOREACH(lock_item, lock_tracker, seqlock_item_t) {
+        seg_hdr = (segment_hdr_t *)lock_item->seg_desc->seg_info.seg_base_addr;
+        /* publish the data before the sequence gets even again */
+        pmix_atomic_wmb();
+        (void)pmix_atomic_add_fetch_32(&seg_hdr->seq, 1);
+        if (0 != pthread_rwlock_unlock(&seg_hdr->rwlock)) {
+            PMIX_ERROR_LOG(PMIX_ERR_NO_PERMISSIONS);
+            return PMIX_ERR_NO_PERMISSIONS;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static segment_hdr_t *_rd_hdr(pmix_common_dstor_lock_ctx_t lock_ctx)
+{
+    seqlock_item_t *lock_item;
+    pmix_list_t *lock_tracker = &((seqlock_ctx_t*)lock_ctx)->lock_traker;
+
+    if (NULL == lock_ctx || pmix_list_is_empty(lock_tracker)) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+        return NULL;
+    }
+    /* the writer takes all of the locks, readers use the first one */
+    lock_item = (seqlock_item_t*)pmix_list_get_first(lock_tracker);
+    return (segment_hdr_t *)lock_item->seg_desc->seg_info.seg_base_addr;
+}
+
+pmix_status_t pmix_ds21_seqlock_rd_get(pmix_common_dstor_lock_ctx_t lock_ctx)
+{
+    segment_hdr_t *seg_hdr = _rd_hdr(lock_ctx);
+
+    if (NULL == seg_hdr) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (0 != pthread_rwlock_rdlock(&seg_hdr->rwlock)) {
+        PMIX_ERROR_LOG(PMIX_ERR_NO_PERMISSIONS);
+        return PMIX_ERR_NO_PERMISSIONS;
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_ds21_seqlock_rd_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
+{
+    segment_hdr_t *seg_hdr = _rd_hdr(lock_ctx);
+
+    if (NULL == seg_hdr) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (0 != pthread_rwlock_unlock(&seg_hdr->rwlock)) {
+        PMIX_ERROR_LOG(PMIX_ERR_NO_PERMISSIONS);
+        return PMIX_ERR_NO_PERMISSIONS;
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_ds21_seqlock_rd_begin(pmix_common_dstor_lock_ctx_t lock_ctx,
+                                         pmix_common_dstor_rd_state_t *state)
+{
+    segment_hdr_t *seg_hdr = _rd_hdr(lock_ctx);
+    int32_t seq;
+    int spin;
+
+    if (NULL == seg_hdr) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    if (_SEQLOCK_RETRY_MAX > state->retries) {
+        /* the server holds the write side for a short time only,
+         * wait a bit until it is done */
+        for (spin = 0; spin < _SEQLOCK_SPIN_MAX; spin++) {
+            seq = seg_hdr->seq;
+            pmix_atomic_rmb();
+            if (!(seq & 1)) {
+                state->seq = seq;
+                state->locked = false;
+                return PMIX_SUCCESS;
+            }
+        }
+    }
+
+    /* the store is busy - don't spin on it, block on the rwlock
+     * that the writer holds for the duration of the update */
+    if (0 != pthread_rwlock_rdlock(&seg_hdr->rwlock)) {
+        PMIX_ERROR_LOG(PMIX_ERR_NO_PERMISSIONS);
+        return PMIX_ERR_NO_PERMISSIONS;
+    }
+    state->locked = true;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_ds21_seqlock_rd_end(pmix_common_dstor_lock_ctx_t lock_ctx,
+                                       pmix_common_dstor_rd_state_t *state)
+{
+    segment_hdr_t *seg_hdr = _rd_hdr(lock_ctx);
+
+    if (NULL == seg_hdr) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    if (state->locked) {
+        state->locked = false;
+        if (0 != pthread_rwlock_unlock(&seg_hdr->rwlock)) {
+            PMIX_ERROR_LOG(PMIX_ERR_NO_PERMISSIONS);
+            return PMIX_ERR_NO_PERMISSIONS;
+        }
+        return PMIX_SUCCESS;
+    }
+
+    /* make sure all the data reads are done before the check */
+    pmix_atomic_rmb();
+    if (seg_hdr->seq != state->seq) {
+        state->retries++;
+        return PMIX_ERR_RESOURCE_BUSY;
+    }
+
+    return PMIX_SUCCESS;
+}
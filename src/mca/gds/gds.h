@@ -94,6 +94,31 @@ typedef pmix_status_t (*pmix_gds_base_module_assemb_kvs_req_fn_t)(const pmix_pro
         }                                                               \
     } while(0)
 
+/* SERVER FN: assemble all the data of a proc for a server answer,
+ * the same as a NULL-key fetch followed by assemb_kvs_req. The
+ * module may answer from a packed snapshot of the data that it
+ * keeps until the data of the proc changes. With a NULL cbdata,
+ * only the kvals are packed, for this process. Returns
+ * PMIX_ERR_TAKE_NEXT_OPTION if the caller has to fetch and
+ * assemble the data itself */
+typedef pmix_status_t (*pmix_gds_base_module_assemb_kvs_snapshot_fn_t)(const pmix_proc_t *proc,
+                                                                 pmix_scope_t scope,
+                                                                 pmix_buffer_t *buf,
+                                                                 void *cbdata);
+
+/* define a macro for assembling a server answer from a snapshot */
+#define PMIX_GDS_ASSEMB_KVS_SNAPSHOT(s, p, r, sc, b, c)                 \
+    do {                                                                \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds;             \
+        (s) = PMIX_ERR_TAKE_NEXT_OPTION;                                \
+        if (NULL != _g->assemb_kvs_snapshot) {                          \
+            pmix_output_verbose(1, pmix_gds_base_output,                \
+                                "[%s:%d] GDS ASSEMBLE SNAPSHOT WITH %s", \
+                                __FILE__, __LINE__, _g->name);          \
+            (s) = _g->assemb_kvs_snapshot(r, sc, b, (void*)c);          \
+        }                                                               \
+    } while(0)
+
 
 /* CLIENT FN: unpack buffer and key processing */
 typedef pmix_status_t (*pmix_gds_base_module_accept_kvs_resp_fn_t)(pmix_buffer_t *buf);
@@ -310,6 +335,45 @@ typedef pmix_status_t (*pmix_gds_base_module_fetch_fn_t)(const pmix_proc_t *proc
                                                          pmix_info_t info[], size_t ninfo,
                                                          pmix_list_t *kvs);
 
+/**
+* fetch the values of several (proc, key) pairs in a single pass. This
+* is an optional operation - modules that cannot do better than calling
+* fetch for each pair shall leave it NULL.
+*
+* @param procs   array of namespace/rank pairs whose info is being requested.
+*                Wildcard rank is allowed, undefined rank is not.
+*
+* @param keys    array of keys, one per proc. NULL keys are not allowed.
+*
+* @param nreqs   number of elements in the procs and keys arrays
+*
+* @param vals    array of nreqs pointers to be set to the returned values.
+*                The caller is responsible for releasing them
+*
+* @param status  array of nreqs status values for each request
+*
+* @return       PMIX_SUCCESS if the batch was processed, the results of
+*               each request are provided in the status array.
+*/
+typedef pmix_status_t (*pmix_gds_base_module_fetch_batch_fn_t)(const pmix_proc_t procs[],
+                                                               const char *keys[], size_t nreqs,
+                                                               pmix_value_t *vals[],
+                                                               pmix_status_t status[]);
+
+/* define a convenience macro for batch fetch based on peer */
+#define PMIX_GDS_FETCH_BATCH(s, p, r, k, n, v, st)                  \
+    do {                                                            \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds;         \
+        pmix_output_verbose(1, pmix_gds_base_output,                \
+                            "[%s:%d] GDS FETCH BATCH WITH %s",      \
+                            __FILE__, __LINE__, _g->name);          \
+        if (NULL != _g->fetch_batch) {                              \
+            (s) = _g->fetch_batch(r, k, n, v, st);                  \
+        } else {                                                    \
+            (s) = PMIX_ERR_NOT_SUPPORTED;                           \
+        }                                                           \
+    } while(0)
+
 /* define a convenience macro for fetch key-val pairs based on peer,
  * passing a pmix_cb_t containing all the required info */
 #define PMIX_GDS_FETCH_KV(s, p, c)      \
@@ -428,7 +492,9 @@ typedef struct {
     pmix_gds_base_module_add_nspace_fn_t            add_nspace;
     pmix_gds_base_module_del_nspace_fn_t            del_nspace;
     pmix_gds_base_module_assemb_kvs_req_fn_t        assemb_kvs_req;
+    pmix_gds_base_module_assemb_kvs_snapshot_fn_t   assemb_kvs_snapshot;
     pmix_gds_base_module_accept_kvs_resp_fn_t       accept_kvs_resp;
+    pmix_gds_base_module_fetch_batch_fn_t           fetch_batch;
 
 } pmix_gds_base_module_t;
 
@@ -16,6 +16,7 @@
 #include <src/include/pmix_config.h>
 
 #include <string.h>
+#include <limits.h>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -37,15 +38,20 @@
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/util/argv.h"
+#include "src/mca/bfrops/base/base.h"
 #include "src/mca/pcompress/base/base.h"
 #include "src/util/error.h"
 #include "src/util/hash.h"
+#include "src/util/nspace_registry.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/mca/preg/preg.h"
 
 #include "src/mca/gds/base/base.h"
 #include "gds_hash.h"
+#include "gds_hash_arena.h"
+#include "gds_hash_jobmap.h"
+#include "gds_hash_snapshot.h"
 
 static pmix_status_t hash_init(pmix_info_t info[], size_t ninfo);
 static void hash_finalize(void);
@@ -95,6 +101,11 @@ static pmix_status_t assemb_kvs_req(const pmix_proc_t *proc,
                               pmix_buffer_t *bo,
                               void *cbdata);
 
+static pmix_status_t assemb_kvs_snapshot(const pmix_proc_t *proc,
+                                         pmix_scope_t scope,
+                                         pmix_buffer_t *buf,
+                                         void *cbdata);
+
 static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf);
 
 pmix_gds_base_module_t pmix_hash_module = {
@@ -113,22 +124,34 @@ pmix_gds_base_module_t pmix_hash_module = {
     .add_nspace = nspace_add,
     .del_nspace = nspace_del,
     .assemb_kvs_req = assemb_kvs_req,
+    .assemb_kvs_snapshot = assemb_kvs_snapshot,
     .accept_kvs_resp = accept_kvs_resp
 };
 
 typedef struct {
     pmix_list_item_t super;
     char *ns;
+    uint32_t nsid;
     pmix_namespace_t *nptr;
     pmix_hash_table_t internal;
     pmix_hash_table_t remote;
     pmix_hash_table_t local;
+    /* standard per-proc job data, kept out of the internal table */
+    pmix_gds_hash_jobmap_t jobmap;
+    /* node and proc map regex, expanded on first use */
+    char *nodemap;
+    char *procmap;
+    /* keys and values of the job and modex data */
+    pmix_gds_hash_arena_t *arena;
+    /* packed data of the ranks that were asked for */
+    pmix_gds_hash_snapshots_t snapshots;
     bool gdata_added;
 } pmix_hash_trkr_t;
 
 static void htcon(pmix_hash_trkr_t *p)
 {
     p->ns = NULL;
+    p->nsid = PMIX_NSPACE_INVALID_ID;
     p->nptr = NULL;
     PMIX_CONSTRUCT(&p->internal, pmix_hash_table_t);
     pmix_hash_table_init(&p->internal, 256);
@@ -136,6 +159,11 @@ static void htcon(pmix_hash_trkr_t *p)
     pmix_hash_table_init(&p->remote, 256);
     PMIX_CONSTRUCT(&p->local, pmix_hash_table_t);
     pmix_hash_table_init(&p->local, 256);
+    PMIX_CONSTRUCT(&p->jobmap, pmix_gds_hash_jobmap_t);
+    p->nodemap = NULL;
+    p->procmap = NULL;
+    p->arena = PMIX_NEW(pmix_gds_hash_arena_t);
+    PMIX_CONSTRUCT(&p->snapshots, pmix_gds_hash_snapshots_t);
     p->gdata_added = false;
 }
 static void htdes(pmix_hash_trkr_t *p)
@@ -143,21 +171,38 @@ static void htdes(pmix_hash_trkr_t *p)
     if (NULL != p->ns) {
         free(p->ns);
     }
+    if (PMIX_NSPACE_INVALID_ID != p->nsid) {
+        pmix_nspace_registry_release(p->nsid);
+    }
     if (NULL != p->nptr) {
         PMIX_RELEASE(p->nptr);
     }
+    if (NULL != p->nodemap) {
+        free(p->nodemap);
+    }
+    if (NULL != p->procmap) {
+        free(p->procmap);
+    }
     pmix_hash_remove_data(&p->internal, PMIX_RANK_WILDCARD, NULL);
     PMIX_DESTRUCT(&p->internal);
     pmix_hash_remove_data(&p->remote, PMIX_RANK_WILDCARD, NULL);
     PMIX_DESTRUCT(&p->remote);
     pmix_hash_remove_data(&p->local, PMIX_RANK_WILDCARD, NULL);
     PMIX_DESTRUCT(&p->local);
+    PMIX_DESTRUCT(&p->jobmap);
+    PMIX_DESTRUCT(&p->snapshots);
+    /* anyone still holding data of the nspace keeps the arena */
+    if (NULL != p->arena) {
+        PMIX_RELEASE(p->arena);
+    }
 }
 static PMIX_CLASS_INSTANCE(pmix_hash_trkr_t,
                            pmix_list_item_t,
                            htcon, htdes);
 
 static pmix_list_t myhashes;
+/* trackers on the myhashes list, indexed by nspace registry id */
+static pmix_pointer_array_t myhashes_idx;
 
 static pmix_status_t hash_init(pmix_info_t info[], size_t ninfo)
 {
@@ -165,6 +210,8 @@ static pmix_status_t hash_init(pmix_info_t info[], size_t ninfo)
                         "gds: hash init");
 
     PMIX_CONSTRUCT(&myhashes, pmix_list_t);
+    PMIX_CONSTRUCT(&myhashes_idx, pmix_pointer_array_t);
+    pmix_pointer_array_init(&myhashes_idx, 32, INT_MAX, 32);
     return PMIX_SUCCESS;
 }
 
@@ -173,9 +220,46 @@ static void hash_finalize(void)
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "gds: hash finalize");
 
+    PMIX_DESTRUCT(&myhashes_idx);
     PMIX_LIST_DESTRUCT(&myhashes);
 }
 
+/* find the tracker of the nspace, optionally creating it */
+static pmix_hash_trkr_t* get_tracker(const char *nspace, bool create)
+{
+    pmix_hash_trkr_t *trk;
+    uint32_t nsid;
+
+    nsid = pmix_nspace_registry_lookup(nspace);
+    if (PMIX_NSPACE_INVALID_ID != nsid && (uint32_t)INT_MAX >= nsid) {
+        trk = (pmix_hash_trkr_t*)pmix_pointer_array_get_item(&myhashes_idx, (int)nsid);
+        if (NULL != trk) {
+            return trk;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    /* the tracker holds a reference on the id for as long as it lives */
+    nsid = pmix_nspace_registry_add(nspace);
+    if (PMIX_NSPACE_INVALID_ID == nsid || (uint32_t)INT_MAX < nsid) {
+        return NULL;
+    }
+    trk = PMIX_NEW(pmix_hash_trkr_t);
+    if (NULL == trk) {
+        pmix_nspace_registry_release(nsid);
+        return NULL;
+    }
+    trk->ns = strdup(nspace);
+    trk->nsid = nsid;
+    if (PMIX_SUCCESS != pmix_pointer_array_set_item(&myhashes_idx, (int)nsid, trk)) {
+        PMIX_RELEASE(trk);
+        return NULL;
+    }
+    pmix_list_append(&myhashes, &trk->super);
+    return trk;
+}
+
 static pmix_status_t hash_assign_module(pmix_info_t *info, size_t ninfo,
                                         int *priority)
 {
@@ -202,9 +286,86 @@ static pmix_status_t hash_assign_module(pmix_info_t *info, size_t ninfo,
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t store_map(pmix_hash_table_t *ht,
+/* store data that is set once for the life of the nspace - the
+ * job info. The key and value are copied into the arena of the
+ * nspace so they are released with it. The arena is never reclaimed
+ * before that, so anything that can be stored again - the modex is
+ * delivered by every fence - must not go through here */
+static pmix_status_t store_fixed(pmix_hash_trkr_t *trk,
+                                 pmix_hash_table_t *ht,
+                                 pmix_rank_t rank, pmix_kval_t *kv)
+{
+    pmix_kval_t *akv;
+    pmix_status_t rc;
+
+    pmix_gds_hash_snapshot_drop(&trk->snapshots, rank);
+    if (NULL == trk->arena) {
+        return pmix_hash_store(ht, rank, kv);
+    }
+    rc = pmix_gds_hash_arena_copy(trk->arena, kv, &akv);
+    if (PMIX_ERR_TAKE_NEXT_OPTION == rc) {
+        return pmix_hash_store(ht, rank, kv);
+    }
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = pmix_hash_store(ht, rank, akv);
+    PMIX_RELEASE(akv);  // maintain accounting
+    return rc;
+}
+
+/* store job-level data of a specific proc - the standard
+ * attributes go to the job map, anything else to the
+ * internal hash table */
+static pmix_status_t store_proc_data(pmix_hash_trkr_t *trk,
+                                     pmix_rank_t rank, pmix_kval_t *kv,
+                                     bool fixed)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_snapshot_drop(&trk->snapshots, rank);
+    rc = pmix_gds_hash_jobmap_store(&trk->jobmap, rank, kv);
+    if (PMIX_SUCCESS == rc) {
+        /* drop any value stored for the key before */
+        return pmix_hash_remove_data(&trk->internal, rank, kv->key);
+    }
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        return rc;
+    }
+    pmix_gds_hash_jobmap_clear(&trk->jobmap, rank, kv->key);
+    if (fixed) {
+        return store_fixed(trk, &trk->internal, rank, kv);
+    }
+    return pmix_hash_store(&trk->internal, rank, kv);
+}
+
+/* check if job-level data of the key is already known for the rank */
+static bool have_job_data(pmix_hash_trkr_t *trk, pmix_rank_t rank,
+                          const char *key)
+{
+    pmix_list_t kvs;
+    pmix_value_t *val = NULL;
+    bool found;
+
+    PMIX_CONSTRUCT(&kvs, pmix_list_t);
+    found = (PMIX_SUCCESS == pmix_gds_hash_jobmap_fetch(&trk->jobmap, rank, key, &kvs));
+    PMIX_LIST_DESTRUCT(&kvs);
+    if (!found) {
+        found = (PMIX_SUCCESS == pmix_hash_fetch(&trk->internal, rank, key, &val));
+        if (NULL != val) {
+            PMIX_VALUE_RELEASE(val);
+        }
+    }
+    return found;
+}
+
+/* the map is expanded after the rest of the job info has been
+ * stored, so it only fills in the values the host didn't
+ * provide on its own */
+static pmix_status_t store_map(pmix_hash_trkr_t *trk,
                                char **nodes, char **ppn)
 {
+    pmix_hash_table_t *ht = &trk->internal;
     pmix_status_t rc;
     pmix_value_t *val;
     size_t m, n;
@@ -243,11 +404,7 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
             updated = false;
             for (m=0; m < val->data.darray->size; m++) {
                 if (0 == strncmp(iptr[m].key, PMIX_LOCAL_PEERS, PMIX_MAX_KEYLEN)) {
-                    /* we will update this entry */
-                    if (NULL != iptr[m].value.data.string) {
-                        free(iptr[m].value.data.string);
-                    }
-                    iptr[m].value.data.string = strdup(ppn[n]);
+                    /* the host already told us */
                     updated = true;
                     break;
                 }
@@ -283,7 +440,7 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
                 }
                 PMIX_INFO_LOAD(&info[kp2->value->data.darray->size-1], PMIX_LOCAL_PEERS, ppn[n], PMIX_STRING);
                 kp2->value->data.darray->array = info;
-                if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+                if (PMIX_SUCCESS != (rc = store_fixed(trk, ht, PMIX_RANK_WILDCARD, kp2))) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp2);
                     return rc;
@@ -317,7 +474,7 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
             PMIX_INFO_LOAD(&info[0], PMIX_LOCAL_PEERS, ppn[n], PMIX_STRING);
             kp2->value->data.darray->array = info;
             kp2->value->data.darray->size = 1;
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+            if (PMIX_SUCCESS != (rc = store_fixed(trk, ht, PMIX_RANK_WILDCARD, kp2))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp2);
                 return rc;
@@ -328,14 +485,17 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
          * individual location data */
         procs = pmix_argv_split(ppn[n], ',');
         for (m=0; NULL != procs[m]; m++) {
+            rank = strtol(procs[m], NULL, 10);
+            if (have_job_data(trk, rank, PMIX_HOSTNAME)) {
+                continue;
+            }
             /* store the hostname for each proc */
             kp2 = PMIX_NEW(pmix_kval_t);
             kp2->key = strdup(PMIX_HOSTNAME);
             kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
             kp2->value->type = PMIX_STRING;
             kp2->value->data.string = strdup(nodes[n]);
-            rank = strtol(procs[m], NULL, 10);
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2))) {
+            if (PMIX_SUCCESS != (rc = store_proc_data(trk, rank, kp2, true))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp2);
                 pmix_argv_free(procs);
@@ -349,12 +509,15 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
     /* store the comma-delimited list of nodes hosting
      * procs in this nspace in case someone using PMIx v2
      * requests it */
+    if (have_job_data(trk, PMIX_RANK_WILDCARD, PMIX_NODE_LIST)) {
+        return PMIX_SUCCESS;
+    }
     kp2 = PMIX_NEW(pmix_kval_t);
     kp2->key = strdup(PMIX_NODE_LIST);
     kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
     kp2->value->type = PMIX_STRING;
     kp2->value->data.string = pmix_argv_join(nodes, ',');
-    if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+    if (PMIX_SUCCESS != (rc = store_fixed(trk, ht, PMIX_RANK_WILDCARD, kp2))) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(kp2);
         return rc;
@@ -364,15 +527,63 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
     return PMIX_SUCCESS;
 }
 
+/* expanding the node and proc maps is proportional to the size
+ * of the job, so it is deferred until the data is requested. A
+ * failure is reported once - the data of the job that doesn't
+ * come from the map remains available */
+static pmix_status_t expand_map(pmix_hash_trkr_t *trk)
+{
+    char **nodes = NULL, **procs = NULL;
+    pmix_status_t rc;
+
+    if (NULL == trk->nodemap || NULL == trk->procmap) {
+        /* nothing to expand yet */
+        return PMIX_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:expand_map for nspace %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        trk->ns);
+
+    /* parse the regex to get the argv array of node names */
+    if (PMIX_SUCCESS != (rc = pmix_preg.parse_nodes(trk->nodemap, &nodes))) {
+        PMIX_ERROR_LOG(rc);
+        goto release;
+    }
+    /* parse the regex to get the argv array containing proc ranks on each node */
+    if (PMIX_SUCCESS != (rc = pmix_preg.parse_procs(trk->procmap, &procs))) {
+        PMIX_ERROR_LOG(rc);
+        goto release;
+    }
+    /* parse and store the detailed map */
+    if (PMIX_SUCCESS != (rc = store_map(trk, nodes, procs))) {
+        PMIX_ERROR_LOG(rc);
+    }
+
+  release:
+    /* don't retry a regex that failed to parse */
+    free(trk->nodemap);
+    trk->nodemap = NULL;
+    free(trk->procmap);
+    trk->procmap = NULL;
+    if (NULL != nodes) {
+        pmix_argv_free(nodes);
+    }
+    if (NULL != procs) {
+        pmix_argv_free(procs);
+    }
+    return rc;
+}
+
 pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                                   pmix_info_t info[], size_t ninfo)
 {
     pmix_namespace_t *nptr = (pmix_namespace_t*)ns;
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *trk;
     pmix_hash_table_t *ht;
     pmix_kval_t *kp2, *kvptr;
     pmix_info_t *iptr;
-    char **nodes=NULL, **procs=NULL;
     uint8_t *tmp;
     pmix_rank_t rank;
     pmix_status_t rc=PMIX_SUCCESS;
@@ -383,24 +594,14 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         nptr->nspace);
 
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(nptr->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
+    /* find the hash table for this nspace - create a
+     * tracker as we will likely need it */
+    if (NULL == (trk = get_tracker(nptr->nspace, true))) {
+        return PMIX_ERR_NOMEM;
     }
-    if (NULL == trk) {
-        /* create a tracker as we will likely need it */
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        if (NULL == trk) {
-            return PMIX_ERR_NOMEM;
-        }
+    if (NULL == trk->nptr) {
         PMIX_RETAIN(nptr);
         trk->nptr = nptr;
-        trk->ns = strdup(nptr->nspace);
-        pmix_list_append(&myhashes, &trk->super);
     }
 
     /* if there isn't any data, then be content with just
@@ -420,40 +621,24 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
             kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
             kp2->value->type = PMIX_STRING;
             kp2->value->data.string = strdup(info[n].value.data.string);
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+            if (PMIX_SUCCESS != (rc = store_fixed(trk, ht, PMIX_RANK_WILDCARD, kp2))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp2);
                 return rc;
             }
             PMIX_RELEASE(kp2);  // maintain acctg
 
-            /* parse the regex to get the argv array of node names */
-            if (PMIX_SUCCESS != (rc = pmix_preg.parse_nodes(info[n].value.data.string, &nodes))) {
-                PMIX_ERROR_LOG(rc);
-                goto release;
-            }
-            /* if we have already found the proc map, then parse
-             * and store the detailed map */
-            if (NULL != procs) {
-                if (PMIX_SUCCESS != (rc = store_map(ht, nodes, procs))) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+            /* keep the regex - the detailed map is stored
+             * when someone asks for it */
+            if (NULL != trk->nodemap) {
+                free(trk->nodemap);
             }
+            trk->nodemap = strdup(info[n].value.data.string);
         } else if (0 == strcmp(info[n].key, PMIX_PROC_MAP)) {
-            /* parse the regex to get the argv array containing proc ranks on each node */
-            if (PMIX_SUCCESS != (rc = pmix_preg.parse_procs(info[n].value.data.string, &procs))) {
-                PMIX_ERROR_LOG(rc);
-                goto release;
-            }
-            /* if we have already recv'd the node map, then parse
-             * and store the detailed map */
-            if (NULL != nodes) {
-                if (PMIX_SUCCESS != (rc = store_map(ht, nodes, procs))) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+            if (NULL != trk->procmap) {
+                free(trk->procmap);
             }
+            trk->procmap = strdup(info[n].value.data.string);
         } else if (0 == strcmp(info[n].key, PMIX_PROC_DATA)) {
             /* an array of data pertaining to a specific proc */
             if (PMIX_DATA_ARRAY != info[n].value.type) {
@@ -500,8 +685,8 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                         kp2->value->data.bo.size = len;
                     }
                 }
-                /* store it in the hash_table */
-                if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2))) {
+                /* store it in the job map or the hash_table */
+                if (PMIX_SUCCESS != (rc = store_proc_data(trk, rank, kp2, true))) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp2);
                     goto release;
@@ -538,7 +723,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                     kp2->value->data.bo.size = len;
                 }
             }
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+            if (PMIX_SUCCESS != (rc = store_fixed(trk, ht, PMIX_RANK_WILDCARD, kp2))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp2);
                 goto release;
@@ -568,7 +753,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 PMIX_RELEASE(kp2);
                 goto release;
             }
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+            if (PMIX_SUCCESS != (rc = store_fixed(trk, ht, PMIX_RANK_WILDCARD, kp2))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp2);
                 break;
@@ -579,12 +764,6 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     }
 
   release:
-    if (NULL != nodes) {
-        pmix_argv_free(nodes);
-    }
-    if (NULL != procs) {
-        pmix_argv_free(procs);
-    }
     return rc;
 }
 
@@ -592,26 +771,23 @@ static pmix_status_t register_info(pmix_peer_t *peer,
                                    pmix_namespace_t *ns,
                                    pmix_buffer_t *reply)
 {
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *trk;
     pmix_hash_table_t *ht;
     pmix_value_t *val, blob;
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_info_t *info;
     size_t ninfo, n;
-    pmix_kval_t kv;
+    pmix_kval_t kv, *kp;
     pmix_buffer_t buf;
     pmix_rank_t rank;
+    pmix_list_t jkvs;
 
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(ns->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
-    }
-    if (NULL == trk) {
+    if (NULL == (trk = get_tracker(ns->nspace, false))) {
         return PMIX_ERR_INVALID_NAMESPACE;
     }
+    /* the client gets all of the job data - a bad map is
+     * already logged, ship the rest of it anyway */
+    (void)expand_map(trk);
     /* the job data is stored on the internal hash table */
     ht = &trk->internal;
 
@@ -643,27 +819,42 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     }
 
     for (rank=0; rank < ns->nprocs; rank++) {
+        /* the standard per-proc data is in the job map, the
+         * rest of it in the hash table */
+        PMIX_CONSTRUCT(&jkvs, pmix_list_t);
+        pmix_gds_hash_jobmap_fetch_all(&trk->jobmap, rank, &jkvs);
         val = NULL;
         rc = pmix_hash_fetch(ht, rank, NULL, &val);
+        if (PMIX_ERR_PROC_ENTRY_NOT_FOUND == rc && !pmix_list_is_empty(&jkvs)) {
+            rc = PMIX_SUCCESS;
+        }
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             if (NULL != val) {
                 PMIX_VALUE_RELEASE(val);
             }
+            PMIX_LIST_DESTRUCT(&jkvs);
             return rc;
         }
-        if (NULL == val) {
+        if (NULL == val && pmix_list_is_empty(&jkvs)) {
+            PMIX_LIST_DESTRUCT(&jkvs);
             return PMIX_ERR_NOT_FOUND;
         }
         PMIX_CONSTRUCT(&buf, pmix_buffer_t);
         PMIX_BFROPS_PACK(rc, peer, &buf, &rank, 1, PMIX_PROC_RANK);
 
-        info = (pmix_info_t*)val->data.darray->array;
-        ninfo = val->data.darray->size;
-        for (n=0; n < ninfo; n++) {
-            kv.key = info[n].key;
-            kv.value = &info[n].value;
-            PMIX_BFROPS_PACK(rc, peer, &buf, &kv, 1, PMIX_KVAL);
+        PMIX_LIST_FOREACH(kp, &jkvs, pmix_kval_t) {
+            PMIX_BFROPS_PACK(rc, peer, &buf, kp, 1, PMIX_KVAL);
+        }
+        PMIX_LIST_DESTRUCT(&jkvs);
+        if (NULL != val) {
+            info = (pmix_info_t*)val->data.darray->array;
+            ninfo = val->data.darray->size;
+            for (n=0; n < ninfo; n++) {
+                kv.key = info[n].key;
+                kv.value = &info[n].value;
+                PMIX_BFROPS_PACK(rc, peer, &buf, &kv, 1, PMIX_KVAL);
+            }
         }
         kv.key = PMIX_PROC_BLOB;
         kv.value = &blob;
@@ -690,7 +881,7 @@ static pmix_status_t hash_register_job_info(struct pmix_peer_t *pr,
     pmix_namespace_t *ns = peer->nptr;
     char *msg;
     pmix_status_t rc;
-    pmix_hash_trkr_t *trk, *t2;
+    pmix_hash_trkr_t *trk;
 
     if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
         !PMIX_PROC_IS_LAUNCHER(pmix_globals.mypeer)) {
@@ -726,22 +917,12 @@ static pmix_status_t hash_register_job_info(struct pmix_peer_t *pr,
 
     /* setup a tracker for this nspace as we will likely
      * need it again */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t2, &myhashes, pmix_hash_trkr_t) {
-        if (ns == t2->nptr) {
-            trk = t2;
-            if (NULL == trk->ns) {
-                trk->ns = strdup(ns->nspace);
-            }
-            break;
-        }
+    if (NULL == (trk = get_tracker(ns->nspace, true))) {
+        return PMIX_ERR_NOMEM;
     }
-    if (NULL == trk) {
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        trk->ns = strdup(ns->nspace);
+    if (NULL == trk->nptr) {
         PMIX_RETAIN(ns);
         trk->nptr = ns;
-        pmix_list_append(&myhashes, &trk->super);
     }
 
     /* the job info for the specified nspace has
@@ -807,21 +988,13 @@ static pmix_status_t hash_store_job_info(const char *nspace,
         return rc;
     }
 
-    /* see if we already have a hash table for this nspace */
-    ht = NULL;
-    PMIX_LIST_FOREACH(htptr, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(htptr->ns, nspace)) {
-            ht = &htptr->internal;
-            break;
-        }
-    }
-    if (NULL == ht) {
-        /* nope - create one */
-        htptr = PMIX_NEW(pmix_hash_trkr_t);
-        htptr->ns = strdup(nspace);
-        pmix_list_append(&myhashes, &htptr->super);
-        ht = &htptr->internal;
+    /* get the hash table for this nspace, creating it if needed */
+    if (NULL == (htptr = get_tracker(nspace, true))) {
+        rc = PMIX_ERR_NOMEM;
+        PMIX_ERROR_LOG(rc);
+        return rc;
     }
+    ht = &htptr->internal;
 
     cnt = 1;
     kptr = PMIX_NEW(pmix_kval_t);
@@ -867,7 +1040,7 @@ static pmix_status_t hash_store_job_info(const char *nspace,
                 }
                 /* this is data provided by a job-level exchange, so store it
                  * in the job-level data hash_table */
-                if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2))) {
+                if (PMIX_SUCCESS != (rc = store_proc_data(htptr, rank, kp2, true))) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp2);
                     PMIX_DESTRUCT(&buf2);
@@ -942,7 +1115,7 @@ static pmix_status_t hash_store_job_info(const char *nspace,
                     }
                     PMIX_INFO_LOAD(&info[kp2->value->data.darray->size-1], PMIX_LOCAL_PEERS, kv.value->data.string, PMIX_STRING);
                     kp2->value->data.darray->array = info;
-                    if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+                    if (PMIX_SUCCESS != (rc = store_fixed(htptr, ht, PMIX_RANK_WILDCARD, kp2))) {
                         PMIX_ERROR_LOG(rc);
                         PMIX_RELEASE(kp2);
                         PMIX_DESTRUCT(&kv);
@@ -974,7 +1147,7 @@ static pmix_status_t hash_store_job_info(const char *nspace,
                     PMIX_INFO_LOAD(&info[0], PMIX_LOCAL_PEERS, kv.value->data.string, PMIX_STRING);
                     kp2->value->data.darray->array = info;
                     kp2->value->data.darray->size = 1;
-                    if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+                    if (PMIX_SUCCESS != (rc = store_fixed(htptr, ht, PMIX_RANK_WILDCARD, kp2))) {
                         PMIX_ERROR_LOG(rc);
                         PMIX_RELEASE(kp2);
                         PMIX_DESTRUCT(&kv);
@@ -996,7 +1169,7 @@ static pmix_status_t hash_store_job_info(const char *nspace,
                     kp2->value->type = PMIX_STRING;
                     kp2->value->data.string = strdup(kv.key);
                     rank = strtol(procs[j], NULL, 10);
-                    if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2))) {
+                    if (PMIX_SUCCESS != (rc = store_proc_data(htptr, rank, kp2, true))) {
                         PMIX_ERROR_LOG(rc);
                         PMIX_RELEASE(kp2);
                         PMIX_DESTRUCT(&kv);
@@ -1018,7 +1191,7 @@ static pmix_status_t hash_store_job_info(const char *nspace,
                 kp2->value->type = PMIX_STRING;
                 kp2->value->data.string = pmix_argv_join(nodelist, ',');
                 pmix_argv_free(nodelist);
-                if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
+                if (PMIX_SUCCESS != (rc = store_fixed(htptr, ht, PMIX_RANK_WILDCARD, kp2))) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp2);
                     PMIX_DESTRUCT(&kv);
@@ -1048,7 +1221,7 @@ static pmix_status_t hash_store_job_info(const char *nspace,
             pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                                 "[%s:%u] pmix:gds:hash store job info storing key %s for WILDCARD rank",
                                 pmix_globals.myid.nspace, pmix_globals.myid.rank, kptr->key);
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kptr))) {
+            if (PMIX_SUCCESS != (rc = store_fixed(htptr, ht, PMIX_RANK_WILDCARD, kptr))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kptr);
                 return rc;
@@ -1075,7 +1248,7 @@ static pmix_status_t hash_store(const pmix_proc_t *proc,
                                 pmix_scope_t scope,
                                 pmix_kval_t *kv)
 {
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *trk;
     pmix_status_t rc;
     pmix_kval_t *kp;
 
@@ -1089,20 +1262,12 @@ static pmix_status_t hash_store(const pmix_proc_t *proc,
         return PMIX_ERR_BAD_PARAM;
     }
 
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(proc->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
-    }
-    if (NULL == trk) {
-        /* create one */
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        trk->ns = strdup(proc->nspace);
-        pmix_list_append(&myhashes, &trk->super);
+    /* find the hash table for this nspace, creating it if needed */
+    if (NULL == (trk = get_tracker(proc->nspace, true))) {
+        return PMIX_ERR_NOMEM;
     }
+    /* any packed copy of the data of the proc is now stale */
+    pmix_gds_hash_snapshot_drop(&trk->snapshots, proc->rank);
 
     /* see if the proc is me */
     if (proc->rank == pmix_globals.myid.rank &&
@@ -1125,7 +1290,7 @@ static pmix_status_t hash_store(const pmix_proc_t *proc,
                 PMIX_RELEASE(kp);
                 return rc;
             }
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(&trk->internal, proc->rank, kp))) {
+            if (PMIX_SUCCESS != (rc = store_proc_data(trk, proc->rank, kp, false))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp);
                 return rc;
@@ -1136,7 +1301,7 @@ static pmix_status_t hash_store(const pmix_proc_t *proc,
 
     /* store it in the corresponding hash table */
     if (PMIX_INTERNAL == scope) {
-        if (PMIX_SUCCESS != (rc = pmix_hash_store(&trk->internal, proc->rank, kv))) {
+        if (PMIX_SUCCESS != (rc = store_proc_data(trk, proc->rank, kv, false))) {
             PMIX_ERROR_LOG(rc);
             return rc;
         }
@@ -1203,7 +1368,7 @@ static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx,
                                        char **kmap,
                                        pmix_buffer_t *pbkt)
 {
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *trk;
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_kval_t *kv;
 
@@ -1212,19 +1377,9 @@ static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx,
                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         proc->nspace);
 
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(proc->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
-    }
-    if (NULL == trk) {
-        /* create one */
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        trk->ns = strdup(proc->nspace);
-        pmix_list_append(&myhashes, &trk->super);
+    /* find the hash table for this nspace, creating it if needed */
+    if (NULL == (trk = get_tracker(proc->nspace, true))) {
+        return PMIX_ERR_NOMEM;
     }
 
     /* this is data returned via the PMIx_Fence call when
@@ -1239,6 +1394,7 @@ static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx,
 
     while (PMIX_SUCCESS == rc) {
         /* store this in the hash table */
+        pmix_gds_hash_snapshot_drop(&trk->snapshots, proc->rank);
         if (PMIX_SUCCESS != (rc = pmix_hash_store(&trk->remote, proc->rank, kv))) {
             PMIX_ERROR_LOG(rc);
             return rc;
@@ -1258,19 +1414,20 @@ static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx,
 }
 
 
-static pmix_status_t hash_fetch(const pmix_proc_t *proc,
-                                pmix_scope_t scope, bool copy,
-                                const char *key,
-                                pmix_info_t qualifiers[], size_t nqual,
-                                pmix_list_t *kvs)
+static pmix_status_t _hash_fetch(const pmix_proc_t *proc,
+                                 pmix_scope_t scope, bool copy,
+                                 const char *key,
+                                 pmix_info_t qualifiers[], size_t nqual,
+                                 pmix_list_t *kvs)
 {
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *trk;
     pmix_status_t rc;
     pmix_value_t *val;
     pmix_kval_t *kv;
     pmix_info_t *info;
     size_t n, ninfo;
     pmix_hash_table_t *ht;
+    bool jfound;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "[%s:%u] pmix:gds:hash fetch %s for proc %s:%u on scope %s",
@@ -1284,19 +1441,21 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
     if (NULL == key && PMIX_RANK_WILDCARD == proc->rank) {
         /* see if we have a tracker for this nspace - we will
          * if we already cached the job info for it */
-        trk = NULL;
-        PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-            if (0 == strcmp(proc->nspace, t->ns)) {
-                trk = t;
-                break;
-            }
-        }
-        if (NULL == trk) {
+        if (NULL == (trk = get_tracker(proc->nspace, false))) {
             /* let the caller know */
             return PMIX_ERR_INVALID_NAMESPACE;
         }
         /* the job data is stored on the internal hash table */
         ht = &trk->internal;
+        if (!copy) {
+            /* the caller only reads the data, so hand out
+             * references to the stored values */
+            rc = pmix_hash_fetch_shared(ht, PMIX_RANK_WILDCARD, NULL, kvs);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+            return rc;
+        }
         /* fetch all values from the hash table tied to rank=wildcard */
         val = NULL;
         rc = pmix_hash_fetch(ht, PMIX_RANK_WILDCARD, NULL, &val);
@@ -1311,7 +1470,8 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
             return PMIX_ERR_NOT_FOUND;
         }
         /* the data is returned in a pmix_data_array_t of pmix_info_t
-         * structs. cycle thru and transfer them to the list */
+         * structs. cycle thru and move them to the list - the
+         * array is ours, so there is no need for another copy */
         if (PMIX_DATA_ARRAY != val->type ||
             NULL == val->data.darray ||
             PMIX_INFO != val->data.darray->type) {
@@ -1329,13 +1489,13 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
                 return rc;
             }
             kv->key = strdup(info[n].key);
-            PMIX_VALUE_XFER(rc, kv->value, &info[n].value);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
+            kv->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+            if (NULL == kv->key || NULL == kv->value) {
                 PMIX_RELEASE(kv);
                 PMIX_VALUE_RELEASE(val);
-                return rc;
+                return PMIX_ERR_NOMEM;
             }
+            pmix_bfrops_base_value_move(kv->value, &info[n].value);
             pmix_list_append(kvs, &kv->super);
         }
         PMIX_VALUE_RELEASE(val);
@@ -1343,20 +1503,12 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
     }
 
     /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(proc->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
-    }
-    if (NULL == trk) {
+    if (NULL == (trk = get_tracker(proc->nspace, false))) {
         return PMIX_ERR_INVALID_NAMESPACE;
     }
 
-    /* fetch from the corresponding hash table - note that
-     * we always provide a copy as we don't support
-     * shared memory */
+    /* fetch from the corresponding hash table - we provide
+     * a copy unless the caller only reads the data */
     if (PMIX_INTERNAL == scope ||
         PMIX_SCOPE_UNDEF == scope ||
         PMIX_GLOBAL == scope ||
@@ -1373,14 +1525,39 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
     }
 
   doover:
-    rc = pmix_hash_fetch(ht, proc->rank, key, &val);
-    if (PMIX_SUCCESS == rc) {
+    jfound = false;
+    if (ht == &trk->internal && PMIX_RANK_WILDCARD != proc->rank) {
+        /* the standard per-proc job data lives in the job map */
+        if (NULL != key) {
+            if (PMIX_SUCCESS == pmix_gds_hash_jobmap_fetch(&trk->jobmap, proc->rank, key, kvs)) {
+                return PMIX_SUCCESS;
+            }
+        } else if (PMIX_SUCCESS == pmix_gds_hash_jobmap_fetch_all(&trk->jobmap, proc->rank, kvs)) {
+            jfound = true;
+        }
+    }
+    if (!copy && PMIX_RANK_UNDEF != proc->rank) {
+        /* hand out references to the stored values */
+        rc = pmix_hash_fetch_shared(ht, proc->rank, key, kvs);
+        if (PMIX_SUCCESS == rc) {
+            if (NULL == key && PMIX_GLOBAL == scope && ht == &trk->local) {
+                /* need to do this again for the remote data */
+                ht = &trk->remote;
+                goto doover;
+            }
+            return PMIX_SUCCESS;
+        }
+    } else if (PMIX_SUCCESS == (rc = pmix_hash_fetch(ht, proc->rank, key, &val))) {
         /* if the key was NULL, then all found keys will be
          * returned as a pmix_data_array_t in the value */
         if (NULL == key) {
             if (NULL == val->data.darray ||
                 PMIX_INFO != val->data.darray->type ||
                 0 == val->data.darray->size) {
+                PMIX_VALUE_RELEASE(val);
+                if (jfound) {
+                    return PMIX_SUCCESS;
+                }
                 PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
                 return PMIX_ERR_NOT_FOUND;
             }
@@ -1426,24 +1603,62 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
         kv->key = strdup(key);
         kv->value = val;
         pmix_list_append(kvs, &kv->super);
-    } else {
-        if (PMIX_GLOBAL == scope ||
-            PMIX_SCOPE_UNDEF == scope) {
-            if (ht == &trk->internal) {
-                /* need to also try the local data */
-                ht = &trk->local;
-                goto doover;
-            } else if (ht == &trk->local) {
-                /* need to also try the remote data */
-                ht = &trk->remote;
-                goto doover;
-            }
+        return PMIX_SUCCESS;
+    }
+
+    if (jfound) {
+        /* all data of the proc was in the job map */
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_GLOBAL == scope ||
+        PMIX_SCOPE_UNDEF == scope) {
+        if (ht == &trk->internal) {
+            /* need to also try the local data */
+            ht = &trk->local;
+            goto doover;
+        } else if (ht == &trk->local) {
+            /* need to also try the remote data */
+            ht = &trk->remote;
+            goto doover;
         }
     }
 
     return rc;
 }
 
+static pmix_status_t hash_fetch(const pmix_proc_t *proc,
+                                pmix_scope_t scope, bool copy,
+                                const char *key,
+                                pmix_info_t qualifiers[], size_t nqual,
+                                pmix_list_t *kvs)
+{
+    pmix_hash_trkr_t *trk;
+    pmix_status_t rc;
+
+    trk = get_tracker(proc->nspace, false);
+    if (NULL == trk || NULL == trk->nodemap || NULL == trk->procmap) {
+        /* nothing pending */
+        return _hash_fetch(proc, scope, copy, key, qualifiers, nqual, kvs);
+    }
+    /* a request for all the data needs the expanded map */
+    if (NULL != key) {
+        rc = _hash_fetch(proc, scope, copy, key, qualifiers, nqual, kvs);
+        if (PMIX_SUCCESS == rc) {
+            return rc;
+        }
+        /* the map only holds the hostname of each proc and the
+         * node-level data, anything else is a genuine miss */
+        if (PMIX_RANK_WILDCARD != proc->rank && PMIX_RANK_UNDEF != proc->rank &&
+            0 != strcmp(key, PMIX_HOSTNAME)) {
+            return rc;
+        }
+    }
+    /* the data may come from the map - expand it and try again.
+     * If the regex is bad, answer from whatever else we have */
+    (void)expand_map(trk);
+    return _hash_fetch(proc, scope, copy, key, qualifiers, nqual, kvs);
+}
+
 static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env)
 {
     /* we don't need to add anything */
@@ -1463,13 +1678,14 @@ static pmix_status_t nspace_del(const char *nspace)
     pmix_hash_trkr_t *t;
 
     /* find the hash table for this nspace */
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(nspace, t->ns)) {
-            /* release it */
-            pmix_list_remove_item(&myhashes, &t->super);
-            PMIX_RELEASE(t);
-            break;
-        }
+    if (NULL != (t = get_tracker(nspace, false))) {
+        /* release it */
+        pmix_pointer_array_set_item(&myhashes_idx, (int)t->nsid, NULL);
+        /* give the id back now, the tracker may outlive its index slot */
+        pmix_nspace_registry_release(t->nsid);
+        t->nsid = PMIX_NSPACE_INVALID_ID;
+        pmix_list_remove_item(&myhashes, &t->super);
+        PMIX_RELEASE(t);
     }
     return PMIX_SUCCESS;
 }
@@ -1498,6 +1714,81 @@ static pmix_status_t assemb_kvs_req(const pmix_proc_t *proc,
     return rc;
 }
 
+static pmix_status_t assemb_kvs_snapshot(const pmix_proc_t *proc,
+                                         pmix_scope_t scope,
+                                         pmix_buffer_t *buf,
+                                         void *cbdata)
+{
+    pmix_server_caddy_t *cd = (pmix_server_caddy_t*)cbdata;
+    pmix_peer_t *peer = (NULL == cd) ? pmix_globals.mypeer : cd->peer;
+    pmix_hash_trkr_t *trk;
+    pmix_buffer_t *snap;
+    pmix_list_t kvs;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+
+    if (PMIX_RANK_UNDEF == proc->rank ||
+        NULL == (trk = get_tracker(proc->nspace, false))) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    /* the snapshot has to include the map */
+    (void)expand_map(trk);
+
+    snap = pmix_gds_hash_snapshot_get(&trk->snapshots, proc->rank, scope,
+                                      peer->nptr->compat.bfrops,
+                                      peer->nptr->compat.type);
+    if (NULL == snap) {
+        /* pack the data once and keep it until the proc's
+         * data changes */
+        PMIX_CONSTRUCT(&kvs, pmix_list_t);
+        rc = _hash_fetch(proc, scope, false, NULL, NULL, 0, &kvs);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_LIST_DESTRUCT(&kvs);
+            return rc;
+        }
+        snap = PMIX_NEW(pmix_buffer_t);
+        if (NULL == snap) {
+            PMIX_LIST_DESTRUCT(&kvs);
+            return PMIX_ERR_NOMEM;
+        }
+        snap->type = peer->nptr->compat.type;
+        PMIX_LIST_FOREACH(kv, &kvs, pmix_kval_t) {
+            PMIX_BFROPS_PACK(rc, peer, snap, kv, 1, PMIX_KVAL);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_LIST_DESTRUCT(&kvs);
+                PMIX_RELEASE(snap);
+                return rc;
+            }
+        }
+        PMIX_LIST_DESTRUCT(&kvs);
+        rc = pmix_gds_hash_snapshot_put(&trk->snapshots, proc->rank, scope,
+                                        peer->nptr->compat.bfrops, snap);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(snap);
+            return rc;
+        }
+    } else {
+        PMIX_RETAIN(snap);
+    }
+
+    /* same layout as assemb_kvs_req */
+    if (NULL != cd && !PMIX_PROC_IS_V1(cd->peer)) {
+        PMIX_BFROPS_PACK(rc, peer, buf, proc, 1, PMIX_PROC);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(snap);
+            return rc;
+        }
+    }
+    rc = PMIX_SUCCESS;
+    if (0 < snap->bytes_used) {
+        PMIX_BFROPS_COPY_PAYLOAD(rc, peer, buf, snap);
+    }
+    PMIX_RELEASE(snap);
+    return rc;
+}
+
 static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
 {
     pmix_status_t rc = PMIX_SUCCESS;
@@ -0,0 +1,206 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <pmix_common.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/util/error.h"
+
+#include "gds_hash_arena.h"
+
+#define PMIX_GDS_HASH_ARENA_MIN_CHUNK  4096
+#define PMIX_GDS_HASH_ARENA_MAX_CHUNK  65536
+#define PMIX_GDS_HASH_ARENA_ALIGN      16
+
+#define ARENA_ALIGN(s) \
+    (((s) + PMIX_GDS_HASH_ARENA_ALIGN - 1) & ~((size_t)PMIX_GDS_HASH_ARENA_ALIGN - 1))
+
+struct pmix_gds_hash_chunk_t {
+    pmix_gds_hash_chunk_t *next;
+    size_t size;
+    size_t used;
+};
+
+/* offset of the first usable byte of a chunk */
+#define CHUNK_HDR  ARENA_ALIGN(sizeof(pmix_gds_hash_chunk_t))
+
+static void arcon(pmix_gds_hash_arena_t *p)
+{
+    p->chunks = NULL;
+    p->chunk_size = PMIX_GDS_HASH_ARENA_MIN_CHUNK;
+}
+static void ardes(pmix_gds_hash_arena_t *p)
+{
+    pmix_gds_hash_chunk_t *chunk;
+
+    while (NULL != (chunk = p->chunks)) {
+        p->chunks = chunk->next;
+        free(chunk);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_gds_hash_arena_t,
+                    pmix_object_t,
+                    arcon, ardes);
+
+static void akcon(pmix_gds_hash_arena_kval_t *p)
+{
+    p->arena = NULL;
+}
+static void akdes(pmix_gds_hash_arena_kval_t *p)
+{
+    /* the key and value belong to the arena */
+    p->super.key = NULL;
+    p->super.value = NULL;
+    if (NULL != p->arena) {
+        PMIX_RELEASE(p->arena);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_gds_hash_arena_kval_t,
+                    pmix_kval_t,
+                    akcon, akdes);
+
+void* pmix_gds_hash_arena_alloc(pmix_gds_hash_arena_t *arena, size_t size)
+{
+    pmix_gds_hash_chunk_t *chunk = arena->chunks;
+    size_t csize;
+    void *ptr;
+
+    size = ARENA_ALIGN(size);
+    if (NULL != chunk && size <= chunk->size - chunk->used) {
+        ptr = (char*)chunk + chunk->used;
+        chunk->used += size;
+        return ptr;
+    }
+
+    if (PMIX_GDS_HASH_ARENA_MAX_CHUNK / 2 < size) {
+        /* large blocks get a chunk of their own behind the current
+         * one so the space left in that one is not lost */
+        if (NULL == (chunk = (pmix_gds_hash_chunk_t*)malloc(CHUNK_HDR + size))) {
+            return NULL;
+        }
+        chunk->size = CHUNK_HDR + size;
+        chunk->used = chunk->size;
+        if (NULL == arena->chunks) {
+            chunk->next = NULL;
+            arena->chunks = chunk;
+        } else {
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        }
+        return (char*)chunk + CHUNK_HDR;
+    }
+
+    csize = arena->chunk_size;
+    if (NULL == (chunk = (pmix_gds_hash_chunk_t*)malloc(csize))) {
+        return NULL;
+    }
+    if (PMIX_GDS_HASH_ARENA_MAX_CHUNK > arena->chunk_size) {
+        arena->chunk_size *= 2;
+    }
+    chunk->size = csize;
+    chunk->used = CHUNK_HDR + size;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    return (char*)chunk + CHUNK_HDR;
+}
+
+pmix_status_t pmix_gds_hash_arena_copy(pmix_gds_hash_arena_t *arena,
+                                       pmix_kval_t *src, pmix_kval_t **dest)
+{
+    pmix_gds_hash_arena_kval_t *kv;
+    pmix_value_t *val;
+    size_t klen, plen = 0;
+    char *key, *payload = NULL;
+
+    if (NULL == src->key || NULL == src->value) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    /* only values that carry no pointers, or a single flat
+     * payload, are kept in the arena */
+    switch (src->value->type) {
+        case PMIX_STRING:
+            if (NULL != src->value->data.string) {
+                plen = strlen(src->value->data.string) + 1;
+            }
+            break;
+        case PMIX_BYTE_OBJECT:
+        case PMIX_COMPRESSED_STRING:
+            if (NULL != src->value->data.bo.bytes) {
+                plen = src->value->data.bo.size;
+            }
+            break;
+        case PMIX_UNDEF:
+        case PMIX_BOOL:
+        case PMIX_BYTE:
+        case PMIX_SIZE:
+        case PMIX_PID:
+        case PMIX_INT:
+        case PMIX_INT8:
+        case PMIX_INT16:
+        case PMIX_INT32:
+        case PMIX_INT64:
+        case PMIX_UINT:
+        case PMIX_UINT8:
+        case PMIX_UINT16:
+        case PMIX_UINT32:
+        case PMIX_UINT64:
+        case PMIX_FLOAT:
+        case PMIX_DOUBLE:
+        case PMIX_TIMEVAL:
+        case PMIX_TIME:
+        case PMIX_STATUS:
+        case PMIX_PROC_RANK:
+        case PMIX_PERSIST:
+        case PMIX_SCOPE:
+        case PMIX_DATA_RANGE:
+        case PMIX_INFO_DIRECTIVES:
+        case PMIX_DATA_TYPE:
+        case PMIX_PROC_STATE:
+        case PMIX_ALLOC_DIRECTIVE:
+            break;
+        default:
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    klen = strlen(src->key) + 1;
+    key = (char*)pmix_gds_hash_arena_alloc(arena, klen);
+    val = (pmix_value_t*)pmix_gds_hash_arena_alloc(arena, sizeof(pmix_value_t));
+    if (0 < plen) {
+        payload = (char*)pmix_gds_hash_arena_alloc(arena, plen);
+    }
+    if (NULL == key || NULL == val || (0 < plen && NULL == payload)) {
+        return PMIX_ERR_NOMEM;
+    }
+    kv = PMIX_NEW(pmix_gds_hash_arena_kval_t);
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(key, src->key, klen);
+    memcpy(val, src->value, sizeof(pmix_value_t));
+    if (PMIX_STRING == val->type) {
+        val->data.string = payload;
+    } else if (PMIX_BYTE_OBJECT == val->type ||
+               PMIX_COMPRESSED_STRING == val->type) {
+        val->data.bo.bytes = payload;
+    }
+    if (0 < plen) {
+        memcpy(payload, (PMIX_STRING == val->type) ? src->value->data.string
+                                                   : src->value->data.bo.bytes, plen);
+    }
+    kv->super.key = key;
+    kv->super.value = val;
+    PMIX_RETAIN(arena);
+    kv->arena = arena;
+    *dest = &kv->super;
+    return PMIX_SUCCESS;
+}
@@ -0,0 +1,56 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_GDS_HASH_ARENA_H
+#define PMIX_GDS_HASH_ARENA_H
+
+#include <src/include/pmix_config.h>
+
+#include "src/class/pmix_object.h"
+#include "src/mca/bfrops/bfrops_types.h"
+
+BEGIN_C_DECLS
+
+/* The arena holds the keys and values of the job data of a
+ * namespace. Memory is handed out from large chunks and is only
+ * returned when the arena itself is released, so the data of a
+ * namespace does not scatter small blocks over the heap and is
+ * freed in a few calls when the namespace goes away. As nothing
+ * is reclaimed before then, only data that is stored once for
+ * the life of the namespace belongs here */
+
+typedef struct pmix_gds_hash_chunk_t pmix_gds_hash_chunk_t;
+
+typedef struct {
+    pmix_object_t super;
+    /* chunks in use, most recent first */
+    pmix_gds_hash_chunk_t *chunks;
+    /* size of the next chunk to allocate */
+    size_t chunk_size;
+} pmix_gds_hash_arena_t;
+PMIX_CLASS_DECLARATION(pmix_gds_hash_arena_t);
+
+/* kval whose key and value live in an arena - it keeps the
+ * arena alive for as long as it exists */
+typedef struct {
+    pmix_kval_t super;
+    pmix_gds_hash_arena_t *arena;
+} pmix_gds_hash_arena_kval_t;
+PMIX_CLASS_DECLARATION(pmix_gds_hash_arena_kval_t);
+
+/* returns NULL if out of memory */
+void* pmix_gds_hash_arena_alloc(pmix_gds_hash_arena_t *arena, size_t size);
+
+/* copy the kval into the arena. Returns PMIX_ERR_TAKE_NEXT_OPTION
+ * if the value has a type that is not kept in arenas */
+pmix_status_t pmix_gds_hash_arena_copy(pmix_gds_hash_arena_t *arena,
+                                       pmix_kval_t *src, pmix_kval_t **dest);
+
+END_C_DECLS
+
+#endif
@@ -0,0 +1,305 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include <pmix_common.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/util/error.h"
+
+#include "gds_hash_jobmap.h"
+
+/* the columns grow by doubling - a rank far beyond the current
+ * size is likely sparse and stays in the hash table instead */
+#define PMIX_GDS_HASH_JOBMAP_MIN_RANKS  1024
+
+typedef struct {
+    const char *key;
+    pmix_data_type_t type;
+    size_t size;
+} jobmap_col_t;
+
+#define JOBMAP_COL_HOSTNAME  0
+
+static const jobmap_col_t jobmap_cols[PMIX_GDS_HASH_JOBMAP_NCOLS] = {
+    /* index into the node table */
+    {PMIX_HOSTNAME, PMIX_STRING, sizeof(uint32_t)},
+    {PMIX_NODEID, PMIX_UINT32, sizeof(uint32_t)},
+    {PMIX_APPNUM, PMIX_UINT32, sizeof(uint32_t)},
+    {PMIX_GLOBAL_RANK, PMIX_PROC_RANK, sizeof(pmix_rank_t)},
+    {PMIX_APP_RANK, PMIX_PROC_RANK, sizeof(pmix_rank_t)},
+    {PMIX_LOCAL_RANK, PMIX_UINT16, sizeof(uint16_t)},
+    {PMIX_NODE_RANK, PMIX_UINT16, sizeof(uint16_t)}
+};
+
+#define JOBMAP_IS_SET(m, c, r) \
+    (NULL != (m)->present[c] && (r) < (m)->nranks && ((m)->present[c][(r) >> 3] & (1 << ((r) & 7))))
+
+static void jmcon(pmix_gds_hash_jobmap_t *p)
+{
+    int c;
+
+    p->nranks = 0;
+    for (c=0; c < PMIX_GDS_HASH_JOBMAP_NCOLS; c++) {
+        p->present[c] = NULL;
+        p->cols[c] = NULL;
+    }
+    PMIX_CONSTRUCT(&p->nodes, pmix_pointer_array_t);
+    pmix_pointer_array_init(&p->nodes, 32, INT_MAX, 32);
+    PMIX_CONSTRUCT(&p->node_idx, pmix_hash_table_t);
+    pmix_hash_table_init(&p->node_idx, 32);
+}
+static void jmdes(pmix_gds_hash_jobmap_t *p)
+{
+    int c;
+    char *name;
+
+    for (c=0; c < PMIX_GDS_HASH_JOBMAP_NCOLS; c++) {
+        if (NULL != p->present[c]) {
+            free(p->present[c]);
+        }
+        if (NULL != p->cols[c]) {
+            free(p->cols[c]);
+        }
+    }
+    for (c=0; c < p->nodes.size; c++) {
+        if (NULL != (name = (char*)pmix_pointer_array_get_item(&p->nodes, c))) {
+            free(name);
+        }
+    }
+    PMIX_DESTRUCT(&p->nodes);
+    PMIX_DESTRUCT(&p->node_idx);
+}
+PMIX_CLASS_INSTANCE(pmix_gds_hash_jobmap_t,
+                    pmix_object_t,
+                    jmcon, jmdes);
+
+static int column(const char *key)
+{
+    int c;
+
+    if (NULL == key) {
+        return -1;
+    }
+    for (c=0; c < PMIX_GDS_HASH_JOBMAP_NCOLS; c++) {
+        if (0 == strcmp(key, jobmap_cols[c].key)) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+/* make sure all columns can hold the rank */
+static pmix_status_t grow(pmix_gds_hash_jobmap_t *map, pmix_rank_t rank)
+{
+    pmix_rank_t nranks;
+    size_t oldbytes, newbytes;
+    void *ptr;
+    int c;
+
+    if (rank < map->nranks) {
+        return PMIX_SUCCESS;
+    }
+    nranks = (0 == map->nranks) ? PMIX_GDS_HASH_JOBMAP_MIN_RANKS : 2 * map->nranks;
+    while (nranks <= rank) {
+        nranks *= 2;
+    }
+    oldbytes = (map->nranks + 7) / 8;
+    newbytes = (nranks + 7) / 8;
+    for (c=0; c < PMIX_GDS_HASH_JOBMAP_NCOLS; c++) {
+        if (NULL == map->present[c]) {
+            continue;
+        }
+        if (NULL == (ptr = realloc(map->cols[c], nranks * jobmap_cols[c].size))) {
+            return PMIX_ERR_NOMEM;
+        }
+        map->cols[c] = ptr;
+        if (NULL == (ptr = realloc(map->present[c], newbytes))) {
+            return PMIX_ERR_NOMEM;
+        }
+        memset((uint8_t*)ptr + oldbytes, 0, newbytes - oldbytes);
+        map->present[c] = (uint8_t*)ptr;
+    }
+    map->nranks = nranks;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t node_index(pmix_gds_hash_jobmap_t *map,
+                                const char *name, uint32_t *idx)
+{
+    void *value;
+    char *nm;
+    int n;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&map->node_idx, name,
+                                                      strlen(name), &value)) {
+        *idx = (uint32_t)(uintptr_t)value;
+        return PMIX_SUCCESS;
+    }
+    if (NULL == (nm = strdup(name))) {
+        return PMIX_ERR_NOMEM;
+    }
+    if (0 > (n = pmix_pointer_array_add(&map->nodes, nm))) {
+        free(nm);
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_hash_table_set_value_ptr(&map->node_idx, nm, strlen(nm), (void*)(uintptr_t)n);
+    *idx = (uint32_t)n;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_gds_hash_jobmap_store(pmix_gds_hash_jobmap_t *map,
+                                         pmix_rank_t rank,
+                                         pmix_kval_t *kv)
+{
+    pmix_status_t rc;
+    uint32_t idx;
+    int c;
+
+    if (PMIX_RANK_VALID < rank || NULL == kv->value ||
+        0 > (c = column(kv->key)) ||
+        jobmap_cols[c].type != kv->value->type) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    if (JOBMAP_COL_HOSTNAME == c && NULL == kv->value->data.string) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    if (map->nranks <= rank &&
+        2 * (size_t)map->nranks + PMIX_GDS_HASH_JOBMAP_MIN_RANKS <= rank) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    if (PMIX_SUCCESS != (rc = grow(map, rank))) {
+        return rc;
+    }
+    if (NULL == map->present[c]) {
+        map->cols[c] = malloc(map->nranks * jobmap_cols[c].size);
+        map->present[c] = (uint8_t*)calloc((map->nranks + 7) / 8, 1);
+        if (NULL == map->cols[c] || NULL == map->present[c]) {
+            return PMIX_ERR_NOMEM;
+        }
+    }
+
+    switch (jobmap_cols[c].type) {
+        case PMIX_STRING:
+            if (PMIX_SUCCESS != (rc = node_index(map, kv->value->data.string, &idx))) {
+                return rc;
+            }
+            ((uint32_t*)map->cols[c])[rank] = idx;
+            break;
+        case PMIX_UINT32:
+            ((uint32_t*)map->cols[c])[rank] = kv->value->data.uint32;
+            break;
+        case PMIX_PROC_RANK:
+            ((pmix_rank_t*)map->cols[c])[rank] = kv->value->data.rank;
+            break;
+        case PMIX_UINT16:
+            ((uint16_t*)map->cols[c])[rank] = kv->value->data.uint16;
+            break;
+        default:
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    map->present[c][rank >> 3] |= (1 << (rank & 7));
+    return PMIX_SUCCESS;
+}
+
+void pmix_gds_hash_jobmap_clear(pmix_gds_hash_jobmap_t *map,
+                                pmix_rank_t rank, const char *key)
+{
+    int c;
+
+    if (0 <= (c = column(key)) && JOBMAP_IS_SET(map, c, rank)) {
+        map->present[c][rank >> 3] &= ~(1 << (rank & 7));
+    }
+}
+
+static pmix_status_t append_value(pmix_gds_hash_jobmap_t *map, int c,
+                                  pmix_rank_t rank, pmix_list_t *kvs)
+{
+    pmix_kval_t *kv;
+    char *name;
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    kv->key = strdup(jobmap_cols[c].key);
+    kv->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+    if (NULL == kv->key || NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return PMIX_ERR_NOMEM;
+    }
+    kv->value->type = jobmap_cols[c].type;
+    switch (jobmap_cols[c].type) {
+        case PMIX_STRING:
+            name = (char*)pmix_pointer_array_get_item(&map->nodes,
+                                                      (int)((uint32_t*)map->cols[c])[rank]);
+            kv->value->data.string = (NULL == name) ? NULL : strdup(name);
+            break;
+        case PMIX_UINT32:
+            kv->value->data.uint32 = ((uint32_t*)map->cols[c])[rank];
+            break;
+        case PMIX_PROC_RANK:
+            kv->value->data.rank = ((pmix_rank_t*)map->cols[c])[rank];
+            break;
+        case PMIX_UINT16:
+            kv->value->data.uint16 = ((uint16_t*)map->cols[c])[rank];
+            break;
+        default:
+            break;
+    }
+    pmix_list_append(kvs, &kv->super);
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_gds_hash_jobmap_fetch(pmix_gds_hash_jobmap_t *map,
+                                         pmix_rank_t rank, const char *key,
+                                         pmix_list_t *kvs)
+{
+    pmix_rank_t r;
+    int c;
+
+    if (0 > (c = column(key)) || NULL == map->present[c]) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (PMIX_RANK_UNDEF == rank) {
+        for (r=0; r < map->nranks; r++) {
+            if (JOBMAP_IS_SET(map, c, r)) {
+                return append_value(map, c, r, kvs);
+            }
+        }
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (!JOBMAP_IS_SET(map, c, rank)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    return append_value(map, c, rank, kvs);
+}
+
+pmix_status_t pmix_gds_hash_jobmap_fetch_all(pmix_gds_hash_jobmap_t *map,
+                                             pmix_rank_t rank,
+                                             pmix_list_t *kvs)
+{
+    pmix_status_t rc;
+    bool found = false;
+    int c;
+
+    for (c=0; c < PMIX_GDS_HASH_JOBMAP_NCOLS; c++) {
+        if (JOBMAP_IS_SET(map, c, rank)) {
+            if (PMIX_SUCCESS != (rc = append_value(map, c, rank, kvs))) {
+                return rc;
+            }
+            found = true;
+        }
+    }
+    return found ? PMIX_SUCCESS : PMIX_ERR_NOT_FOUND;
+}
@@ -0,0 +1,68 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_GDS_HASH_JOBMAP_H
+#define PMIX_GDS_HASH_JOBMAP_H
+
+#include <src/include/pmix_config.h>
+
+#include "src/class/pmix_object.h"
+#include "src/class/pmix_list.h"
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_pointer_array.h"
+#include "src/mca/bfrops/bfrops_types.h"
+
+BEGIN_C_DECLS
+
+/* The job map keeps the standard per-proc job-level attributes
+ * (PMIX_HOSTNAME, PMIX_NODEID, PMIX_LOCAL_RANK, ...) in dense
+ * arrays indexed by rank instead of one pmix_kval_t per proc and
+ * attribute. Host names are kept once in a node table, the
+ * PMIX_HOSTNAME column holds the index of the node */
+
+#define PMIX_GDS_HASH_JOBMAP_NCOLS  7
+
+typedef struct {
+    pmix_object_t super;
+    /* number of ranks the columns can hold */
+    pmix_rank_t nranks;
+    /* per-column bitmap of the ranks having a value */
+    uint8_t *present[PMIX_GDS_HASH_JOBMAP_NCOLS];
+    void *cols[PMIX_GDS_HASH_JOBMAP_NCOLS];
+    /* node table - index -> name, name -> index */
+    pmix_pointer_array_t nodes;
+    pmix_hash_table_t node_idx;
+} pmix_gds_hash_jobmap_t;
+PMIX_CLASS_DECLARATION(pmix_gds_hash_jobmap_t);
+
+/* store the value if the key is one of the columns and the
+ * value has the type of the column. Returns
+ * PMIX_ERR_TAKE_NEXT_OPTION if the data is not for the map */
+pmix_status_t pmix_gds_hash_jobmap_store(pmix_gds_hash_jobmap_t *map,
+                                         pmix_rank_t rank,
+                                         pmix_kval_t *kv);
+
+/* forget the value of the key for the rank, if any */
+void pmix_gds_hash_jobmap_clear(pmix_gds_hash_jobmap_t *map,
+                                pmix_rank_t rank, const char *key);
+
+/* append a copy of the value of the key for the rank to the
+ * list. A rank of PMIX_RANK_UNDEF returns the value of the
+ * first rank that has one */
+pmix_status_t pmix_gds_hash_jobmap_fetch(pmix_gds_hash_jobmap_t *map,
+                                         pmix_rank_t rank, const char *key,
+                                         pmix_list_t *kvs);
+
+/* append a copy of all the values of the rank to the list */
+pmix_status_t pmix_gds_hash_jobmap_fetch_all(pmix_gds_hash_jobmap_t *map,
+                                             pmix_rank_t rank,
+                                             pmix_list_t *kvs);
+
+END_C_DECLS
+
+#endif
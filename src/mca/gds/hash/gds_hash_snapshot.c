@@ -0,0 +1,125 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <pmix_common.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/class/pmix_list.h"
+#include "src/util/error.h"
+
+#include "gds_hash_snapshot.h"
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_scope_t scope;
+    pmix_bfrops_module_t *bfrops;
+    pmix_buffer_t *buf;
+} pmix_gds_hash_snapshot_t;
+static void sncon(pmix_gds_hash_snapshot_t *p)
+{
+    p->buf = NULL;
+}
+static void sndes(pmix_gds_hash_snapshot_t *p)
+{
+    if (NULL != p->buf) {
+        PMIX_RELEASE(p->buf);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_gds_hash_snapshot_t,
+                           pmix_list_item_t,
+                           sncon, sndes);
+
+static void sscon(pmix_gds_hash_snapshots_t *p)
+{
+    PMIX_CONSTRUCT(&p->ranks, pmix_hash_table_t);
+    pmix_hash_table_init(&p->ranks, 256);
+}
+static void ssdes(pmix_gds_hash_snapshots_t *p)
+{
+    pmix_list_t *snaps;
+    uint32_t rank;
+    void *node, *next;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_uint32(&p->ranks, &rank, (void**)&snaps, &node);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_LIST_RELEASE(snaps);
+        rc = pmix_hash_table_get_next_key_uint32(&p->ranks, &rank, (void**)&snaps, node, &next);
+        node = next;
+    }
+    PMIX_DESTRUCT(&p->ranks);
+}
+PMIX_CLASS_INSTANCE(pmix_gds_hash_snapshots_t,
+                    pmix_object_t,
+                    sscon, ssdes);
+
+pmix_buffer_t* pmix_gds_hash_snapshot_get(pmix_gds_hash_snapshots_t *snaps,
+                                          pmix_rank_t rank, pmix_scope_t scope,
+                                          pmix_bfrops_module_t *bfrops,
+                                          pmix_bfrop_buffer_type_t type)
+{
+    pmix_list_t *list;
+    pmix_gds_hash_snapshot_t *snap;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&snaps->ranks, rank, (void**)&list)) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH(snap, list, pmix_gds_hash_snapshot_t) {
+        if (snap->scope == scope && snap->bfrops == bfrops &&
+            snap->buf->type == type) {
+            return snap->buf;
+        }
+    }
+    return NULL;
+}
+
+pmix_status_t pmix_gds_hash_snapshot_put(pmix_gds_hash_snapshots_t *snaps,
+                                         pmix_rank_t rank, pmix_scope_t scope,
+                                         pmix_bfrops_module_t *bfrops,
+                                         pmix_buffer_t *buf)
+{
+    pmix_list_t *list;
+    pmix_gds_hash_snapshot_t *snap;
+    pmix_status_t rc;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&snaps->ranks, rank, (void**)&list)) {
+        if (NULL == (list = PMIX_NEW(pmix_list_t))) {
+            return PMIX_ERR_NOMEM;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_hash_table_set_value_uint32(&snaps->ranks, rank, list))) {
+            PMIX_RELEASE(list);
+            return rc;
+        }
+    }
+    if (NULL == (snap = PMIX_NEW(pmix_gds_hash_snapshot_t))) {
+        return PMIX_ERR_NOMEM;
+    }
+    snap->scope = scope;
+    snap->bfrops = bfrops;
+    PMIX_RETAIN(buf);
+    snap->buf = buf;
+    pmix_list_append(list, &snap->super);
+    return PMIX_SUCCESS;
+}
+
+void pmix_gds_hash_snapshot_drop(pmix_gds_hash_snapshots_t *snaps,
+                                 pmix_rank_t rank)
+{
+    pmix_list_t *list;
+
+    /* this is on every store - keep it cheap when nothing is cached */
+    if (0 == pmix_hash_table_get_size(&snaps->ranks)) {
+        return;
+    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&snaps->ranks, rank, (void**)&list)) {
+        pmix_hash_table_remove_value_uint32(&snaps->ranks, rank);
+        PMIX_LIST_RELEASE(list);
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_GDS_HASH_SNAPSHOT_H
+#define PMIX_GDS_HASH_SNAPSHOT_H
+
+#include <src/include/pmix_config.h>
+
+#include "src/class/pmix_object.h"
+#include "src/class/pmix_hash_table.h"
+#include "src/mca/bfrops/bfrops.h"
+
+BEGIN_C_DECLS
+
+/* A snapshot is the packed form of all the data of a rank for a
+ * given scope, as returned to a peer asking for it. It is built on
+ * the first request and handed out again until data of the rank
+ * is stored or removed. Snapshots are packed with the bfrops of the
+ * requestor, so there may be one per scope and bfrops module */
+
+typedef struct {
+    pmix_object_t super;
+    /* rank -> pmix_list_t of snapshots */
+    pmix_hash_table_t ranks;
+} pmix_gds_hash_snapshots_t;
+PMIX_CLASS_DECLARATION(pmix_gds_hash_snapshots_t);
+
+/* returns the cached buffer, or NULL if there is none */
+pmix_buffer_t* pmix_gds_hash_snapshot_get(pmix_gds_hash_snapshots_t *snaps,
+                                          pmix_rank_t rank, pmix_scope_t scope,
+                                          pmix_bfrops_module_t *bfrops,
+                                          pmix_bfrop_buffer_type_t type);
+
+/* cache the buffer - it is retained */
+pmix_status_t pmix_gds_hash_snapshot_put(pmix_gds_hash_snapshots_t *snaps,
+                                         pmix_rank_t rank, pmix_scope_t scope,
+                                         pmix_bfrops_module_t *bfrops,
+                                         pmix_buffer_t *buf);
+
+/* forget all snapshots of the rank */
+void pmix_gds_hash_snapshot_drop(pmix_gds_hash_snapshots_t *snaps,
+                                 pmix_rank_t rank);
+
+END_C_DECLS
+
+#endif
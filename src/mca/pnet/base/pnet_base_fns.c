@@ -40,7 +40,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace,
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc = PMIX_SUCCESS;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     size_t n;
     char *nregex, *pregex;
     char *params[2] = {"PMIX_MCA_", NULL};
@@ -57,15 +57,9 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace,
         return PMIX_ERR_BAD_PARAM;
     }
     if (PMIX_PROC_IS_GATEWAY(pmix_globals.mypeer)) {
-        nptr = NULL;
         /* find this nspace - note that it may not have
          * been registered yet */
-        PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(ns->nspace, nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_server_nspace_lookup(nspace);
         if (NULL == nptr) {
             /* add it */
             nptr = PMIX_NEW(pmix_namespace_t);
@@ -74,6 +68,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace,
             }
             nptr->nspace = strdup(nspace);
             pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+            pmix_server_nspace_index(nptr);
         }
 
         if (NULL != info) {
@@ -128,7 +123,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace,
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
 
     if (!pmix_pnet_globals.initialized) {
         return PMIX_ERR_INIT;
@@ -143,13 +138,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace,
     }
 
     /* find this proc's nspace object */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(nspace);
     if (NULL == nptr) {
         /* add it */
         nptr = PMIX_NEW(pmix_namespace_t);
@@ -158,6 +147,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace,
         }
         nptr->nspace = strdup(nspace);
         pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_server_nspace_index(nptr);
     }
 
     PMIX_LIST_FOREACH(active, &pmix_pnet_globals.actives, pmix_pnet_base_active_module_t) {
@@ -176,7 +166,7 @@ pmix_status_t pmix_pnet_base_setup_fork(const pmix_proc_t *proc, char ***env)
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
 
     if (!pmix_pnet_globals.initialized) {
         return PMIX_ERR_INIT;
@@ -188,13 +178,7 @@ pmix_status_t pmix_pnet_base_setup_fork(const pmix_proc_t *proc, char ***env)
     }
 
     /* find this proc's nspace object */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, proc->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(proc->nspace);
     if (NULL == nptr) {
         /* add it */
         nptr = PMIX_NEW(pmix_namespace_t);
@@ -203,6 +187,7 @@ pmix_status_t pmix_pnet_base_setup_fork(const pmix_proc_t *proc, char ***env)
         }
         nptr->nspace = strdup(proc->nspace);
         pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_server_nspace_index(nptr);
     }
 
     PMIX_LIST_FOREACH(active, &pmix_pnet_globals.actives, pmix_pnet_base_active_module_t) {
@@ -264,7 +249,7 @@ void pmix_pnet_base_local_app_finalized(pmix_namespace_t *nptr)
 void pmix_pnet_base_deregister_nspace(char *nspace)
 {
     pmix_pnet_base_active_module_t *active;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     pmix_pnet_job_t *job;
     pmix_pnet_node_t *node;
 
@@ -278,13 +263,7 @@ void pmix_pnet_base_deregister_nspace(char *nspace)
     }
 
     /* find this nspace object */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(nspace);
     if (NULL == nptr) {
         /* nothing we can do */
         return;
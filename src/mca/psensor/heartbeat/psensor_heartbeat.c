@@ -171,6 +171,7 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
     pmix_heartbeat_trkr_t *ft;
     size_t n;
     pmix_ptl_posted_recv_t *rcv;
+    pmix_status_t rc;
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] checking heartbeat monitoring for requestor %s:%d",
@@ -211,8 +212,13 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
         rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
         rcv->tag = PMIX_PTL_TAG_HEARTBEAT;
         rcv->cbfunc = pmix_psensor_heartbeat_recv_beats;
-        /* add it to the beginning of the list of recvs */
-        pmix_list_prepend(&pmix_ptl_globals.posted_recvs, &rcv->super);
+        /* add it to the recvs */
+        if (PMIX_SUCCESS != (rc = pmix_ptl_base_add_posted_recv(rcv))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(rcv);
+            PMIX_RELEASE(ft);
+            return rc;
+        }
         mca_psensor_heartbeat_component.recv_active = true;
     }
 
@@ -20,10 +20,16 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <string.h>
 
 #include <src/include/pmix_config.h>
 #include <pmix_common.h>
+#ifdef HAVE_SYS_STATFS_H
+#include <sys/statfs.h>
+#endif
 #include "src/include/pmix_globals.h"
+#include "src/hwloc/hwloc-internal.h"
+#include "src/util/argv.h"
 
 //#include "pmix_sm.h"
 #include <src/mca/pshmem/pshmem.h>
@@ -33,6 +39,10 @@
 #    define MAP_ANONYMOUS MAP_ANON
 #endif /* MAP_ANONYMOUS and MAP_ANON */
 
+#if defined(HAVE_SYS_STATFS_H) && defined(__linux__)
+#define PMIX_MMAP_HUGETLBFS_MAGIC 0x958458f6
+#endif
+
 static int _mmap_init(void);
 static void _mmap_finalize(void);
 static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size);
@@ -50,14 +60,75 @@ pmix_pshmem_base_module_t pmix_mmap_module = {
     _mmap_segment_unlink
 };
 
+static bool _numa_interleave = false;
+/* backing files created on the hugetlbfs mount, the links to them
+ * may go away with the session directory before the segments do */
+static char **_hugepage_files = NULL;
+
 static int _mmap_init(void)
 {
+    _numa_interleave = (NULL != mca_pshmem_mmap_component.numa_policy &&
+                        0 == strcmp(mca_pshmem_mmap_component.numa_policy, "interleave"));
     return PMIX_SUCCESS;
 }
 
+/* mappings of hugetlbfs files consist of whole huge pages,
+ * the length must be rounded up for mmap/munmap to succeed */
+static size_t _mmap_map_size(int fd, size_t size)
+{
+#ifdef PMIX_MMAP_HUGETLBFS_MAGIC
+    struct statfs fs;
+
+    if (0 == fstatfs(fd, &fs) && PMIX_MMAP_HUGETLBFS_MAGIC == (unsigned long)fs.f_type &&
+        0 < fs.f_bsize) {
+        size = ((size + fs.f_bsize - 1) / fs.f_bsize) * fs.f_bsize;
+    }
+#endif
+    return size;
+}
+
+/* spread the pages of the segment over all NUMA nodes. The policy only
+ * applies to the pages allocated after it is set, so it must be set
+ * before the space of the backing file is allocated */
+static void _mmap_interleave(void *addr, size_t size)
+{
+#if PMIX_HAVE_HWLOC
+    hwloc_const_nodeset_t nodeset;
+    int rc;
+
+    if (NULL == pmix_hwloc_topology &&
+        PMIX_SUCCESS != pmix_hwloc_get_topology(NULL, 0)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "pshmem:mmap: no topology, NUMA policy ignored\n");
+        return;
+    }
+    nodeset = hwloc_topology_get_topology_nodeset(pmix_hwloc_topology);
+#if HWLOC_API_VERSION < 0x20000
+    rc = hwloc_set_area_membind_nodeset(pmix_hwloc_topology, addr, size, nodeset,
+                                        HWLOC_MEMBIND_INTERLEAVE, 0);
+#else
+    rc = hwloc_set_area_membind(pmix_hwloc_topology, addr, size, nodeset,
+                                HWLOC_MEMBIND_INTERLEAVE, HWLOC_MEMBIND_BYNODESET);
+#endif
+    if (0 != rc) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "hwloc_set_area_membind fail\n");
+    }
+#else
+    pmix_output_verbose(2, pmix_globals.debug_output,
+            "pshmem:mmap: built without hwloc, NUMA policy ignored\n");
+#endif
+}
+
 static void _mmap_finalize(void)
 {
-    ;
+    int i;
+
+    for (i = 0; NULL != _hugepage_files && NULL != _hugepage_files[i]; i++) {
+        (void)unlink(_hugepage_files[i]);
+    }
+    pmix_argv_free(_hugepage_files);
+    _hugepage_files = NULL;
 }
 
 static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size)
@@ -65,15 +136,51 @@ static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name
     int rc = PMIX_SUCCESS;
     void *seg_addr = MAP_FAILED;
     pid_t my_pid = getpid();
+    char backing_name[PMIX_PATH_MAX];
+    const char *backing = file_name;
 
     _segment_ds_reset(sm_seg);
+    /* the backing file lives on the hugetlbfs mount, the requested
+     * name is a link to it so peers attach by the usual name */
+    if (NULL != mca_pshmem_mmap_component.hugepage_path) {
+        const char *base = strrchr(file_name, '/');
+        /* segments of different stores may share the base name,
+         * let mkstemp make the name unique - it opens the file
+         * exclusively, so no one else's file is ever reused */
+        snprintf(backing_name, PMIX_PATH_MAX, "%s/pmix-%lu-%s-XXXXXX",
+                 mca_pshmem_mmap_component.hugepage_path, (unsigned long)my_pid,
+                 (NULL == base) ? file_name : base + 1);
+        backing = backing_name;
+        sm_seg->seg_id = mkstemp(backing_name);
+    } else {
+        sm_seg->seg_id = open(backing, O_CREAT | O_RDWR, 0600);
+    }
     /* enough space is available, so create the segment */
-    if (-1 == (sm_seg->seg_id = open(file_name, O_CREAT | O_RDWR, 0600))) {
+    if (-1 == sm_seg->seg_id) {
         pmix_output_verbose(2, pmix_globals.debug_output,
                 "sys call open(2) fail\n");
         rc = PMIX_ERROR;
         goto out;
     }
+    size = _mmap_map_size(sm_seg->seg_id, size);
+    if (_numa_interleave) {
+        /* map the file before its pages are allocated below */
+        if (0 != ftruncate(sm_seg->seg_id, size)) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                    "sys call ftruncate(2) fail\n");
+            rc = PMIX_ERROR;
+            goto out;
+        }
+        if (MAP_FAILED == (seg_addr = mmap(NULL, size,
+                                           PROT_READ | PROT_WRITE, MAP_SHARED,
+                                           sm_seg->seg_id, 0))) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                    "sys call mmap(2) fail\n");
+            rc = PMIX_ERROR;
+            goto out;
+        }
+        _mmap_interleave(seg_addr, size);
+    }
     /* size backing file - note the use of real_size here */
 #ifdef HAVE_POSIX_FALLOCATE
     if (0 != (rc = posix_fallocate(sm_seg->seg_id, 0, size))) {
@@ -110,7 +217,8 @@ static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name
 #ifdef HAVE_POSIX_FALLOCATE
   map_memory:
 #endif
-    if (MAP_FAILED == (seg_addr = mmap(NULL, size,
+    if (MAP_FAILED == seg_addr &&
+        MAP_FAILED == (seg_addr = mmap(NULL, size,
                                        PROT_READ | PROT_WRITE, MAP_SHARED,
                                        sm_seg->seg_id, 0))) {
         pmix_output_verbose(2, pmix_globals.debug_output,
@@ -118,6 +226,15 @@ static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name
         rc = PMIX_ERROR;
         goto out;
     }
+    if (backing != file_name) {
+        if (0 != symlink(backing, file_name)) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                    "sys call symlink(2) fail\n");
+            rc = PMIX_ERROR;
+            goto out;
+        }
+        pmix_argv_append_nosize(&_hugepage_files, backing);
+    }
     sm_seg->seg_cpid = my_pid;
     sm_seg->seg_size = size;
     sm_seg->seg_base_addr = (unsigned char *)seg_addr;
@@ -136,6 +253,9 @@ out:
         if (MAP_FAILED != seg_addr) {
             munmap((void *)seg_addr, size);
         }
+        if (backing != file_name) {
+            unlink(backing);
+        }
         _segment_ds_reset(sm_seg);
     }
     return rc;
@@ -154,6 +274,7 @@ static int _mmap_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mo
     if (-1 == (sm_seg->seg_id = open(sm_seg->seg_name, mode))) {
         return PMIX_ERROR;
     }
+    sm_seg->seg_size = _mmap_map_size(sm_seg->seg_id, sm_seg->seg_size);
     if (MAP_FAILED == (sm_seg->seg_base_addr = (unsigned char *)
                 mmap(NULL, sm_seg->seg_size,
                     mmap_prot, MAP_SHARED,
@@ -196,6 +317,17 @@ static int _mmap_segment_detach(pmix_pshmem_seg_t *sm_seg)
 
 static int _mmap_segment_unlink(pmix_pshmem_seg_t *sm_seg)
 {
+    char backing[PMIX_PATH_MAX];
+    ssize_t len;
+
+    /* a link means the backing file was placed on a hugetlbfs mount */
+    if (0 < (len = readlink(sm_seg->seg_name, backing, sizeof(backing) - 1))) {
+        backing[len] = '\0';
+        if (-1 == unlink(backing)) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                    "sys call unlink(2) fail\n");
+        }
+    }
     if (-1 == unlink(sm_seg->seg_name)) {
         pmix_output_verbose(2, pmix_globals.debug_output,
                 "sys call unlink(2) fail\n");
@@ -17,7 +17,15 @@
 
 BEGIN_C_DECLS
 
-PMIX_EXPORT extern pmix_pshmem_base_component_t mca_pshmem_mmap_component;
+typedef struct {
+    pmix_pshmem_base_component_t super;
+    /* directory on a hugetlbfs mount to place the backing files in */
+    char *hugepage_path;
+    /* placement of the pages of the segments created by this process */
+    char *numa_policy;
+} pmix_pshmem_mmap_component_t;
+
+PMIX_EXPORT extern pmix_pshmem_mmap_component_t mca_pshmem_mmap_component;
 extern pmix_pshmem_base_module_t pmix_mmap_module;
 
 END_C_DECLS
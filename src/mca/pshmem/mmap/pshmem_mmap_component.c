@@ -35,6 +35,7 @@
 #include <src/mca/pshmem/pshmem.h>
 #include "pshmem_mmap.h"
 
+static pmix_status_t component_register(void);
 static pmix_status_t component_open(void);
 static pmix_status_t component_close(void);
 static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
@@ -43,28 +44,57 @@ static pmix_status_t component_query(pmix_mca_base_module_t **module, int *prior
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
  */
-pmix_pshmem_base_component_t mca_pshmem_mmap_component = {
-    .base = {
-        PMIX_PSHMEM_BASE_VERSION_1_0_0,
-
-        /* Component name and version */
-        .pmix_mca_component_name = "mmap",
-        PMIX_MCA_BASE_MAKE_VERSION(component,
-                                   PMIX_MAJOR_VERSION,
-                                   PMIX_MINOR_VERSION,
-                                   PMIX_RELEASE_VERSION),
-
-        /* Component open and close functions */
-        .pmix_mca_open_component = component_open,
-        .pmix_mca_close_component = component_close,
-        .pmix_mca_query_component = component_query,
+pmix_pshmem_mmap_component_t mca_pshmem_mmap_component = {
+    .super = {
+        .base = {
+            PMIX_PSHMEM_BASE_VERSION_1_0_0,
+
+            /* Component name and version */
+            .pmix_mca_component_name = "mmap",
+            PMIX_MCA_BASE_MAKE_VERSION(component,
+                                       PMIX_MAJOR_VERSION,
+                                       PMIX_MINOR_VERSION,
+                                       PMIX_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .pmix_mca_open_component = component_open,
+            .pmix_mca_close_component = component_close,
+            .pmix_mca_query_component = component_query,
+            .pmix_mca_register_component_params = component_register,
+        },
+        .data = {
+            /* The component is checkpoint ready */
+            PMIX_MCA_BASE_METADATA_PARAM_CHECKPOINT
+        }
     },
-    .data = {
-        /* The component is checkpoint ready */
-        PMIX_MCA_BASE_METADATA_PARAM_CHECKPOINT
-    }
+    .hugepage_path = NULL,
+    .numa_policy = "none"
 };
 
+static pmix_status_t component_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_pshmem_mmap_component.super.base;
+
+    (void)pmix_mca_base_component_var_register(component, "hugepage_path",
+                                               "Directory on a hugetlbfs mount to place the backing files "
+                                               "of the shared memory segments in, so they are mapped with "
+                                               "huge pages (default: none - use the session directory)",
+                                               PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_pshmem_mmap_component.hugepage_path);
+
+    (void)pmix_mca_base_component_var_register(component, "numa_policy",
+                                               "NUMA placement of the pages of the shared memory segments "
+                                               "created by this process: \"none\" (default) or \"interleave\" "
+                                               "across all NUMA nodes",
+                                               PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_pshmem_mmap_component.numa_policy);
+    return PMIX_SUCCESS;
+}
+
 
 static int component_open(void)
 {
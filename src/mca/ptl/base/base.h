@@ -34,6 +34,7 @@
 #include <string.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/mca/mca.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
@@ -73,13 +74,21 @@ PMIX_CLASS_DECLARATION(pmix_ptl_base_active_t);
 struct pmix_ptl_globals_t {
     pmix_list_t actives;
     bool initialized;
-    pmix_list_t posted_recvs;     // list of pmix_ptl_posted_recv_t
-    pmix_list_t unexpected_msgs;
+    /* posted recvs - one for each reserved tag, the ones waiting
+     * on a dynamic tag by tag, and the one taking any tag */
+    pmix_ptl_posted_recv_t *reserved_recvs[PMIX_PTL_TAG_DYNAMIC];
+    pmix_hash_table_t dynamic_recvs;
+    pmix_ptl_posted_recv_t *wildcard_recv;
+    /* msgs on a reserved tag that arrived before a recv was posted for it */
+    pmix_list_t unexpected_msgs[PMIX_PTL_TAG_DYNAMIC];
     int stop_thread[2];
     bool listen_thread_active;
     pmix_list_t listeners;
     uint32_t current_tag;
     size_t max_msg_size;
+    /* area the recv handlers read into */
+    char *recv_stage;
+    size_t recv_stage_size;
 };
 typedef struct pmix_ptl_globals_t pmix_ptl_globals_t;
 
@@ -101,6 +110,17 @@ PMIX_EXPORT pmix_status_t pmix_ptl_base_cancel_recv(struct pmix_peer_t *peer,
 PMIX_EXPORT pmix_status_t pmix_ptl_base_start_listening(pmix_info_t *info, size_t ninfo);
 PMIX_EXPORT void pmix_ptl_base_stop_listening(void);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_setup_fork(const pmix_proc_t *proc, char ***env);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_setup_peer(struct pmix_peer_t *peer);
+PMIX_EXPORT void pmix_ptl_base_deregister_client(const pmix_proc_t *proc);
+PMIX_EXPORT void pmix_ptl_base_deregister_nspace(const char *nspace);
+
+/* table of posted recvs - a tag holds a single recv, one posted
+ * on a tag already in use is refused with PMIX_EXISTS and left to
+ * the caller. A tag of UINT32_MAX takes any msg no other recv was
+ * posted for */
+PMIX_EXPORT pmix_status_t pmix_ptl_base_add_posted_recv(pmix_ptl_posted_recv_t *req);
+PMIX_EXPORT pmix_ptl_posted_recv_t* pmix_ptl_base_find_posted_recv(uint32_t tag);
+PMIX_EXPORT void pmix_ptl_base_remove_posted_recv(uint32_t tag);
 
 /* base support functions */
 PMIX_EXPORT void pmix_ptl_base_send(int sd, short args, void *cbdata);
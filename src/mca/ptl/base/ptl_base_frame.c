@@ -60,6 +60,7 @@ pmix_ptl_globals_t pmix_ptl_globals = {{{0}}};
 int pmix_ptl_base_output = -1;
 
 static size_t max_msg_size = PMIX_MAX_MSG_SIZE;
+static size_t recv_stage_size = 64;
 
 static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
 {
@@ -70,11 +71,27 @@ static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_SCOPE_READONLY,
                                &max_msg_size);
     pmix_ptl_globals.max_msg_size = max_msg_size * 1024 * 1024;
+
+    pmix_mca_base_var_register("pmix", "ptl", "base", "recv_stage_size",
+                               "Size (in Kbytes) of the area incoming msgs are read into - a single read can bring in as many msgs as fit",
+                               PMIX_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &recv_stage_size);
+    if (0 == recv_stage_size) {
+        recv_stage_size = 1;
+    }
+    pmix_ptl_globals.recv_stage_size = recv_stage_size * 1024;
     return PMIX_SUCCESS;
 }
 
 static pmix_status_t pmix_ptl_close(void)
 {
+    pmix_ptl_posted_recv_t *rcv;
+    uint32_t tag;
+    void *node, *next;
+    int n, rc;
+
     if (!pmix_ptl_globals.initialized) {
         return PMIX_SUCCESS;
     }
@@ -92,9 +109,29 @@ static pmix_status_t pmix_ptl_close(void)
 
     /* the components will cleanup when closed */
     PMIX_LIST_DESTRUCT(&pmix_ptl_globals.actives);
-    PMIX_LIST_DESTRUCT(&pmix_ptl_globals.posted_recvs);
-    PMIX_LIST_DESTRUCT(&pmix_ptl_globals.unexpected_msgs);
+    for (n=0; n < PMIX_PTL_TAG_DYNAMIC; n++) {
+        if (NULL != pmix_ptl_globals.reserved_recvs[n]) {
+            PMIX_RELEASE(pmix_ptl_globals.reserved_recvs[n]);
+        }
+        PMIX_LIST_DESTRUCT(&pmix_ptl_globals.unexpected_msgs[n]);
+    }
+    rc = pmix_hash_table_get_first_key_uint32(&pmix_ptl_globals.dynamic_recvs, &tag,
+                                              (void**)&rcv, &node);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_RELEASE(rcv);
+        rc = pmix_hash_table_get_next_key_uint32(&pmix_ptl_globals.dynamic_recvs, &tag,
+                                                 (void**)&rcv, node, &next);
+        node = next;
+    }
+    PMIX_DESTRUCT(&pmix_ptl_globals.dynamic_recvs);
+    if (NULL != pmix_ptl_globals.wildcard_recv) {
+        PMIX_RELEASE(pmix_ptl_globals.wildcard_recv);
+    }
     PMIX_LIST_DESTRUCT(&pmix_ptl_globals.listeners);
+    if (NULL != pmix_ptl_globals.recv_stage) {
+        free(pmix_ptl_globals.recv_stage);
+        pmix_ptl_globals.recv_stage = NULL;
+    }
 
     return pmix_mca_base_framework_components_close(&pmix_ptl_base_framework, NULL);
 }
@@ -102,12 +139,18 @@ static pmix_status_t pmix_ptl_close(void)
 static pmix_status_t pmix_ptl_open(pmix_mca_base_open_flag_t flags)
 {
     pmix_status_t rc;
+    int n;
 
     /* initialize globals */
     pmix_ptl_globals.initialized = true;
     PMIX_CONSTRUCT(&pmix_ptl_globals.actives, pmix_list_t);
-    PMIX_CONSTRUCT(&pmix_ptl_globals.posted_recvs, pmix_list_t);
-    PMIX_CONSTRUCT(&pmix_ptl_globals.unexpected_msgs, pmix_list_t);
+    for (n=0; n < PMIX_PTL_TAG_DYNAMIC; n++) {
+        pmix_ptl_globals.reserved_recvs[n] = NULL;
+        PMIX_CONSTRUCT(&pmix_ptl_globals.unexpected_msgs[n], pmix_list_t);
+    }
+    PMIX_CONSTRUCT(&pmix_ptl_globals.dynamic_recvs, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_ptl_globals.dynamic_recvs, 256);
+    pmix_ptl_globals.wildcard_recv = NULL;
     pmix_ptl_globals.listen_thread_active = false;
     PMIX_CONSTRUCT(&pmix_ptl_globals.listeners, pmix_list_t);
     pmix_ptl_globals.current_tag = PMIX_PTL_TAG_DYNAMIC;
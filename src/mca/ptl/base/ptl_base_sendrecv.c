@@ -22,6 +22,7 @@
 #include <string.h>
 #endif
 #include <fcntl.h>
+#include <limits.h>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -70,6 +71,9 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
     pmix_ptl_hdr_t hdr;
     pmix_proc_t proc;
     pmix_status_t rc;
+    uint32_t tag;
+    void *node, *next;
+    int n;
 
     /* stop all events */
     if (peer->recv_ev_active) {
@@ -239,9 +243,20 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
         /* must set the buffer type so it doesn't fail in unpack */
         buf.type = pmix_client_globals.myserver->nptr->compat.type;
         hdr.nbytes = 0; // initialize the hdr to something safe
-        PMIX_LIST_FOREACH(rcv, &pmix_ptl_globals.posted_recvs, pmix_ptl_posted_recv_t) {
-            if (UINT_MAX != rcv->tag && NULL != rcv->cbfunc) {
-                /* construct and load the buffer */
+        rc = pmix_hash_table_get_first_key_uint32(&pmix_ptl_globals.dynamic_recvs, &tag,
+                                                  (void**)&rcv, &node);
+        while (PMIX_SUCCESS == rc) {
+            if (NULL != rcv->cbfunc) {
+                hdr.tag = rcv->tag;
+                rcv->cbfunc(pmix_globals.mypeer, &hdr, &buf, rcv->cbdata);
+            }
+            rc = pmix_hash_table_get_next_key_uint32(&pmix_ptl_globals.dynamic_recvs, &tag,
+                                                     (void**)&rcv, node, &next);
+            node = next;
+        }
+        for (n=0; n < PMIX_PTL_TAG_DYNAMIC; n++) {
+            rcv = pmix_ptl_globals.reserved_recvs[n];
+            if (NULL != rcv && NULL != rcv->cbfunc) {
                 hdr.tag = rcv->tag;
                 rcv->cbfunc(pmix_globals.mypeer, &hdr, &buf, rcv->cbdata);
             }
@@ -254,31 +269,92 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
     }
 }
 
-static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
-{
-    struct iovec iov[2];
-    int iov_count;
-    ssize_t remain = msg->sdbytes, rc;
+/* the most segments we hand to a single writev - two per message */
+#if defined(IOV_MAX) && IOV_MAX < 1024
+#define PMIX_PTL_IOV_MAX  IOV_MAX
+#else
+#define PMIX_PTL_IOV_MAX  1024
+#endif
 
+/* add what remains to be sent of a message to the iovec */
+static int gather_msg(pmix_ptl_send_t *msg, struct iovec *iov, size_t *remain)
+{
     iov[0].iov_base = msg->sdptr;
     iov[0].iov_len = msg->sdbytes;
-    if (!msg->hdr_sent && NULL != msg->data) {
+    *remain += msg->sdbytes;
+    if (!msg->hdr_sent && NULL != msg->data && 0 < ntohl(msg->hdr.nbytes)) {
         iov[1].iov_base = msg->data->base_ptr;
         iov[1].iov_len = ntohl(msg->hdr.nbytes);
-        remain += ntohl(msg->hdr.nbytes);
-        iov_count = 2;
-    } else {
-        iov_count = 1;
+        *remain += ntohl(msg->hdr.nbytes);
+        return 2;
+    }
+    return 1;
+}
+
+/* account for nbytes of a message having been written - returns
+ * true once the entire message is gone */
+static bool consume_msg(pmix_ptl_send_t *msg, size_t *nbytes)
+{
+    if (!msg->hdr_sent) {
+        if (*nbytes < msg->sdbytes) {
+            /* partial write of the header */
+            msg->sdptr += *nbytes;
+            msg->sdbytes -= *nbytes;
+            *nbytes = 0;
+            return false;
+        }
+        *nbytes -= msg->sdbytes;
+        msg->hdr_sent = true;
+        if (NULL == msg->data || 0 == ntohl(msg->hdr.nbytes)) {
+            msg->sdptr += msg->sdbytes;
+            msg->sdbytes = 0;
+            return true;
+        }
+        msg->sdptr = (char*)msg->data->base_ptr;
+        msg->sdbytes = ntohl(msg->hdr.nbytes);
+    }
+    if (*nbytes < msg->sdbytes) {
+        /* partial write of the msg data */
+        msg->sdptr += *nbytes;
+        msg->sdbytes -= *nbytes;
+        *nbytes = 0;
+        return false;
     }
+    *nbytes -= msg->sdbytes;
+    msg->sdptr += msg->sdbytes;
+    msg->sdbytes = 0;
+    return true;
+}
+
+/* write the message on-deck along with as many of the queued ones
+ * as fit into a single writev, releasing each one that completes */
+static pmix_status_t send_msgs(int sd, pmix_peer_t *peer)
+{
+    struct iovec iov[PMIX_PTL_IOV_MAX];
+    int iov_count = 0;
+    size_t remain = 0, nbytes;
+    pmix_ptl_send_t *msg;
+    ssize_t rc;
+
+    msg = peer->send_msg;
+    while (1) {
+        iov_count += gather_msg(msg, &iov[iov_count], &remain);
+        if (PMIX_PTL_IOV_MAX < iov_count + 2) {
+            break;
+        }
+        if (msg == peer->send_msg) {
+            msg = (pmix_ptl_send_t*)pmix_list_get_first(&peer->send_queue);
+        } else {
+            msg = (pmix_ptl_send_t*)pmix_list_get_next(&msg->super);
+        }
+        if (msg == (pmix_ptl_send_t*)pmix_list_get_end(&peer->send_queue)) {
+            break;
+        }
+    }
+
   retry:
     rc = writev(sd, iov, iov_count);
-    if (PMIX_LIKELY(rc == remain)) {
-        /* we successfully sent the header and the msg data if any */
-        msg->hdr_sent = true;
-        msg->sdbytes = 0;
-        msg->sdptr = (char *)iov[iov_count-1].iov_base + iov[iov_count-1].iov_len;
-        return PMIX_SUCCESS;
-    } else if (rc < 0) {
+    if (rc < 0) {
         if (pmix_socket_errno == EINTR) {
             goto retry;
         } else if (pmix_socket_errno == EAGAIN) {
@@ -300,83 +376,22 @@ static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
                         pmix_socket_errno, sd);
             return PMIX_ERR_UNREACH;
         }
-    } else {
+    }
+
+    /* retire the messages that went out in full and move the next
+     * one in the queue into the "on-deck" position */
+    nbytes = rc;
+    while (NULL != peer->send_msg && consume_msg(peer->send_msg, &nbytes)) {
+        PMIX_RELEASE(peer->send_msg);
+        peer->send_msg = (pmix_ptl_send_t*)
+            pmix_list_remove_first(&peer->send_queue);
+    }
+    if (PMIX_UNLIKELY((size_t)rc < remain)) {
         /* short writev. This usually means the kernel buffer is full,
-         * so there is no point for retrying at that time.
-         * simply update the msg and return with PMIX_ERR_RESOURCE_BUSY */
-        if ((size_t)rc < msg->sdbytes) {
-            /* partial write of the header or the msg data */
-            msg->sdptr = (char *)msg->sdptr + rc;
-            msg->sdbytes -= rc;
-        } else {
-            /* header was fully written, but only a part of the msg data was written */
-            msg->hdr_sent = true;
-            rc -= msg->sdbytes;
-            if (NULL != msg->data) {
-                /* technically, this should never happen as iov_count
-                 * would be 1 for a zero-byte message, and so we cannot
-                 * have a case where we write the header and part of the
-                 * msg. However, code checkers don't know that and are
-                 * fooled by our earlier check for NULL, and so
-                 * we silence their warnings by using this check */
-                msg->sdptr = (char *)msg->data->base_ptr + rc;
-            }
-            msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
-        }
+         * so there is no point for retrying at that time */
         return PMIX_ERR_RESOURCE_BUSY;
     }
-}
-
-static pmix_status_t read_bytes(int sd, char **buf, size_t *remain)
-{
-    pmix_status_t ret = PMIX_SUCCESS;
-    int rc;
-    char *ptr = *buf;
-
-    /* read until all bytes recvd or error */
-    while (0 < *remain) {
-        rc = read(sd, ptr, *remain);
-        if (rc < 0) {
-            if(pmix_socket_errno == EINTR) {
-                continue;
-            } else if (pmix_socket_errno == EAGAIN) {
-                /* tell the caller to keep this message on active,
-                 * but let the event lib cycle so other messages
-                 * can progress while this socket is busy
-                 */
-                ret = PMIX_ERR_RESOURCE_BUSY;
-                goto exit;
-            } else if (pmix_socket_errno == EWOULDBLOCK) {
-                /* tell the caller to keep this message on active,
-                 * but let the event lib cycle so other messages
-                 * can progress while this socket is busy
-                 */
-                ret = PMIX_ERR_WOULD_BLOCK;
-                goto exit;
-            }
-            /* we hit an error and cannot progress this message - report
-             * the error back to the RML and let the caller know
-             * to abort this message
-             */
-            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "pmix_ptl_base_msg_recv: readv failed: %s (%d)",
-                                strerror(pmix_socket_errno),
-                                pmix_socket_errno);
-            ret = PMIX_ERR_UNREACH;
-            goto exit;
-        } else if (0 == rc) {
-            /* the remote peer closed the connection */
-            ret = PMIX_ERR_UNREACH;
-            goto exit;
-        }
-        /* we were able to read something, so adjust counters and location */
-        *remain -= rc;
-        ptr += rc;
-    }
-    /* we read the full data block */
-  exit:
-    *buf = ptr;
-    return ret;
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -404,12 +419,10 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
                             "ptl:base:send_handler SENDING MSG TO %s:%d TAG %u",
                             peer->info->pname.nspace, peer->info->pname.rank,
                             ntohl(msg->hdr.tag));
-        if (PMIX_SUCCESS == (rc = send_msg(peer->sd, msg))) {
-            // message is complete
+        if (PMIX_SUCCESS == (rc = send_msgs(peer->sd, peer))) {
+            // all gathered messages are complete
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:base:send_handler MSG SENT");
-            PMIX_RELEASE(msg);
-            peer->send_msg = NULL;
         } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
                    PMIX_ERR_WOULD_BLOCK == rc) {
             /* exit this event and let the event lib progress */
@@ -436,14 +449,11 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             return;
         }
 
-        /* if current message completed - progress any pending sends by
-         * moving the next in the queue into the "on-deck" position. Note
-         * that this doesn't mean we send the message right now - we will
-         * wait for another send_event to fire before doing so. This gives
-         * us a chance to service any pending recvs.
+        /* anything left in the queue beyond what fit into the writev
+         * is now on-deck - we will wait for another send_event to fire
+         * before sending it. This gives us a chance to service any
+         * pending recvs.
          */
-        peer->send_msg = (pmix_ptl_send_t*)
-            pmix_list_remove_first(&peer->send_queue);
     }
 
     /* if nothing else to do unregister for send event notifications */
@@ -456,18 +466,37 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
     PMIX_POST_OBJECT(peer);
 }
 
+/* hand a completely received message over for delivery */
+static void deliver_msg(pmix_peer_t *peer)
+{
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "%s:%d RECVD COMPLETE MESSAGE FROM SERVER OF %d BYTES FOR TAG %d ON PEER SOCKET %d",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        (int)peer->recv_msg->hdr.nbytes,
+                        peer->recv_msg->hdr.tag, peer->sd);
+    PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
+    peer->recv_msg = NULL;
+}
+
 /*
  * Dispatch to the appropriate action routine based on the state
  * of the connection with the peer.
+ *
+ * Everything the socket holds is read with a single readv: the rest
+ * of a message body already in progress goes straight to its final
+ * location, and whatever follows it lands in the staging area, from
+ * which the headers and bodies of as many messages as it covers are
+ * then taken. The handlers all run in the progress thread, so they
+ * share a single staging area.
  */
-
 void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
 {
-    pmix_status_t rc;
     pmix_peer_t *peer = (pmix_peer_t*)cbdata;
-    pmix_ptl_recv_t *msg = NULL;
-    pmix_ptl_hdr_t hdr;
-    size_t nbytes;
+    pmix_ptl_recv_t *msg;
+    struct iovec iov[2];
+    int iov_count = 0;
+    ssize_t rc;
+    size_t avail, nbytes;
     char *ptr;
 
     /* acquire the object */
@@ -482,125 +511,139 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     if (NULL == peer) {
         return;
     }
-    /* allocate a new message and setup for recv */
-    if (NULL == peer->recv_msg) {
-        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "ptl:base:recv:handler allocate new recv msg");
-        peer->recv_msg = PMIX_NEW(pmix_ptl_recv_t);
-        if (NULL == peer->recv_msg) {
-            pmix_output(0, "sptl:base:recv_handler: unable to allocate recv message\n");
+    if (NULL == pmix_ptl_globals.recv_stage) {
+        pmix_ptl_globals.recv_stage = (char*)malloc(pmix_ptl_globals.recv_stage_size);
+        if (NULL == pmix_ptl_globals.recv_stage) {
+            pmix_output(0, "sptl:base:recv_handler: unable to allocate recv staging area\n");
             goto err_close;
         }
-        PMIX_RETAIN(peer);
-        peer->recv_msg->peer = peer;  // provide a handle back to the peer object
-        /* start by reading the header */
-        peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
-        peer->recv_msg->rdbytes = sizeof(pmix_ptl_hdr_t);
     }
+
     msg = peer->recv_msg;
-    msg->sd = sd;
-    /* if the header hasn't been completely read, read it */
-    if (!msg->hdr_recvd) {
-         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "ptl:base:recv:handler read hdr on socket %d", peer->sd);
-        nbytes = sizeof(pmix_ptl_hdr_t);
-        ptr = (char*)&hdr;
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &ptr, &nbytes))) {
-            /* completed reading the header */
-            peer->recv_msg->hdr_recvd = true;
-            /* convert the hdr to host format */
-            peer->recv_msg->hdr.pindex = ntohl(hdr.pindex);
-            peer->recv_msg->hdr.tag = ntohl(hdr.tag);
-            peer->recv_msg->hdr.nbytes = ntohl(hdr.nbytes);
-            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "RECVD MSG FOR TAG %d SIZE %d",
-                                (int)peer->recv_msg->hdr.tag,
-                                (int)peer->recv_msg->hdr.nbytes);
-            /* if this is a zero-byte message, then we are done */
-            if (0 == peer->recv_msg->hdr.nbytes) {
-                pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                    "RECVD ZERO-BYTE MESSAGE FROM %s:%u for tag %d",
-                                    peer->info->pname.nspace, peer->info->pname.rank,
-                                    peer->recv_msg->hdr.tag);
-                peer->recv_msg->data = NULL;  // make sure
-                peer->recv_msg->rdptr = NULL;
-                peer->recv_msg->rdbytes = 0;
-                /* post it for delivery */
-                PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
-                peer->recv_msg = NULL;
-                PMIX_POST_OBJECT(peer);
-                return;
-            } else {
-                pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                    "ptl:base:recv:handler allocate data region of size %lu",
-                                    (unsigned long)peer->recv_msg->hdr.nbytes);
-                /* allocate the data region */
-                if (pmix_ptl_globals.max_msg_size < peer->recv_msg->hdr.nbytes) {
-                    pmix_show_help("help-pmix-runtime.txt", "ptl:msg_size", true,
-                                   (unsigned long)peer->recv_msg->hdr.nbytes,
-                                   (unsigned long)pmix_ptl_globals.max_msg_size);
-                    goto err_close;
-                }
-                peer->recv_msg->data = (char*)malloc(peer->recv_msg->hdr.nbytes);
-                memset(peer->recv_msg->data, 0, peer->recv_msg->hdr.nbytes);
-                /* point to it */
-                peer->recv_msg->rdptr = peer->recv_msg->data;
-                peer->recv_msg->rdbytes = peer->recv_msg->hdr.nbytes;
-            }
-            /* fall thru and attempt to read the data */
-        } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
-                   PMIX_ERR_WOULD_BLOCK == rc) {
+    if (NULL != msg && msg->hdr_recvd) {
+        iov[0].iov_base = msg->rdptr;
+        iov[0].iov_len = msg->rdbytes;
+        iov_count = 1;
+    }
+    iov[iov_count].iov_base = pmix_ptl_globals.recv_stage;
+    iov[iov_count].iov_len = pmix_ptl_globals.recv_stage_size;
+    ++iov_count;
+
+  retry:
+    rc = readv(peer->sd, iov, iov_count);
+    if (rc < 0) {
+        if (pmix_socket_errno == EINTR) {
+            goto retry;
+        } else if (pmix_socket_errno == EAGAIN ||
+                   pmix_socket_errno == EWOULDBLOCK) {
             /* exit this event and let the event lib progress */
+            PMIX_POST_OBJECT(peer);
             return;
-        } else {
-            /* the remote peer closed the connection - report that condition
-             * and let the caller know
-             */
-            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "ptl:base:msg_recv: peer %s:%d closed connection",
-                                peer->nptr->nspace, peer->info->pname.rank);
-            goto err_close;
+        }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "pmix_ptl_base_msg_recv: readv failed: %s (%d)",
+                            strerror(pmix_socket_errno),
+                            pmix_socket_errno);
+        goto err_close;
+    } else if (0 == rc) {
+        /* the remote peer closed the connection - report that condition
+         * and let the caller know
+         */
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "%s:%d ptl:base:msg_recv: peer %s:%d closed connection",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                            peer->nptr->nspace, peer->info->pname.rank);
+        goto err_close;
+    }
+    avail = rc;
+
+    /* account for what went directly into the message in progress */
+    if (1 < iov_count) {
+        nbytes = (avail < msg->rdbytes) ? avail : msg->rdbytes;
+        msg->rdptr += nbytes;
+        msg->rdbytes -= nbytes;
+        avail -= nbytes;
+        if (0 == msg->rdbytes) {
+            deliver_msg(peer);
         }
     }
 
-    if (peer->recv_msg->hdr_recvd) {
-        /* continue to read the data block - we start from
-         * wherever we left off, which could be at the
-         * beginning or somewhere in the message
-         */
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
-            /* we recvd all of the message */
+    /* take the messages out of the staging area */
+    ptr = pmix_ptl_globals.recv_stage;
+    while (0 < avail) {
+        if (NULL == peer->recv_msg) {
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "%s:%d RECVD COMPLETE MESSAGE FROM SERVER OF %d BYTES FOR TAG %d ON PEER SOCKET %d",
-                                pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                                (int)peer->recv_msg->hdr.nbytes,
-                                peer->recv_msg->hdr.tag, peer->sd);
-            /* post it for delivery */
-            PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
-            peer->recv_msg = NULL;
-            /* ensure we post the modified peer object before another thread
-             * picks it back up */
-            PMIX_POST_OBJECT(peer);
-            return;
-        } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
-                   PMIX_ERR_WOULD_BLOCK == rc) {
-            /* exit this event and let the event lib progress */
-            /* ensure we post the modified peer object before another thread
-             * picks it back up */
-            PMIX_POST_OBJECT(peer);
-            return;
-        } else {
-            /* the remote peer closed the connection - report that condition
-             * and let the caller know
-             */
+                                "ptl:base:recv:handler allocate new recv msg");
+            peer->recv_msg = PMIX_NEW(pmix_ptl_recv_t);
+            if (NULL == peer->recv_msg) {
+                pmix_output(0, "sptl:base:recv_handler: unable to allocate recv message\n");
+                goto err_close;
+            }
+            PMIX_RETAIN(peer);
+            peer->recv_msg->peer = peer;  // provide a handle back to the peer object
+            peer->recv_msg->sd = sd;
+            /* start by reading the header */
+            peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
+            peer->recv_msg->rdbytes = sizeof(pmix_ptl_hdr_t);
+        }
+        msg = peer->recv_msg;
+        nbytes = (avail < msg->rdbytes) ? avail : msg->rdbytes;
+        memcpy(msg->rdptr, ptr, nbytes);
+        msg->rdptr += nbytes;
+        msg->rdbytes -= nbytes;
+        ptr += nbytes;
+        avail -= nbytes;
+        if (0 < msg->rdbytes) {
+            /* the rest is still on its way */
+            break;
+        }
+        if (msg->hdr_recvd) {
+            deliver_msg(peer);
+            continue;
+        }
+
+        /* completed reading the header - convert it to host format */
+        msg->hdr_recvd = true;
+        msg->hdr.pindex = ntohl(msg->hdr.pindex);
+        msg->hdr.tag = ntohl(msg->hdr.tag);
+        msg->hdr.nbytes = ntohl(msg->hdr.nbytes);
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "RECVD MSG FOR TAG %d SIZE %d",
+                            (int)msg->hdr.tag, (int)msg->hdr.nbytes);
+        /* if this is a zero-byte message, then we are done */
+        if (0 == msg->hdr.nbytes) {
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "%s:%d ptl:base:msg_recv: peer %s:%d closed connection",
-                                pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                                peer->nptr->nspace, peer->info->pname.rank);
+                                "RECVD ZERO-BYTE MESSAGE FROM %s:%u for tag %d",
+                                peer->info->pname.nspace, peer->info->pname.rank,
+                                msg->hdr.tag);
+            msg->data = NULL;  // make sure
+            msg->rdptr = NULL;
+            msg->rdbytes = 0;
+            deliver_msg(peer);
+            continue;
+        }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:recv:handler allocate data region of size %lu",
+                            (unsigned long)msg->hdr.nbytes);
+        /* allocate the data region - it gets filled right away,
+         * so there is no need to clear it */
+        if (pmix_ptl_globals.max_msg_size < msg->hdr.nbytes) {
+            pmix_show_help("help-pmix-runtime.txt", "ptl:msg_size", true,
+                           (unsigned long)msg->hdr.nbytes,
+                           (unsigned long)pmix_ptl_globals.max_msg_size);
+            goto err_close;
+        }
+        msg->data = (char*)malloc(msg->hdr.nbytes);
+        if (NULL == msg->data) {
             goto err_close;
         }
+        /* point to it */
+        msg->rdptr = msg->data;
+        msg->rdbytes = msg->hdr.nbytes;
     }
-    /* success */
+    /* ensure we post the modified peer object before another thread
+     * picks it back up */
+    PMIX_POST_OBJECT(peer);
     return;
 
   err_close:
@@ -684,6 +727,8 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
     pmix_ptl_sr_t *ms = (pmix_ptl_sr_t*)cbdata;
     pmix_ptl_posted_recv_t *req;
     pmix_ptl_send_t *snd;
+    pmix_buffer_t buf;
+    pmix_ptl_hdr_t hdr;
     uint32_t tag;
 
     /* acquire the object */
@@ -721,10 +766,24 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
 
         pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                             "posting recv on tag %d", req->tag);
-        /* add it to the list of recvs - we cannot have unexpected messages
+        /* add it to the recvs - we cannot have unexpected messages
          * in this subsystem as the server never sends us something that
          * we didn't previously request */
-        pmix_list_prepend(&pmix_ptl_globals.posted_recvs, &req->super);
+        if (PMIX_SUCCESS != pmix_ptl_base_add_posted_recv(req)) {
+            /* the tag is still awaiting a reply, so ours couldn't
+             * be told apart - complete the request the way a lost
+             * connection does rather than leave the caller hanging */
+            PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+            buf.type = ms->peer->nptr->compat.type;
+            hdr.tag = tag;
+            hdr.nbytes = 0;
+            req->cbfunc(pmix_globals.mypeer, &hdr, &buf, req->cbdata);
+            PMIX_DESTRUCT(&buf);
+            PMIX_RELEASE(req);
+            PMIX_RELEASE(ms->bfr);
+            PMIX_RELEASE(ms);
+            return;
+        }
     }
 
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
@@ -772,41 +831,38 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                         (int)msg->hdr.nbytes, msg->hdr.tag, msg->sd);
 
     /* see if we have a waiting recv for this message */
-    PMIX_LIST_FOREACH(rcv, &pmix_ptl_globals.posted_recvs, pmix_ptl_posted_recv_t) {
+    rcv = pmix_ptl_base_find_posted_recv(msg->hdr.tag);
+    if (NULL != rcv) {
         pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                             "checking msg on tag %u for tag %u",
                             msg->hdr.tag, rcv->tag);
-
-        if (msg->hdr.tag == rcv->tag || UINT_MAX == rcv->tag) {
-            if (NULL != rcv->cbfunc) {
-                /* construct and load the buffer */
-                PMIX_CONSTRUCT(&buf, pmix_buffer_t);
-                if (NULL != msg->data) {
-                    PMIX_LOAD_BUFFER(msg->peer, &buf, msg->data, msg->hdr.nbytes);
-                } else {
-                    /* we need to at least set the buffer type so
-                     * unpack of a zero-byte message doesn't error */
-                    buf.type = msg->peer->nptr->compat.type;
-                }
-                msg->data = NULL;  // protect the data region
-                pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
-                                     "%s:%d EXECUTE CALLBACK for tag %u",
-                                     pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                                     msg->hdr.tag);
-                rcv->cbfunc(msg->peer, &msg->hdr, &buf, rcv->cbdata);
-                pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
-                                    "%s:%d CALLBACK COMPLETE",
-                                    pmix_globals.myid.nspace, pmix_globals.myid.rank);
-                PMIX_DESTRUCT(&buf);  // free's the msg data
-            }
-            /* done with the recv if it is a dynamic tag */
-            if (PMIX_PTL_TAG_DYNAMIC <= rcv->tag && UINT_MAX != rcv->tag) {
-                pmix_list_remove_item(&pmix_ptl_globals.posted_recvs, &rcv->super);
-                PMIX_RELEASE(rcv);
+        if (NULL != rcv->cbfunc) {
+            /* construct and load the buffer */
+            PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+            if (NULL != msg->data) {
+                PMIX_LOAD_BUFFER(msg->peer, &buf, msg->data, msg->hdr.nbytes);
+            } else {
+                /* we need to at least set the buffer type so
+                 * unpack of a zero-byte message doesn't error */
+                buf.type = msg->peer->nptr->compat.type;
             }
-            PMIX_RELEASE(msg);
-            return;
+            msg->data = NULL;  // protect the data region
+            pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
+                                 "%s:%d EXECUTE CALLBACK for tag %u",
+                                 pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                                 msg->hdr.tag);
+            rcv->cbfunc(msg->peer, &msg->hdr, &buf, rcv->cbdata);
+            pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
+                                "%s:%d CALLBACK COMPLETE",
+                                pmix_globals.myid.nspace, pmix_globals.myid.rank);
+            PMIX_DESTRUCT(&buf);  // free's the msg data
+        }
+        /* done with the recv if it is a dynamic tag */
+        if (PMIX_PTL_TAG_DYNAMIC <= rcv->tag && UINT32_MAX != rcv->tag) {
+            pmix_ptl_base_remove_posted_recv(rcv->tag);
         }
+        PMIX_RELEASE(msg);
+        return;
     }
 
     /* if the tag in this message is above the dynamic marker, then
@@ -822,7 +878,7 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
 
     /* it is possible that someone may post a recv for this message
      * at some point, so we have to hold onto it */
-    pmix_list_append(&pmix_ptl_globals.unexpected_msgs, &msg->super);
+    pmix_list_append(&pmix_ptl_globals.unexpected_msgs[msg->hdr.tag], &msg->super);
     /* ensure we post the modified object before another thread
      * picks it back up */
     PMIX_POST_OBJECT(msg);
@@ -50,9 +50,58 @@ pmix_status_t pmix_ptl_base_setup_fork(const pmix_proc_t *proc, char ***env)
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_ptl_base_setup_peer(struct pmix_peer_t *peer)
+{
+    pmix_ptl_base_active_t *active;
+
+    if (!pmix_ptl_globals.initialized) {
+        return PMIX_ERR_INIT;
+    }
+
+    PMIX_LIST_FOREACH(active, &pmix_ptl_globals.actives, pmix_ptl_base_active_t) {
+        if (NULL != active->component->setup_peer &&
+            PMIX_SUCCESS == active->component->setup_peer(peer)) {
+            return PMIX_SUCCESS;
+        }
+    }
+    /* stay on the socket */
+    return PMIX_ERR_TAKE_NEXT_OPTION;
+}
+
+void pmix_ptl_base_deregister_client(const pmix_proc_t *proc)
+{
+    pmix_ptl_base_active_t *active;
+
+    if (!pmix_ptl_globals.initialized) {
+        return;
+    }
+
+    PMIX_LIST_FOREACH(active, &pmix_ptl_globals.actives, pmix_ptl_base_active_t) {
+        if (NULL != active->component->deregister_client) {
+            active->component->deregister_client(proc);
+        }
+    }
+}
+
+void pmix_ptl_base_deregister_nspace(const char *nspace)
+{
+    pmix_ptl_base_active_t *active;
+
+    if (!pmix_ptl_globals.initialized) {
+        return;
+    }
+
+    PMIX_LIST_FOREACH(active, &pmix_ptl_globals.actives, pmix_ptl_base_active_t) {
+        if (NULL != active->component->deregister_nspace) {
+            active->component->deregister_nspace(nspace);
+        }
+    }
+}
+
 pmix_status_t pmix_ptl_base_set_notification_cbfunc(pmix_ptl_cbfunc_t cbfunc)
 {
     pmix_ptl_posted_recv_t *req;
+    pmix_status_t rc;
 
     /* post a persistent recv for the special 0 tag so the client can recv
      * error notifications from the server */
@@ -64,13 +113,81 @@ pmix_status_t pmix_ptl_base_set_notification_cbfunc(pmix_ptl_cbfunc_t cbfunc)
     req->cbfunc = cbfunc;
     pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                         "posting notification recv on tag %d", req->tag);
-    /* add it to the list of recvs - we cannot have unexpected messages
+    /* add it to the recvs - we cannot have unexpected messages
      * in this subsystem as the server never sends us something that
      * we didn't previously request */
-    pmix_list_prepend(&pmix_ptl_globals.posted_recvs, &req->super);
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_add_posted_recv(req))) {
+        PMIX_RELEASE(req);
+    }
+    return rc;
+}
+
+pmix_status_t pmix_ptl_base_add_posted_recv(pmix_ptl_posted_recv_t *req)
+{
+    pmix_ptl_posted_recv_t *old = NULL;
+
+    if (UINT32_MAX == req->tag) {
+        old = pmix_ptl_globals.wildcard_recv;
+    } else if (PMIX_PTL_TAG_DYNAMIC > req->tag) {
+        old = pmix_ptl_globals.reserved_recvs[req->tag];
+    } else if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pmix_ptl_globals.dynamic_recvs,
+                                                                 req->tag, (void**)&old)) {
+        old = NULL;
+    }
+    /* the recv posted first keeps the tag - it is the one
+     * that gets the msgs, a later one would never see any */
+    if (NULL != old) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "recv already posted on tag %u", req->tag);
+        return PMIX_EXISTS;
+    }
+
+    if (UINT32_MAX == req->tag) {
+        pmix_ptl_globals.wildcard_recv = req;
+    } else if (PMIX_PTL_TAG_DYNAMIC > req->tag) {
+        pmix_ptl_globals.reserved_recvs[req->tag] = req;
+    } else {
+        pmix_hash_table_set_value_uint32(&pmix_ptl_globals.dynamic_recvs, req->tag, req);
+    }
     return PMIX_SUCCESS;
 }
 
+pmix_ptl_posted_recv_t* pmix_ptl_base_find_posted_recv(uint32_t tag)
+{
+    pmix_ptl_posted_recv_t *rcv;
+
+    if (PMIX_PTL_TAG_DYNAMIC > tag) {
+        rcv = pmix_ptl_globals.reserved_recvs[tag];
+    } else if (UINT32_MAX == tag ||
+               PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pmix_ptl_globals.dynamic_recvs,
+                                                                 tag, (void**)&rcv)) {
+        rcv = NULL;
+    }
+    if (NULL == rcv) {
+        rcv = pmix_ptl_globals.wildcard_recv;
+    }
+    return rcv;
+}
+
+void pmix_ptl_base_remove_posted_recv(uint32_t tag)
+{
+    pmix_ptl_posted_recv_t *rcv = NULL;
+
+    if (UINT32_MAX == tag) {
+        rcv = pmix_ptl_globals.wildcard_recv;
+        pmix_ptl_globals.wildcard_recv = NULL;
+    } else if (PMIX_PTL_TAG_DYNAMIC > tag) {
+        rcv = pmix_ptl_globals.reserved_recvs[tag];
+        pmix_ptl_globals.reserved_recvs[tag] = NULL;
+    } else if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&pmix_ptl_globals.dynamic_recvs,
+                                                                 tag, (void**)&rcv)) {
+        pmix_hash_table_remove_value_uint32(&pmix_ptl_globals.dynamic_recvs, tag);
+    }
+    if (NULL != rcv) {
+        PMIX_RELEASE(rcv);
+    }
+}
+
 char* pmix_ptl_base_get_available_modules(void)
 {
     pmix_ptl_base_active_t *active;
@@ -127,17 +244,32 @@ static void post_recv(int fd, short args, void *cbdata)
     pmix_ptl_posted_recv_t *req = (pmix_ptl_posted_recv_t*)cbdata;
     pmix_ptl_recv_t *msg, *nmsg;
     pmix_buffer_t buf;
+    uint32_t tag, last;
 
     pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                         "posting recv on tag %d", req->tag);
 
-    /* add it to the list of recvs */
-    pmix_list_append(&pmix_ptl_globals.posted_recvs, &req->super);
+    /* add it to the recvs */
+    if (PMIX_SUCCESS != pmix_ptl_base_add_posted_recv(req)) {
+        PMIX_RELEASE(req);
+        return;
+    }
+
+    /* only msgs on reserved tags are held, so there is
+     * nothing to check for a recv on a dynamic tag */
+    if (UINT32_MAX == req->tag) {
+        tag = 0;
+        last = PMIX_PTL_TAG_DYNAMIC - 1;
+    } else if (PMIX_PTL_TAG_DYNAMIC > req->tag) {
+        tag = last = req->tag;
+    } else {
+        return;
+    }
 
-    /* now check the unexpected msg queue to see if we already
+    /* now check the unexpected msgs to see if we already
      * recvd something for it */
-    PMIX_LIST_FOREACH_SAFE(msg, nmsg, &pmix_ptl_globals.unexpected_msgs, pmix_ptl_recv_t) {
-        if (msg->hdr.tag == req->tag || UINT_MAX == req->tag) {
+    for (; tag <= last; tag++) {
+        PMIX_LIST_FOREACH_SAFE(msg, nmsg, &pmix_ptl_globals.unexpected_msgs[tag], pmix_ptl_recv_t) {
             if (NULL != req->cbfunc) {
                 /* construct and load the buffer */
                 PMIX_CONSTRUCT(&buf, pmix_buffer_t);
@@ -151,7 +283,7 @@ static void post_recv(int fd, short args, void *cbdata)
                 req->cbfunc(msg->peer, &msg->hdr, &buf, req->cbdata);
                 PMIX_DESTRUCT(&buf);  // free's the msg data
             }
-            pmix_list_remove_item(&pmix_ptl_globals.unexpected_msgs, &msg->super);
+            pmix_list_remove_item(&pmix_ptl_globals.unexpected_msgs[tag], &msg->super);
             PMIX_RELEASE(msg);
         }
     }
@@ -170,7 +302,7 @@ pmix_status_t pmix_ptl_base_register_recv(struct pmix_peer_t *peer,
     req->tag = tag;
     req->cbfunc = cbfunc;
     /* have to push this into an event so we can add this
-     * to the list of posted recvs */
+     * to the posted recvs */
     pmix_event_assign(&(req->ev), pmix_globals.evbase, -1,
                       EV_WRITE, post_recv, req);
     pmix_event_active(&(req->ev), EV_WRITE, 1);
@@ -180,16 +312,8 @@ pmix_status_t pmix_ptl_base_register_recv(struct pmix_peer_t *peer,
 static void cancel_recv(int fd, short args, void *cbdata)
 {
     pmix_ptl_posted_recv_t *req = (pmix_ptl_posted_recv_t*)cbdata;
-    pmix_ptl_posted_recv_t *rcv;
 
-    PMIX_LIST_FOREACH(rcv, &pmix_ptl_globals.posted_recvs, pmix_ptl_posted_recv_t) {
-        if (rcv->tag == req->tag) {
-            pmix_list_remove_item(&pmix_ptl_globals.posted_recvs, &rcv->super);
-            PMIX_RELEASE(rcv);
-            PMIX_RELEASE(req);
-            return;
-        }
-    }
+    pmix_ptl_base_remove_posted_recv(req->tag);
     PMIX_RELEASE(req);
 }
 
@@ -204,7 +328,7 @@ pmix_status_t pmix_ptl_base_cancel_recv(struct pmix_peer_t *peer,
     }
     req->tag = tag;
     /* have to push this into an event so we can modify
-     * the list of posted recvs */
+     * the posted recvs */
     pmix_event_assign(&(req->ev), pmix_globals.evbase, -1,
                       EV_WRITE, cancel_recv, req);
     pmix_event_active(&(req->ev), EV_WRITE, 1);
@@ -187,6 +187,20 @@ typedef pmix_status_t (*pmix_ptl_base_setup_listener_fn_t)(pmix_info_t info[], s
  * be passed to client procs upon fork */
 typedef pmix_status_t (*pmix_ptl_base_setup_fork_fn_t)(const pmix_proc_t *proc, char ***env);
 
+/* define a component-level API for taking over the messaging with a
+ * peer whose socket connection has just been established. The
+ * component assigns its own handlers to the peer's send/recv events
+ * and returns PMIX_SUCCESS, or returns PMIX_ERR_TAKE_NEXT_OPTION if it
+ * cannot carry the messages of this peer. On the server, this is
+ * called before the client is told that its connection was accepted */
+typedef pmix_status_t (*pmix_ptl_base_setup_peer_fn_t)(struct pmix_peer_t *peer);
+
+/* define component-level APIs for releasing whatever was setup for
+ * a client, or for all the clients of an nspace, when the host
+ * deregisters them */
+typedef void (*pmix_ptl_base_deregister_client_fn_t)(const pmix_proc_t *proc);
+typedef void (*pmix_ptl_base_deregister_nspace_fn_t)(const char *nspace);
+
 /*
  * the standard component data structure
  */
@@ -197,7 +211,9 @@ struct pmix_ptl_base_component_t {
     char*                                           uri;
     pmix_ptl_base_setup_listener_fn_t               setup_listener;
     pmix_ptl_base_setup_fork_fn_t                   setup_fork;
-
+    pmix_ptl_base_setup_peer_fn_t                   setup_peer;
+    pmix_ptl_base_deregister_client_fn_t            deregister_client;
+    pmix_ptl_base_deregister_nspace_fn_t            deregister_nspace;
 };
 typedef struct pmix_ptl_base_component_t pmix_ptl_base_component_t;
 
@@ -0,0 +1,457 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+#include <src/include/pmix_socket_errno.h>
+
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+#include "src/util/show_help.h"
+
+#include "src/mca/ptl/base/base.h"
+#include "src/mca/ptl/shm/ptl_shm.h"
+
+static pmix_status_t init(void);
+static void finalize(void);
+
+/* the socket transports establish the connection, so there
+ * is nothing to connect or send through this module */
+pmix_ptl_module_t pmix_ptl_shm_module = {
+    .init = init,
+    .finalize = finalize
+};
+
+static pmix_status_t init(void)
+{
+    return PMIX_SUCCESS;
+}
+
+static void finalize(void)
+{
+}
+
+static void epcon(pmix_ptl_shm_endpoint_t *p)
+{
+    memset(&p->proc, 0, sizeof(pmix_proc_t));
+    memset(&p->seg, 0, sizeof(pmix_pshmem_seg_t));
+    p->seg.seg_base_addr = (unsigned char*)MAP_FAILED;
+    p->hdr = NULL;
+    p->ring_size = 0;
+    p->in = NULL;
+    p->indata = NULL;
+    p->out = NULL;
+    p->outdata = NULL;
+    p->peer = NULL;
+    p->index = -1;
+    p->send_blocked = false;
+}
+static void epdes(pmix_ptl_shm_endpoint_t *p)
+{
+    pmix_ptl_shm_stop(p);
+    if (NULL == p->hdr) {
+        return;
+    }
+    /* only the creator removes the backing file */
+    if (0 != p->seg.seg_cpid) {
+        pmix_pshmem.segment_unlink(&p->seg);
+    }
+    pmix_pshmem.segment_detach(&p->seg);
+}
+PMIX_CLASS_INSTANCE(pmix_ptl_shm_endpoint_t,
+                    pmix_list_item_t,
+                    epcon, epdes);
+
+void pmix_ptl_shm_setup_rings(pmix_ptl_shm_endpoint_t *ep, bool server)
+{
+    char *data;
+    int in, out;
+
+    ep->hdr = (pmix_ptl_shm_seg_hdr_t*)ep->seg.seg_base_addr;
+    ep->ring_size = ep->hdr->ring_size;
+    data = (char*)ep->seg.seg_base_addr + sizeof(pmix_ptl_shm_seg_hdr_t);
+    in = server ? PMIX_PTL_SHM_TO_SERVER : PMIX_PTL_SHM_TO_CLIENT;
+    out = server ? PMIX_PTL_SHM_TO_CLIENT : PMIX_PTL_SHM_TO_SERVER;
+    ep->in = &ep->hdr->rings[in];
+    ep->indata = data + in * ep->ring_size;
+    ep->out = &ep->hdr->rings[out];
+    ep->outdata = data + out * ep->ring_size;
+}
+
+void pmix_ptl_shm_reset_segment(pmix_ptl_shm_endpoint_t *ep)
+{
+    int n;
+
+    for (n=0; n < 2; n++) {
+        ep->hdr->rings[n].head = 0;
+        ep->hdr->rings[n].blocked = 0;
+        ep->hdr->rings[n].tail = 0;
+        /* nobody reads yet, so the first message has to wake the consumer */
+        ep->hdr->rings[n].sleeping = 1;
+    }
+    pmix_atomic_wmb();
+    ep->hdr->state = PMIX_PTL_SHM_FREE;
+    ep->send_blocked = false;
+}
+
+/* copy as much of the data as fits into the ring - returns
+ * the number of bytes written */
+static size_t ring_write(pmix_ptl_shm_ring_t *ring, char *data, size_t size,
+                         const char *src, size_t len)
+{
+    uint64_t head = ring->head;
+    size_t space, off, n;
+
+    pmix_atomic_rmb();
+    space = size - (size_t)(head - ring->tail);
+    if (0 == space || 0 == len) {
+        return 0;
+    }
+    n = (len < space) ? len : space;
+    off = head % size;
+    if (n <= size - off) {
+        memcpy(data + off, src, n);
+    } else {
+        memcpy(data + off, src, size - off);
+        memcpy(data, src + (size - off), n - (size - off));
+    }
+    /* the data has to be visible before the consumer sees the new head */
+    pmix_atomic_wmb();
+    ring->head = head + n;
+    return n;
+}
+
+/* copy as much of the requested data as is available out of
+ * the ring - returns the number of bytes read */
+static size_t ring_read(pmix_ptl_shm_ring_t *ring, char *data, size_t size,
+                        char *dst, size_t len)
+{
+    uint64_t tail = ring->tail;
+    size_t avail, off, n;
+
+    avail = (size_t)(ring->head - tail);
+    pmix_atomic_rmb();
+    if (0 == avail || 0 == len) {
+        return 0;
+    }
+    n = (len < avail) ? len : avail;
+    off = tail % size;
+    if (n <= size - off) {
+        memcpy(dst, data + off, n);
+    } else {
+        memcpy(dst, data + off, size - off);
+        memcpy(dst + (size - off), data, n - (size - off));
+    }
+    /* finish reading before the producer may reuse the space */
+    pmix_atomic_mb();
+    ring->tail = tail + n;
+    return n;
+}
+
+static void ring_doorbell(pmix_ptl_shm_endpoint_t *ep)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)ep->peer;
+    char bell = 0;
+    ssize_t rc;
+
+    /* if the socket is full, the peer has unread wakeups anyway - and
+     * if it went away, our recv handler will notice */
+    do {
+        rc = write(peer->sd, &bell, 1);
+    } while (rc < 0 && EINTR == pmix_socket_errno);
+}
+
+static pmix_status_t send_msg(pmix_ptl_shm_endpoint_t *ep, pmix_ptl_send_t *msg,
+                              bool *produced)
+{
+    size_t n;
+
+    while (0 < msg->sdbytes) {
+        n = ring_write(ep->out, ep->outdata, ep->ring_size, msg->sdptr, msg->sdbytes);
+        if (0 == n) {
+            return PMIX_ERR_RESOURCE_BUSY;
+        }
+        *produced = true;
+        msg->sdptr += n;
+        msg->sdbytes -= n;
+        if (0 == msg->sdbytes && !msg->hdr_sent) {
+            msg->hdr_sent = true;
+            if (NULL != msg->data && 0 < ntohl(msg->hdr.nbytes)) {
+                msg->sdptr = msg->data->base_ptr;
+                msg->sdbytes = ntohl(msg->hdr.nbytes);
+            }
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static void send_handler(int sd, short flags, void *cbdata)
+{
+    pmix_ptl_shm_endpoint_t *ep = (pmix_ptl_shm_endpoint_t*)cbdata;
+    pmix_peer_t *peer = (pmix_peer_t*)ep->peer;
+    pmix_ptl_shm_ring_t *ring = ep->out;
+    pmix_ptl_send_t *msg;
+    bool produced = false;
+
+    /* acquire the object */
+    PMIX_ACQUIRE_OBJECT(peer);
+
+    /* unlike the socket, the ring takes all the queued
+     * messages it has room for in one go */
+    while (NULL != (msg = peer->send_msg)) {
+        if (PMIX_SUCCESS == send_msg(ep, msg, &produced)) {
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:shm:send_handler MSG SENT TO %s:%d TAG %u",
+                                peer->info->pname.nspace, peer->info->pname.rank,
+                                ntohl(msg->hdr.tag));
+            PMIX_RELEASE(msg);
+            peer->send_msg = (pmix_ptl_send_t*)pmix_list_remove_first(&peer->send_queue);
+            continue;
+        }
+        /* the ring is full - ask the consumer for a wakeup, but
+         * check again as it may have made room meanwhile */
+        ring->blocked = 1;
+        pmix_atomic_mb();
+        if ((size_t)(ring->head - ring->tail) == ep->ring_size) {
+            ep->send_blocked = true;
+            break;
+        }
+        (void)pmix_atomic_swap_32(&ring->blocked, 0);
+    }
+
+    if (produced) {
+        pmix_atomic_mb();
+        if (ring->sleeping && 1 == pmix_atomic_swap_32(&ring->sleeping, 0)) {
+            ring_doorbell(ep);
+        }
+    }
+
+    if (NULL == peer->send_msg || ep->send_blocked) {
+        pmix_event_del(&peer->send_event);
+        /* while we wait for room the event stays marked as active
+         * so that new messages are only queued */
+        peer->send_ev_active = ep->send_blocked;
+    }
+    /* ensure we post the modified peer object before another thread
+     * picks it back up */
+    PMIX_POST_OBJECT(peer);
+}
+
+/* pull all complete messages out of the ring */
+static pmix_status_t recv_msgs(pmix_ptl_shm_endpoint_t *ep)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)ep->peer;
+    pmix_ptl_shm_ring_t *ring = ep->in;
+    pmix_ptl_recv_t *msg;
+    bool consumed = false;
+    size_t n;
+
+    while (1) {
+        if (NULL == peer->recv_msg) {
+            peer->recv_msg = PMIX_NEW(pmix_ptl_recv_t);
+            if (NULL == peer->recv_msg) {
+                return PMIX_ERR_NOMEM;
+            }
+            PMIX_RETAIN(peer);
+            peer->recv_msg->peer = peer;  // provide a handle back to the peer object
+            /* start by reading the header */
+            peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
+            peer->recv_msg->rdbytes = sizeof(pmix_ptl_hdr_t);
+        }
+        msg = peer->recv_msg;
+        msg->sd = peer->sd;
+
+        n = ring_read(ring, ep->indata, ep->ring_size, msg->rdptr, msg->rdbytes);
+        if (0 < n) {
+            consumed = true;
+            msg->rdptr += n;
+            msg->rdbytes -= n;
+        }
+        if (0 < msg->rdbytes) {
+            /* the ring is empty - tell the producer we need a wakeup,
+             * but check again as it may have written meanwhile */
+            ring->sleeping = 1;
+            pmix_atomic_mb();
+            if (ring->head == ring->tail) {
+                break;
+            }
+            (void)pmix_atomic_swap_32(&ring->sleeping, 0);
+            continue;
+        }
+
+        if (!msg->hdr_recvd) {
+            /* completed reading the header - convert it to host format */
+            msg->hdr_recvd = true;
+            msg->hdr.pindex = ntohl(msg->hdr.pindex);
+            msg->hdr.tag = ntohl(msg->hdr.tag);
+            msg->hdr.nbytes = ntohl(msg->hdr.nbytes);
+            if (0 < msg->hdr.nbytes) {
+                if (pmix_ptl_globals.max_msg_size < msg->hdr.nbytes) {
+                    pmix_show_help("help-pmix-runtime.txt", "ptl:msg_size", true,
+                                   (unsigned long)msg->hdr.nbytes,
+                                   (unsigned long)pmix_ptl_globals.max_msg_size);
+                    return PMIX_ERR_UNREACH;
+                }
+                msg->data = (char*)malloc(msg->hdr.nbytes);
+                if (NULL == msg->data) {
+                    return PMIX_ERR_NOMEM;
+                }
+                msg->rdptr = msg->data;
+                msg->rdbytes = msg->hdr.nbytes;
+                continue;
+            }
+            msg->data = NULL;  // make sure
+            msg->rdptr = NULL;
+        }
+
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "%s:%d ptl:shm RECVD COMPLETE MESSAGE OF %d BYTES FOR TAG %d",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                            (int)msg->hdr.nbytes, msg->hdr.tag);
+        /* post it for delivery */
+        PMIX_ACTIVATE_POST_MSG(msg);
+        peer->recv_msg = NULL;
+    }
+
+    if (consumed) {
+        pmix_atomic_mb();
+        if (ring->blocked && 1 == pmix_atomic_swap_32(&ring->blocked, 0)) {
+            ring_doorbell(ep);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static void recv_handler(int sd, short flags, void *cbdata)
+{
+    pmix_ptl_shm_endpoint_t *ep = (pmix_ptl_shm_endpoint_t*)cbdata;
+    pmix_peer_t *peer = (pmix_peer_t*)ep->peer;
+    char bells[64];
+    ssize_t rc;
+
+    /* acquire the object */
+    PMIX_ACQUIRE_OBJECT(peer);
+
+    /* the socket only carries wakeups - drain them */
+    while (1) {
+        rc = read(sd, bells, sizeof(bells));
+        if (0 < rc) {
+            continue;
+        }
+        if (0 == rc) {
+            /* the remote peer closed the connection */
+            goto err_close;
+        }
+        if (EINTR == pmix_socket_errno) {
+            continue;
+        }
+        if (EAGAIN == pmix_socket_errno || EWOULDBLOCK == pmix_socket_errno) {
+            break;
+        }
+        goto err_close;
+    }
+
+    if (PMIX_SUCCESS != recv_msgs(ep)) {
+        goto err_close;
+    }
+
+    /* the wakeup may have been for room in our ring */
+    if (ep->send_blocked) {
+        ep->send_blocked = false;
+        (void)pmix_atomic_swap_32(&ep->out->blocked, 0);
+        pmix_event_add(&peer->send_event, 0);
+    }
+    /* ensure we post the modified peer object before another thread
+     * picks it back up */
+    PMIX_POST_OBJECT(peer);
+    return;
+
+  err_close:
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "%s:%d ptl:shm: peer %s:%d closed connection",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        peer->info->pname.nspace, peer->info->pname.rank);
+    /* stop all events */
+    if (peer->recv_ev_active) {
+        pmix_event_del(&peer->recv_event);
+        peer->recv_ev_active = false;
+    }
+    if (peer->send_ev_active) {
+        pmix_event_del(&peer->send_event);
+        peer->send_ev_active = false;
+    }
+    if (NULL != peer->recv_msg) {
+        PMIX_RELEASE(peer->recv_msg);
+        peer->recv_msg = NULL;
+    }
+    /* the segment can serve the next incarnation of the client - keep
+     * the peer alive until the connection loss has been handled */
+    PMIX_RETAIN(peer);
+    pmix_ptl_shm_stop(ep);
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        pmix_ptl_shm_reset_segment(ep);
+    }
+    pmix_ptl_base_lost_connection(peer, PMIX_ERR_UNREACH);
+    /* ensure we post the modified peer object before another thread
+     * picks it back up */
+    PMIX_POST_OBJECT(peer);
+    PMIX_RELEASE(peer);
+}
+
+void pmix_ptl_shm_start(pmix_ptl_shm_endpoint_t *ep, struct pmix_peer_t *pr)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)pr;
+
+    PMIX_RETAIN(peer);
+    ep->peer = pr;
+    ep->index = peer->index;
+    ep->send_blocked = false;
+
+    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, peer->sd,
+                      EV_READ|EV_PERSIST, recv_handler, ep);
+    pmix_event_add(&peer->recv_event, NULL);
+    peer->recv_ev_active = true;
+    pmix_event_assign(&peer->send_event, pmix_globals.evbase, peer->sd,
+                      EV_WRITE|EV_PERSIST, send_handler, ep);
+    peer->send_ev_active = false;
+    PMIX_POST_OBJECT(peer);
+}
+
+void pmix_ptl_shm_stop(pmix_ptl_shm_endpoint_t *ep)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)ep->peer;
+
+    if (NULL == peer) {
+        return;
+    }
+    /* the events must not refer to the endpoint once it is gone */
+    if (peer->recv_ev_active) {
+        pmix_event_del(&peer->recv_event);
+        peer->recv_ev_active = false;
+    }
+    if (peer->send_ev_active) {
+        pmix_event_del(&peer->send_event);
+        peer->send_ev_active = false;
+    }
+    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, peer->sd,
+                      EV_READ|EV_PERSIST, pmix_ptl_base_recv_handler, peer);
+    pmix_event_assign(&peer->send_event, pmix_globals.evbase, peer->sd,
+                      EV_WRITE|EV_PERSIST, pmix_ptl_base_send_handler, peer);
+    ep->peer = NULL;
+    ep->index = -1;
+    ep->send_blocked = false;
+    PMIX_RELEASE(peer);
+}
@@ -0,0 +1,113 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_PTL_SHM_H
+#define PMIX_PTL_SHM_H
+
+#include <src/include/pmix_config.h>
+
+#include "src/atomics/sys/atomic.h"
+#include "src/class/pmix_list.h"
+#include "src/mca/pshmem/pshmem.h"
+#include "src/mca/ptl/ptl.h"
+
+BEGIN_C_DECLS
+
+/* The shm transport carries the messages between a server and its
+ * local clients over a pair of single-producer/single-consumer rings
+ * in a segment the server creates for each client at fork. The socket
+ * the client connected on is kept, but after the connection handshake
+ * it only carries wakeups: a byte is written to it when the other side
+ * announced that it waits for data or for room in a ring. A busy
+ * connection thus moves its messages without any syscall */
+
+#define PMIX_PTL_SHM_CACHELINE  64
+
+/* the control words of a ring - each side writes its own line */
+typedef struct {
+    /* producer: bytes written so far and whether it waits for room */
+    volatile uint64_t head;
+    pmix_atomic_int32_t blocked;
+    char pad1[PMIX_PTL_SHM_CACHELINE - sizeof(uint64_t) - sizeof(int32_t)];
+    /* consumer: bytes read so far and whether it waits for data */
+    volatile uint64_t tail;
+    pmix_atomic_int32_t sleeping;
+    char pad2[PMIX_PTL_SHM_CACHELINE - sizeof(uint64_t) - sizeof(int32_t)];
+} pmix_ptl_shm_ring_t;
+
+/* states of a segment */
+#define PMIX_PTL_SHM_FREE       0
+#define PMIX_PTL_SHM_CLAIMED    1   // a client wants to use it
+#define PMIX_PTL_SHM_ACCEPTED   2   // the server uses it for that client
+
+/* direction of the rings */
+#define PMIX_PTL_SHM_TO_SERVER  0
+#define PMIX_PTL_SHM_TO_CLIENT  1
+
+/* start of the segment - the data of the two rings follows */
+typedef struct {
+    pmix_atomic_int32_t state;
+    uint32_t ring_size;
+    char pad[PMIX_PTL_SHM_CACHELINE - 2 * sizeof(uint32_t)];
+    pmix_ptl_shm_ring_t rings[2];
+} pmix_ptl_shm_seg_hdr_t;
+
+/* one side of a connection carried over a segment */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t proc;
+    pmix_pshmem_seg_t seg;
+    pmix_ptl_shm_seg_hdr_t *hdr;
+    size_t ring_size;
+    pmix_ptl_shm_ring_t *in;
+    char *indata;
+    pmix_ptl_shm_ring_t *out;
+    char *outdata;
+    /* the peer the messages are exchanged with - retained, so the
+     * server can safely check it against its array of clients */
+    struct pmix_peer_t *peer;
+    int index;
+    /* the out ring is full and we wait for a wakeup */
+    bool send_blocked;
+} pmix_ptl_shm_endpoint_t;
+PMIX_CLASS_DECLARATION(pmix_ptl_shm_endpoint_t);
+
+typedef struct {
+    pmix_ptl_base_component_t super;
+    int ring_size;
+    /* server: one endpoint for each client it forked */
+    pmix_list_t endpoints;
+    /* client: the endpoint to our server, if any */
+    pmix_ptl_shm_endpoint_t *server;
+    bool pshmem_open;
+} pmix_ptl_shm_component_t;
+
+extern pmix_ptl_shm_component_t mca_ptl_shm_component;
+
+extern pmix_ptl_module_t pmix_ptl_shm_module;
+
+/* size of a segment holding rings of the given size */
+#define PMIX_PTL_SHM_SEG_SIZE(r)  (sizeof(pmix_ptl_shm_seg_hdr_t) + 2 * (r))
+
+/* point the endpoint at the rings of its mapped segment */
+void pmix_ptl_shm_setup_rings(pmix_ptl_shm_endpoint_t *ep, bool server);
+
+/* put the segment back into its initial state */
+void pmix_ptl_shm_reset_segment(pmix_ptl_shm_endpoint_t *ep);
+
+/* let the endpoint carry the messages of the peer */
+void pmix_ptl_shm_start(pmix_ptl_shm_endpoint_t *ep, struct pmix_peer_t *peer);
+
+/* hand the messages of the peer, if any, back to the socket
+ * handlers and drop the endpoint's reference to it */
+void pmix_ptl_shm_stop(pmix_ptl_shm_endpoint_t *ep);
+
+END_C_DECLS
+
+#endif /* PMIX_PTL_SHM_H */
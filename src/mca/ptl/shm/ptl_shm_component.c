@@ -0,0 +1,336 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include <src/include/pmix_config.h>
+#include "pmix_common.h"
+
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/server/pmix_server_ops.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+#include "src/util/pmix_environ.h"
+#include "src/mca/pshmem/base/base.h"
+
+#include "src/mca/ptl/base/base.h"
+#include "src/mca/ptl/shm/ptl_shm.h"
+
+static int component_register(void);
+static pmix_status_t component_open(void);
+static pmix_status_t component_close(void);
+static int component_query(pmix_mca_base_module_t **module, int *priority);
+static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env);
+static pmix_status_t setup_peer(struct pmix_peer_t *peer);
+static void deregister_client(const pmix_proc_t *proc);
+static void deregister_nspace(const char *nspace);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+PMIX_EXPORT pmix_ptl_shm_component_t mca_ptl_shm_component = {
+    .super = {
+        .base = {
+            PMIX_PTL_BASE_VERSION_1_0_0,
+
+            /* Component name and version */
+            .pmix_mca_component_name = "shm",
+            PMIX_MCA_BASE_MAKE_VERSION(component,
+                                       PMIX_MAJOR_VERSION,
+                                       PMIX_MINOR_VERSION,
+                                       PMIX_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .pmix_mca_open_component = component_open,
+            .pmix_mca_close_component = component_close,
+            .pmix_mca_register_component_params = component_register,
+            .pmix_mca_query_component = component_query
+        },
+        /* never chosen to connect - the socket transports do that */
+        .priority = 5,
+        .uri = NULL,
+        .setup_fork = setup_fork,
+        .setup_peer = setup_peer,
+        .deregister_client = deregister_client,
+        .deregister_nspace = deregister_nspace
+    },
+    .ring_size = 65536,
+    .server = NULL,
+    .pshmem_open = false
+};
+
+static int component_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_ptl_shm_component.super.base;
+
+    (void)pmix_mca_base_component_var_register(component, "ring_size",
+                                               "Size in bytes of each of the two rings between the server and a local client",
+                                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_ptl_shm_component.ring_size);
+    if (mca_ptl_shm_component.ring_size < PMIX_PTL_SHM_CACHELINE) {
+        mca_ptl_shm_component.ring_size = PMIX_PTL_SHM_CACHELINE;
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t component_open(void)
+{
+    PMIX_CONSTRUCT(&mca_ptl_shm_component.endpoints, pmix_list_t);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t component_close(void)
+{
+    PMIX_LIST_DESTRUCT(&mca_ptl_shm_component.endpoints);
+    if (NULL != mca_ptl_shm_component.server) {
+        PMIX_RELEASE(mca_ptl_shm_component.server);
+        mca_ptl_shm_component.server = NULL;
+    }
+    if (mca_ptl_shm_component.pshmem_open) {
+        (void)pmix_mca_base_framework_close(&pmix_pshmem_base_framework);
+        mca_ptl_shm_component.pshmem_open = false;
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t open_pshmem(void)
+{
+    pmix_status_t rc;
+
+    if (mca_ptl_shm_component.pshmem_open) {
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_mca_base_framework_open(&pmix_pshmem_base_framework, 0))) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_pshmem_base_select())) {
+        (void)pmix_mca_base_framework_close(&pmix_pshmem_base_framework);
+        return rc;
+    }
+    mca_ptl_shm_component.pshmem_open = true;
+    return PMIX_SUCCESS;
+}
+
+/* a client claims the segment its server created for it before it
+ * connects, so the server knows it can hand the connection over */
+static pmix_status_t claim_segment(void)
+{
+    pmix_ptl_shm_endpoint_t *ep;
+    char *file, *evar;
+    size_t size;
+    int32_t state = PMIX_PTL_SHM_FREE;
+
+    if (NULL == (file = getenv("PMIX_PTL_SHM_SEGMENT")) ||
+        NULL == (evar = getenv("PMIX_PTL_SHM_SEGMENT_SIZE"))) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    size = strtoul(evar, NULL, 10);
+    if (size < sizeof(pmix_ptl_shm_seg_hdr_t) ||
+        PMIX_PATH_MAX <= strlen(file) ||
+        PMIX_SUCCESS != open_pshmem()) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+
+    ep = PMIX_NEW(pmix_ptl_shm_endpoint_t);
+    pmix_strncpy(ep->seg.seg_name, file, PMIX_PATH_MAX-1);
+    ep->seg.seg_size = size;
+    if (PMIX_SUCCESS != pmix_pshmem.segment_attach(&ep->seg, PMIX_PSHMEM_RW)) {
+        PMIX_RELEASE(ep);
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    pmix_ptl_shm_setup_rings(ep, false);
+    if (size < PMIX_PTL_SHM_SEG_SIZE(ep->ring_size) ||
+        !pmix_atomic_compare_exchange_strong_32(&ep->hdr->state, &state,
+                                                PMIX_PTL_SHM_CLAIMED)) {
+        /* someone else already uses it - likely a process we were
+         * forked from that is known to the server under our name */
+        PMIX_RELEASE(ep);
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    pmix_atomic_mb();
+    mca_ptl_shm_component.server = ep;
+    return PMIX_SUCCESS;
+}
+
+static int component_query(pmix_mca_base_module_t **module, int *priority)
+{
+    if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
+        PMIX_SUCCESS != claim_segment()) {
+        *module = NULL;
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    *priority = mca_ptl_shm_component.super.priority;
+    *module = (pmix_mca_base_module_t*)&pmix_ptl_shm_module;
+    return PMIX_SUCCESS;
+}
+
+static pmix_ptl_shm_endpoint_t* find_endpoint(const char *nspace, pmix_rank_t rank)
+{
+    pmix_ptl_shm_endpoint_t *ep;
+
+    PMIX_LIST_FOREACH(ep, &mca_ptl_shm_component.endpoints, pmix_ptl_shm_endpoint_t) {
+        if (ep->proc.rank == rank && PMIX_CHECK_NSPACE(ep->proc.nspace, nspace)) {
+            return ep;
+        }
+    }
+    return NULL;
+}
+
+/* the endpoint holds a reference to its peer, so the address
+ * can't be reused by another client while we compare it */
+static bool in_use(pmix_ptl_shm_endpoint_t *ep)
+{
+    if (NULL == ep->peer) {
+        return false;
+    }
+    if (ep->peer == pmix_pointer_array_get_item(&pmix_server_globals.clients, ep->index)) {
+        return true;
+    }
+    /* the client went away without our handler noticing */
+    pmix_ptl_shm_stop(ep);
+    pmix_ptl_shm_reset_segment(ep);
+    return false;
+}
+
+/* the destructor detaches the peer and removes the backing file */
+static void release_endpoint(pmix_ptl_shm_endpoint_t *ep)
+{
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:shm: releasing segment %s of %s:%u",
+                        ep->seg.seg_name, ep->proc.nspace, ep->proc.rank);
+    pmix_list_remove_item(&mca_ptl_shm_component.endpoints, &ep->super);
+    PMIX_RELEASE(ep);
+}
+
+static void deregister_client(const pmix_proc_t *proc)
+{
+    pmix_ptl_shm_endpoint_t *ep;
+
+    if (NULL != (ep = find_endpoint(proc->nspace, proc->rank))) {
+        release_endpoint(ep);
+    }
+}
+
+static void deregister_nspace(const char *nspace)
+{
+    pmix_ptl_shm_endpoint_t *ep, *next;
+
+    PMIX_LIST_FOREACH_SAFE(ep, next, &mca_ptl_shm_component.endpoints, pmix_ptl_shm_endpoint_t) {
+        if (PMIX_CHECK_NSPACE(ep->proc.nspace, nspace)) {
+            release_endpoint(ep);
+        }
+    }
+}
+
+static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env)
+{
+    pmix_ptl_shm_endpoint_t *ep;
+    char *file, size[32];
+    size_t segsize;
+
+    if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) ||
+        NULL == pmix_server_globals.tmpdir) {
+        return PMIX_SUCCESS;
+    }
+
+    if (NULL != (ep = find_endpoint(proc->nspace, proc->rank))) {
+        if (in_use(ep)) {
+            /* a proc of that name is connected - leave the
+             * new one on the socket */
+            return PMIX_SUCCESS;
+        }
+        pmix_ptl_shm_reset_segment(ep);
+    } else {
+        if (PMIX_SUCCESS != open_pshmem()) {
+            return PMIX_SUCCESS;
+        }
+        if (0 > asprintf(&file, "%s/pmix_ptl_shm.%lu.%s.%u", pmix_server_globals.tmpdir,
+                         (unsigned long)getpid(), proc->nspace, proc->rank)) {
+            return PMIX_ERR_NOMEM;
+        }
+        ep = PMIX_NEW(pmix_ptl_shm_endpoint_t);
+        PMIX_LOAD_PROCID(&ep->proc, proc->nspace, proc->rank);
+        segsize = PMIX_PTL_SHM_SEG_SIZE((size_t)mca_ptl_shm_component.ring_size);
+        if (PMIX_SUCCESS != pmix_pshmem.segment_create(&ep->seg, file, segsize)) {
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:shm: cannot create segment %s - %s:%u stays on the socket",
+                                file, proc->nspace, proc->rank);
+            free(file);
+            PMIX_RELEASE(ep);
+            return PMIX_SUCCESS;
+        }
+        free(file);
+        ((pmix_ptl_shm_seg_hdr_t*)ep->seg.seg_base_addr)->ring_size = mca_ptl_shm_component.ring_size;
+        pmix_ptl_shm_setup_rings(ep, true);
+        pmix_ptl_shm_reset_segment(ep);
+        pmix_list_append(&mca_ptl_shm_component.endpoints, &ep->super);
+    }
+
+    pmix_setenv("PMIX_PTL_SHM_SEGMENT", ep->seg.seg_name, true, env);
+    snprintf(size, sizeof(size), "%lu", (unsigned long)ep->seg.seg_size);
+    pmix_setenv("PMIX_PTL_SHM_SEGMENT_SIZE", size, true, env);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t setup_peer(struct pmix_peer_t *pr)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)pr;
+    pmix_ptl_shm_endpoint_t *ep;
+    int32_t state = PMIX_PTL_SHM_CLAIMED;
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        ep = find_endpoint(peer->info->pname.nspace, peer->info->pname.rank);
+        if (NULL == ep || in_use(ep)) {
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+        /* only take the connection over if the client claimed the segment */
+        pmix_atomic_mb();
+        if (!pmix_atomic_compare_exchange_strong_32(&ep->hdr->state, &state,
+                                                    PMIX_PTL_SHM_ACCEPTED)) {
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+        pmix_atomic_mb();
+    } else {
+        ep = mca_ptl_shm_component.server;
+        if (NULL == ep || NULL != ep->peer) {
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+        /* the server marked the segment before it replied */
+        pmix_atomic_rmb();
+        if (PMIX_PTL_SHM_ACCEPTED != ep->hdr->state) {
+            /* give it back */
+            (void)pmix_atomic_compare_exchange_strong_32(&ep->hdr->state, &state,
+                                                         PMIX_PTL_SHM_FREE);
+            PMIX_RELEASE(ep);
+            mca_ptl_shm_component.server = NULL;
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+    }
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:shm: messages with %s:%u go through %s",
+                        peer->info->pname.nspace, peer->info->pname.rank,
+                        ep->seg.seg_name);
+    pmix_ptl_shm_start(ep, pr);
+    return PMIX_SUCCESS;
+}
@@ -642,6 +642,12 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
 
     pmix_ptl_base_set_nonblocking(sd);
 
+    /* if the server handed the connection over to another
+     * transport, then that one has setup the events */
+    if (PMIX_SUCCESS == pmix_ptl_base_setup_peer(pmix_client_globals.myserver)) {
+        goto cleanup;
+    }
+
     /* setup recv event */
     pmix_event_assign(&pmix_client_globals.myserver->recv_event,
                       pmix_globals.evbase,
@@ -1260,6 +1266,16 @@ static pmix_status_t recv_connect_ack(int sd, uint8_t myflag)
         } else if (PMIX_SUCCESS != reply) {
             return reply;
         }
+        /* that was the result of the credential check - the
+         * server follows up with the status of the connection */
+        rc = pmix_ptl_base_recv_blocking(sd, (char*)&u32, sizeof(uint32_t));
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        reply = ntohl(u32);
+        if (PMIX_SUCCESS != reply) {
+            return reply;
+        }
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "pmix: RECV CONNECT CONFIRMATION");
 
@@ -964,7 +964,7 @@ static void connection_handler(int sd, short args, void *cbdata)
     char *nspace;
     uint32_t len, u32;
     size_t cnt, msglen, n;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     bool found;
     pmix_rank_info_t *info;
     pmix_proc_t proc;
@@ -972,6 +972,7 @@ static void connection_handler(int sd, short args, void *cbdata)
     pmix_proc_type_t proc_type;
     pmix_byte_object_t cred;
     pmix_buffer_t buf;
+    bool handed_over;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(pnd);
@@ -1343,13 +1344,7 @@ static void connection_handler(int sd, short args, void *cbdata)
              * nspace - it doesn't add the peer object to our array
              * of local clients. So let's start by searching for
              * the nspace object */
-            nptr = NULL;
-            PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-                if (0 == strcmp(tmp->nspace, nspace)) {
-                    nptr = tmp;
-                    break;
-                }
-            }
+            nptr = pmix_server_nspace_lookup(nspace);
             if (NULL == nptr) {
                 /* we don't know this namespace, reject it */
                 free(msg);
@@ -1481,13 +1476,7 @@ static void connection_handler(int sd, short args, void *cbdata)
     }
 
     /* see if we know this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(nspace);
     if (NULL == nptr) {
         /* we don't know this namespace, reject it */
         free(msg);
@@ -1624,6 +1613,10 @@ static void connection_handler(int sd, short args, void *cbdata)
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "client connection validated");
 
+    /* see if another transport is to carry the messages of this
+     * client - it has to be settled before the client hears back */
+    handed_over = (PMIX_SUCCESS == pmix_ptl_base_setup_peer(peer));
+
     /* tell the client all is good */
     u32 = htonl(PMIX_SUCCESS);
     if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
@@ -1666,12 +1659,14 @@ static void connection_handler(int sd, short args, void *cbdata)
     pmix_ptl_base_set_nonblocking(pnd->sd);
 
     /* start the events for this client */
-    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, pnd->sd,
-                      EV_READ|EV_PERSIST, pmix_ptl_base_recv_handler, peer);
-    pmix_event_add(&peer->recv_event, NULL);
-    peer->recv_ev_active = true;
-    pmix_event_assign(&peer->send_event, pmix_globals.evbase, pnd->sd,
-                      EV_WRITE|EV_PERSIST, pmix_ptl_base_send_handler, peer);
+    if (!handed_over) {
+        pmix_event_assign(&peer->recv_event, pmix_globals.evbase, pnd->sd,
+                          EV_READ|EV_PERSIST, pmix_ptl_base_recv_handler, peer);
+        pmix_event_add(&peer->recv_event, NULL);
+        peer->recv_ev_active = true;
+        pmix_event_assign(&peer->send_event, pmix_globals.evbase, pnd->sd,
+                          EV_WRITE|EV_PERSIST, pmix_ptl_base_send_handler, peer);
+    }
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "pmix:server client %s:%u has connected on socket %d",
                         peer->info->pname.nspace, peer->info->pname.rank, peer->sd);
@@ -1780,6 +1775,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
         PMIX_RETAIN(nptr);
         nptr->nspace = strdup(cd->proc.nspace);
         pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_server_nspace_index(nptr);
         info = PMIX_NEW(pmix_rank_info_t);
         info->pname.nspace = strdup(nptr->nspace);
         info->pname.rank = cd->proc.rank;
@@ -1807,6 +1803,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     peer->nptr->compat.psec = pmix_psec_base_assign_module(pnd->psec);
     if (NULL == peer->nptr->compat.psec) {
         PMIX_RELEASE(peer);
+        pmix_server_nspace_unindex(nptr);
         pmix_list_remove_item(&pmix_server_globals.nspaces, &nptr->super);
         PMIX_RELEASE(nptr);  // will release the info object
         CLOSE_THE_SOCKET(pnd->sd);
@@ -1822,6 +1819,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     PMIX_INFO_DESTRUCT(&ginfo);
     if (NULL == peer->nptr->compat.gds) {
         PMIX_RELEASE(peer);
+        pmix_server_nspace_unindex(nptr);
         pmix_list_remove_item(&pmix_server_globals.nspaces, &nptr->super);
         PMIX_RELEASE(nptr);  // will release the info object
         CLOSE_THE_SOCKET(pnd->sd);
@@ -1841,6 +1839,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     req = PMIX_NEW(pmix_iof_req_t);
     if (NULL == req) {
         PMIX_RELEASE(peer);
+        pmix_server_nspace_unindex(nptr);
         pmix_list_remove_item(&pmix_server_globals.nspaces, &nptr->super);
         PMIX_RELEASE(nptr);  // will release the info object
         CLOSE_THE_SOCKET(pnd->sd);
@@ -1862,6 +1861,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
                             "validation of tool credentials failed: %s",
                             PMIx_Error_string(rc));
         PMIX_RELEASE(peer);
+        pmix_server_nspace_unindex(nptr);
         pmix_list_remove_item(&pmix_server_globals.nspaces, &nptr->super);
         PMIX_RELEASE(nptr);  // will release the info object
         CLOSE_THE_SOCKET(pnd->sd);
@@ -1875,6 +1875,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
         PMIX_RELEASE(pnd);
         PMIX_RELEASE(cd);
         PMIX_RELEASE(peer);
+        pmix_server_nspace_unindex(nptr);
         pmix_list_remove_item(&pmix_server_globals.nspaces, &nptr->super);
         PMIX_RELEASE(nptr);  // will release the info object
         /* probably cannot send an error reply if we are out of memory */
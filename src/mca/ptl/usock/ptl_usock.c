@@ -833,6 +833,8 @@ void pmix_usock_send_recv(int fd, short args, void *cbdata)
     pmix_ptl_sr_t *ms = (pmix_ptl_sr_t*)cbdata;
     pmix_ptl_posted_recv_t *req;
     pmix_ptl_send_t *snd;
+    pmix_buffer_t buf;
+    pmix_ptl_hdr_t hdr;
     uint32_t tag;
 
     /* acquire the object */
@@ -862,10 +864,26 @@ void pmix_usock_send_recv(int fd, short args, void *cbdata)
         req->cbdata = ms->cbdata;
         pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                             "posting recv on tag %d", req->tag);
-        /* add it to the list of recvs - we cannot have unexpected messages
+        /* add it to the recvs - we cannot have unexpected messages
          * in this subsystem as the server never sends us something that
          * we didn't previously request */
-        pmix_list_prepend(&pmix_ptl_globals.posted_recvs, &req->super);
+        if (PMIX_SUCCESS != pmix_ptl_base_add_posted_recv(req)) {
+            /* the tag is still awaiting a reply, so ours couldn't
+             * be told apart - complete the request the way a lost
+             * connection does rather than leave the caller hanging */
+            PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+            buf.type = ms->peer->nptr->compat.type;
+            hdr.tag = tag;
+            hdr.nbytes = 0;
+            req->cbfunc(pmix_globals.mypeer, &hdr, &buf, req->cbdata);
+            PMIX_DESTRUCT(&buf);
+            PMIX_RELEASE(req);
+            if (NULL != ms->bfr) {
+                PMIX_RELEASE(ms->bfr);
+            }
+            PMIX_RELEASE(ms);
+            return;
+        }
     }
 
     snd = PMIX_NEW(pmix_ptl_send_t);
@@ -31,6 +31,7 @@
 #include "src/common/pmix_attributes.h"
 #include "src/util/output.h"
 #include "src/util/keyval_parse.h"
+#include "src/util/nspace_registry.h"
 #include "src/util/show_help.h"
 #include "src/mca/base/base.h"
 #include "src/mca/base/pmix_mca_base_var.h"
@@ -56,6 +57,7 @@ void pmix_rte_finalize(void)
 {
     int i;
     pmix_notify_caddy_t *cd;
+    size_t hits, misses;
 
     if( --pmix_initialized != 0 ) {
         if( pmix_initialized < 0 ) {
@@ -89,6 +91,9 @@ void pmix_rte_finalize(void)
     /* close GDS */
     (void)pmix_mca_base_framework_close(&pmix_gds_base_framework);
 
+    /* release the nspace registry */
+    pmix_nspace_registry_finalize();
+
     /* finalize the mca */
     /* Clear out all the registered MCA params */
     pmix_deregister_params();
@@ -104,6 +109,20 @@ void pmix_rte_finalize(void)
     /* finalize the show_help system */
     pmix_show_help_finalize();
 
+    /* stop pooling objects and report how the pools did */
+    pmix_obj_pool_max = 0;
+    pmix_class_pool_drain();
+    for (i=0; NULL != pmix_pooled_classes[i]; i++) {
+        pmix_class_pool_stats(pmix_pooled_classes[i], &hits, &misses);
+        if (0 < hits + misses) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                                "object pool %s: %lu hits %lu misses",
+                                pmix_pooled_classes[i]->cls_name,
+                                (unsigned long)hits, (unsigned long)misses);
+        }
+    }
+    pmix_class_pool_finalize();
+
     /* finalize the output system.  This has to come *after* the
        malloc code, as the malloc code needs to call into this, but
        the malloc code turning off doesn't affect pmix_output that
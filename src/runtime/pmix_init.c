@@ -57,6 +57,7 @@
 #include "src/include/types.h"
 #include "src/util/error.h"
 #include "src/util/keyval_parse.h"
+#include "src/util/nspace_registry.h"
 
 #include "src/runtime/pmix_rte.h"
 #include "src/runtime/pmix_progress_threads.h"
@@ -86,6 +87,17 @@ PMIX_EXPORT pmix_globals_t pmix_globals = {
     .pushstdin = false
 };
 
+/* classes created and released per message or request */
+PMIX_EXPORT pmix_class_t *pmix_pooled_classes[] = {
+    PMIX_CLASS(pmix_buffer_t),
+    PMIX_CLASS(pmix_kval_t),
+    PMIX_CLASS(pmix_ptl_send_t),
+    PMIX_CLASS(pmix_ptl_recv_t),
+    PMIX_CLASS(pmix_server_caddy_t),
+    PMIX_CLASS(pmix_cb_t),
+    PMIX_CLASS(pmix_shift_caddy_t),
+    NULL
+};
 
 static void _notification_eviction_cbfunc(struct pmix_hotel_t *hotel,
                                           int room_num,
@@ -157,12 +169,25 @@ int pmix_rte_init(pmix_proc_type_t type,
         goto return_error;
     }
 
+    /* keep released objects of the busiest classes for reuse */
+    if (0 < pmix_obj_pool_max) {
+        for (n=0; NULL != pmix_pooled_classes[n]; n++) {
+            (void)pmix_class_pool_enable(pmix_pooled_classes[n]);
+        }
+    }
+
     /* initialize the mca */
     if (PMIX_SUCCESS != (ret = pmix_mca_base_open())) {
         error = "mca_base_open";
         goto return_error;
     }
 
+    /* setup the nspace registry */
+    if (PMIX_SUCCESS != (ret = pmix_nspace_registry_init())) {
+        error = "pmix_nspace_registry_init";
+        goto return_error;
+    }
+
     /* setup the globals structure */
     gethostname(hostname, PMIX_MAXHOSTNAMELEN);
     pmix_globals.hostname = strdup(hostname);
@@ -257,6 +257,16 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_globals.event_eviction_time);
 
+    /* objects of the classes created per message or request to keep
+     * for reuse, per class and thread */
+    pmix_obj_pool_max = 64;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "obj", "pool_max",
+                                       "Maximum number of released objects of a frequently used class that "
+                                       "each thread keeps for reuse (0 = always use malloc)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_obj_pool_max);
+
     /* max number of IOF messages to cache */
     pmix_server_globals.max_iof_cache = 1024 * 1024;
     (void) pmix_mca_base_var_register ("pmix", "pmix", "max", "iof_cache",
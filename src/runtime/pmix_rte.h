@@ -69,6 +69,11 @@ PMIX_EXPORT pmix_status_t pmix_rte_init(pmix_proc_type_t type,
  */
 PMIX_EXPORT void pmix_rte_finalize(void);
 
+/**
+ * Classes given an object pool at init, NULL terminated
+ */
+PMIX_EXPORT extern pmix_class_t *pmix_pooled_classes[];
+
 /**
  * Internal function.  Do not call.
  */
@@ -97,6 +97,8 @@ pmix_status_t pmix_server_initialize(void)
     PMIX_CONSTRUCT(&pmix_server_globals.events, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.nspaces, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.nspace_index, pmix_pointer_array_t);
+    pmix_pointer_array_init(&pmix_server_globals.nspace_index, 32, INT_MAX, 32);
     PMIX_CONSTRUCT(&pmix_server_globals.groups, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.iof, pmix_list_t);
 
@@ -353,11 +355,14 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module,
     }
     if (NULL == pmix_globals.mypeer->nptr) {
         pmix_globals.mypeer->nptr = PMIX_NEW(pmix_namespace_t);
+        pmix_globals.mypeer->nptr->nspace = strdup(pmix_globals.myid.nspace);
         /* ensure our own nspace is first on the list */
         PMIX_RETAIN(pmix_globals.mypeer->nptr);
         pmix_list_prepend(&pmix_server_globals.nspaces, &pmix_globals.mypeer->nptr->super);
+        pmix_server_nspace_index(pmix_globals.mypeer->nptr);
+    } else {
+        pmix_globals.mypeer->nptr->nspace = strdup(pmix_globals.myid.nspace);
     }
-    pmix_globals.mypeer->nptr->nspace = strdup(pmix_globals.myid.nspace);
     rinfo->pname.nspace = strdup(pmix_globals.mypeer->nptr->nspace);
     rinfo->pname.rank = pmix_globals.myid.rank;
     rinfo->uid = pmix_globals.uid;
@@ -395,8 +400,13 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module,
     req = PMIX_NEW(pmix_ptl_posted_recv_t);
     req->tag = UINT32_MAX;
     req->cbfunc = pmix_server_message_handler;
-    /* add it to the end of the list of recvs */
-    pmix_list_append(&pmix_ptl_globals.posted_recvs, &req->super);
+    /* add it to the recvs */
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_add_posted_recv(req))) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(req);
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return rc;
+    }
 
     /* if we are a gateway, setup our IOF events */
     if (PMIX_PROC_IS_GATEWAY(pmix_globals.mypeer)) {
@@ -480,6 +490,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
          * at zero refcount */
         pmix_execute_epilog(&ns->epilog);
     }
+    PMIX_DESTRUCT(&pmix_server_globals.nspace_index);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.nspaces);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.groups);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
@@ -529,7 +540,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
 static void _register_nspace(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_status_t rc;
     size_t i;
 
@@ -539,13 +550,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
                         "pmix:server _register_nspace %s", cd->proc.nspace);
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         nptr = PMIX_NEW(pmix_namespace_t);
         if (NULL == nptr) {
@@ -554,6 +559,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
         }
         nptr->nspace = strdup(cd->proc.nspace);
         pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_server_nspace_index(nptr);
     }
     nptr->nlocalprocs = cd->nlocalprocs;
 
@@ -733,6 +739,9 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
     /* release any job-level network resources */
     pmix_pnet.deregister_nspace(cd->proc.nspace);
 
+    /* release whatever the transports setup for its clients */
+    pmix_ptl_base_deregister_nspace(cd->proc.nspace);
+
     /* let our local storage clean up */
     PMIX_GDS_DEL_NSPACE(rc, cd->proc.nspace);
 
@@ -741,15 +750,13 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
     pmix_server_purge_events(NULL, &cd->proc);
 
     /* release this nspace */
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (PMIX_CHECK_NSPACE(tmp->nspace, cd->proc.nspace)) {
-            /* perform any nspace-level epilog */
-            pmix_execute_epilog(&tmp->epilog);
-            /* remove and release it */
-            pmix_list_remove_item(&pmix_server_globals.nspaces, &tmp->super);
-            PMIX_RELEASE(tmp);
-            break;
-        }
+    if (NULL != (tmp = pmix_server_nspace_lookup(cd->proc.nspace))) {
+        /* perform any nspace-level epilog */
+        pmix_execute_epilog(&tmp->epilog);
+        /* remove and release it */
+        pmix_server_nspace_unindex(tmp);
+        pmix_list_remove_item(&pmix_server_globals.nspaces, &tmp->super);
+        PMIX_RELEASE(tmp);
     }
 
     /* release the caller */
@@ -875,11 +882,12 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
                 }
                 proc.rank = cd->peer->info->pname.rank;
                 /* get any remote contribution - note that there
-                 * may not be a contribution */
+                 * may not be a contribution. It is only packed,
+                 * so no copy is needed */
                 PMIX_CONSTRUCT(&cb, pmix_cb_t);
                 cb.proc = &proc;
                 cb.scope = PMIX_REMOTE;
-                cb.copy = true;
+                cb.copy = false;
                 PMIX_GDS_FETCH_KV(rc, peer, &cb);
                 if (PMIX_SUCCESS == rc) {
                     /* pack the returned kvals */
@@ -962,13 +970,7 @@ static void _register_client(int sd, short args, void *cbdata)
                         (NULL == cd->server_object) ? "NULL" : "NON-NULL");
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, cd->proc.nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         nptr = PMIX_NEW(pmix_namespace_t);
         if (NULL == nptr) {
@@ -977,6 +979,7 @@ static void _register_client(int sd, short args, void *cbdata)
         }
         nptr->nspace = strdup(cd->proc.nspace);
         pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_server_nspace_index(nptr);
     }
     /* setup a peer object for this client - since the host server
      * only deals with the original processes and not any clones,
@@ -1017,12 +1020,9 @@ static void _register_client(int sd, short args, void *cbdata)
                  * if the nspaces are all defined */
                 if (all_def) {
                     /* so far, they have all been defined - check this one */
-                    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-                        if (0 < ns->nlocalprocs &&
-                            0 == strcmp(trk->pcs[i].nspace, ns->nspace)) {
-                            all_def = ns->all_registered;
-                            break;
-                        }
+                    ns = pmix_server_nspace_lookup(trk->pcs[i].nspace);
+                    if (NULL != ns && 0 < ns->nlocalprocs) {
+                        all_def = ns->all_registered;
                     }
                 }
                 /* now see if this proc is local to us */
@@ -1105,7 +1105,7 @@ static void _deregister_client(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_rank_info_t *info;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_peer_t *peer;
 
     PMIX_ACQUIRE_OBJECT(cd);
@@ -1115,13 +1115,7 @@ static void _deregister_client(int sd, short args, void *cbdata)
                         cd->proc.nspace, cd->proc.rank);
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         /* nothing to do */
         goto cleanup;
@@ -1175,6 +1169,9 @@ static void _deregister_client(int sd, short args, void *cbdata)
     }
 
   cleanup:
+    /* release whatever the transports setup for the client */
+    pmix_ptl_base_deregister_client(&cd->proc);
+
     if (NULL != cd->opcbfunc) {
         cd->opcbfunc(PMIX_SUCCESS, cd->cbdata);
     }
@@ -1295,7 +1292,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_rank_info_t *info, *iptr;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     char *data = NULL;
     size_t sz = 0;
     pmix_dmdx_remote_t *dcd;
@@ -1314,13 +1311,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
      * could cause this request to arrive prior to us having
      * been informed of it - so first check to see if we know
      * about this nspace yet */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, cd->proc.nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         /* we don't know this namespace yet, and so we obviously
          * haven't received the data from this proc yet - defer
@@ -1338,12 +1329,12 @@ static void _dmodex_req(int sd, short args, void *cbdata)
     /* They are asking for job level data for this process */
     if (cd->proc.rank == PMIX_RANK_WILDCARD) {
         /* fetch the job-level info for this nspace */
-        /* this is going to a remote peer, so inform the gds
-         * that we need an actual copy of the data */
+        /* the data is only packed for the remote peer, so
+         * references to the stored values will do */
         PMIX_CONSTRUCT(&cb, pmix_cb_t);
         cb.proc = &cd->proc;
         cb.scope = PMIX_REMOTE;
-        cb.copy = true;
+        cb.copy = false;
         PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
         PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
         if (PMIX_SUCCESS == rc) {
@@ -1391,11 +1382,12 @@ static void _dmodex_req(int sd, short args, void *cbdata)
         return;
     }
 
-    /* collect the remote/global data from this proc */
+    /* collect the remote/global data from this proc - it
+     * is only packed, so no copy is needed */
     PMIX_CONSTRUCT(&cb, pmix_cb_t);
     cb.proc = &cd->proc;
     cb.scope = PMIX_REMOTE;
-    cb.copy = true;
+    cb.copy = false;
     PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
     if (PMIX_SUCCESS == rc) {
         /* assemble the provided data into a byte object */
@@ -2285,8 +2277,8 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
     pmix_server_caddy_t *cd, *nxt;
     pmix_status_t rc = PMIX_SUCCESS, ret;
     pmix_nspace_caddy_t *nptr;
-    pmix_list_t nslist;
-    bool found;
+    pmix_list_t nslist, replies;
+    bool found, created;
 
     PMIX_ACQUIRE_OBJECT(scd);
 
@@ -2311,6 +2303,7 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
     /* pass the blobs being returned */
     PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
     PMIX_CONSTRUCT(&nslist, pmix_list_t);
+    PMIX_CONSTRUCT(&replies, pmix_list_t);
 
     if (PMIX_SUCCESS != scd->status) {
         rc = scd->status;
@@ -2362,22 +2355,25 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
   finish_collective:
     /* loop across all procs in the tracker, sending them the reply */
     PMIX_LIST_FOREACH_SAFE(cd, nxt, &tracker->local_cbs, pmix_server_caddy_t) {
-        reply = PMIX_NEW(pmix_buffer_t);
+        reply = pmix_server_shared_reply(&replies, cd->peer, false, &created);
         if (NULL == reply) {
             rc = PMIX_ERR_NOMEM;
             break;
         }
-        /* setup the reply, starting with the returned status */
-        PMIX_BFROPS_PACK(ret, cd->peer, reply, &rc, 1, PMIX_STATUS);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            goto cleanup;
+        if (created) {
+            /* setup the reply, starting with the returned status */
+            PMIX_BFROPS_PACK(ret, cd->peer, reply, &rc, 1, PMIX_STATUS);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                goto cleanup;
+            }
         }
         pmix_output_verbose(2, pmix_server_globals.base_output,
                             "server:modex_cbfunc reply being sent to %s:%u",
                             cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
-        PMIX_SERVER_QUEUE_REPLY(rc, cd->peer, cd->hdr.tag, reply);
-        if (PMIX_SUCCESS != rc) {
+        PMIX_RETAIN(reply);
+        PMIX_SERVER_QUEUE_REPLY(ret, cd->peer, cd->hdr.tag, reply);
+        if (PMIX_SUCCESS != ret) {
             PMIX_RELEASE(reply);
         }
         /* remove this entry */
@@ -2394,6 +2390,7 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
     xfer.base_ptr = NULL;
     xfer.bytes_used = 0;
     PMIX_DESTRUCT(&xfer);
+    PMIX_LIST_DESTRUCT(&replies);
 
     pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
     PMIX_RELEASE(tracker);
@@ -2509,6 +2506,8 @@ static void _cnct(int sd, short args, void *cbdata)
     pmix_proc_t proc;
     pmix_cb_t cb;
     pmix_kval_t *kptr;
+    pmix_list_t replies;
+    bool created;
 
     PMIX_ACQUIRE_OBJECT(scd);
 
@@ -2543,23 +2542,25 @@ static void _cnct(int sd, short args, void *cbdata)
         }
     }
 
-    /* loop across all local procs in the tracker, sending them the reply */
+    /* loop across all local procs in the tracker, sending them the reply -
+     * it only differs by the nspace of the recipient */
+    PMIX_CONSTRUCT(&replies, pmix_list_t);
     PMIX_LIST_FOREACH(cd, &tracker->local_cbs, pmix_server_caddy_t) {
-        /* setup the reply, starting with the returned status */
-        reply = PMIX_NEW(pmix_buffer_t);
+        reply = pmix_server_shared_reply(&replies, cd->peer, true, &created);
         if (NULL == reply) {
             PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
             rc = PMIX_ERR_NOMEM;
             goto cleanup;
         }
-        /* start with the status */
-        PMIX_BFROPS_PACK(rc, cd->peer, reply, &scd->status, 1, PMIX_STATUS);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(reply);
-            goto cleanup;
+        if (created) {
+            /* setup the reply, starting with the returned status */
+            PMIX_BFROPS_PACK(rc, cd->peer, reply, &scd->status, 1, PMIX_STATUS);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                goto cleanup;
+            }
         }
-        if (PMIX_SUCCESS == scd->status) {
+        if (created && PMIX_SUCCESS == scd->status) {
             /* loop across all participating nspaces and include their
              * job-related info */
             for (i=0; NULL != nspaces[i]; i++) {
@@ -2585,7 +2586,6 @@ static void _cnct(int sd, short args, void *cbdata)
                 PMIX_GDS_FETCH_KV(rc, cd->peer, &cb);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(reply);
                     PMIX_DESTRUCT(&cb);
                     goto cleanup;
                 }
@@ -2594,7 +2594,6 @@ static void _cnct(int sd, short args, void *cbdata)
                 PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &nspaces[i], 1, PMIX_STRING);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(reply);
                     PMIX_DESTRUCT(&pbkt);
                     PMIX_DESTRUCT(&cb);
                     goto cleanup;
@@ -2603,7 +2602,6 @@ static void _cnct(int sd, short args, void *cbdata)
                     PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, kptr, 1, PMIX_KVAL);
                     if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(reply);
                         PMIX_DESTRUCT(&pbkt);
                         PMIX_DESTRUCT(&cb);
                         goto cleanup;
@@ -2615,7 +2613,6 @@ static void _cnct(int sd, short args, void *cbdata)
                     PMIX_BFROPS_PACK(rc, cd->peer, reply, &pbkt, 1, PMIX_BUFFER);
                     if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(reply);
                         PMIX_DESTRUCT(&pbkt);
                         PMIX_DESTRUCT(&cb);
                         goto cleanup;
@@ -2625,7 +2622,6 @@ static void _cnct(int sd, short args, void *cbdata)
                     PMIX_BFROPS_PACK(rc, cd->peer, reply, &bo, 1, PMIX_BYTE_OBJECT);
                     if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(reply);
                         PMIX_DESTRUCT(&pbkt);
                         PMIX_DESTRUCT(&cb);
                         goto cleanup;
@@ -2638,6 +2634,7 @@ static void _cnct(int sd, short args, void *cbdata)
         pmix_output_verbose(2, pmix_server_globals.base_output,
                             "server:cnct_cbfunc reply being sent to %s:%u",
                             cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
+        PMIX_RETAIN(reply);
         PMIX_SERVER_QUEUE_REPLY(rc, cd->peer, cd->hdr.tag, reply);
         if (PMIX_SUCCESS != rc) {
             PMIX_RELEASE(reply);
@@ -2645,6 +2642,7 @@ static void _cnct(int sd, short args, void *cbdata)
     }
 
   cleanup:
+    PMIX_LIST_DESTRUCT(&replies);
     if (NULL != nspaces) {
       pmix_argv_free(nspaces);
     }
@@ -2681,6 +2679,8 @@ static void _discnct(int sd, short args, void *cbdata)
     pmix_buffer_t *reply;
     pmix_status_t rc;
     pmix_server_caddy_t *cd;
+    pmix_list_t replies;
+    bool created;
 
     PMIX_ACQUIRE_OBJECT(scd);
 
@@ -2698,24 +2698,26 @@ static void _discnct(int sd, short args, void *cbdata)
     }
 
     /* loop across all local procs in the tracker, sending them the reply */
+    PMIX_CONSTRUCT(&replies, pmix_list_t);
     PMIX_LIST_FOREACH(cd, &tracker->local_cbs, pmix_server_caddy_t) {
-        /* setup the reply */
-        reply = PMIX_NEW(pmix_buffer_t);
+        reply = pmix_server_shared_reply(&replies, cd->peer, false, &created);
         if (NULL == reply) {
             PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
             rc = PMIX_ERR_NOMEM;
             goto cleanup;
         }
-        /* return the status */
-        PMIX_BFROPS_PACK(rc, cd->peer, reply, &scd->status, 1, PMIX_STATUS);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(reply);
-            goto cleanup;
+        if (created) {
+            /* return the status */
+            PMIX_BFROPS_PACK(rc, cd->peer, reply, &scd->status, 1, PMIX_STATUS);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                goto cleanup;
+            }
         }
         pmix_output_verbose(2, pmix_server_globals.base_output,
                             "server:cnct_cbfunc reply being sent to %s:%u",
                             cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
+        PMIX_RETAIN(reply);
         PMIX_SERVER_QUEUE_REPLY(rc, cd->peer, cd->hdr.tag, reply);
         if (PMIX_SUCCESS != rc) {
             PMIX_RELEASE(reply);
@@ -2723,6 +2725,7 @@ static void _discnct(int sd, short args, void *cbdata)
     }
 
   cleanup:
+    PMIX_LIST_DESTRUCT(&replies);
     /* cleanup the tracker -- the host RM is responsible for
      * telling us when to remove the nspace from our data */
     pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
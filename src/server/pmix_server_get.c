@@ -118,7 +118,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     pmix_rank_t rank;
     char *cptr;
     char nspace[PMIX_MAX_NSLEN+1];
-    pmix_namespace_t *ns, *nptr;
+    pmix_namespace_t *nptr;
     pmix_info_t *info=NULL;
     size_t ninfo=0;
     pmix_dmdx_local_t *lcd;
@@ -189,13 +189,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     }
 
     /* find the nspace object for this client */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(nspace);
 
     pmix_output_verbose(2, pmix_server_globals.get_output,
                         "%s:%d EXECUTE GET FOR %s:%d ON BEHALF OF %s:%d",
@@ -587,17 +581,55 @@ void pmix_pending_nspace_requests(pmix_namespace_t *nptr)
     }
 }
 
+/* pack the data of the proc for the requestor. A gds that keeps the
+ * packed form of its data hands that out, otherwise the data is
+ * fetched and assembled. Returns the fetch status, with "fetched"
+ * telling the caller that any other error came from packing */
+static pmix_status_t pack_proc_data(pmix_peer_t *peer, pmix_proc_t *proc,
+                                    pmix_scope_t scope, pmix_server_caddy_t *cd,
+                                    pmix_buffer_t *pkt, bool *fetched)
+{
+    pmix_cb_t cb;
+    pmix_status_t rc;
+
+    *fetched = false;
+    /* the snapshot is built by the gds of the requestor, so
+     * it can only be used if that gds also holds the data */
+    if (peer->nptr->compat.gds == cd->peer->nptr->compat.gds) {
+        PMIX_GDS_ASSEMB_KVS_SNAPSHOT(rc, cd->peer, proc, scope, pkt, cd);
+        if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+            *fetched = (PMIX_SUCCESS == rc);
+            return rc;
+        }
+    }
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    /* this data is requested by a local client, so give the gds the option
+     * of returning a copy of the data, or a pointer to
+     * local storage */
+    cb.proc = proc;
+    cb.scope = scope;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, peer, &cb);
+    if (PMIX_SUCCESS == rc) {
+        *fetched = true;
+        /* assemble the provided data into a byte object */
+        PMIX_GDS_ASSEMB_KVS_REQ(rc, cd->peer, proc, &cb.kvs, pkt, cd);
+    }
+    PMIX_DESTRUCT(&cb);
+    return rc;
+}
+
 static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
                                       pmix_server_caddy_t *cd,
                                       pmix_modex_cbfunc_t cbfunc,
                                       void *cbdata, bool *local)
 {
     pmix_status_t rc;
-    bool found = false;
+    bool found = false, fetched;
     pmix_buffer_t pbkt, pkt;
     pmix_rank_info_t *iptr;
     pmix_proc_t proc;
-    pmix_cb_t cb;
     pmix_peer_t *peer = NULL;
     pmix_byte_object_t bo;
     char *data = NULL;
@@ -662,25 +694,15 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
     if (PMIX_RANK_WILDCARD == rank ||
         0 != strncmp(nptr->nspace, cd->peer->info->pname.nspace, PMIX_MAX_NSLEN)) {
         proc.rank = PMIX_RANK_WILDCARD;
-        PMIX_CONSTRUCT(&cb, pmix_cb_t);
-        /* this data is requested by a local client, so give the gds the option
-         * of returning a copy of the data, or a pointer to
-         * local storage */
-        cb.proc = &proc;
-        cb.scope = PMIX_INTERNAL;
-        cb.copy = false;
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
+        rc = pack_proc_data(pmix_globals.mypeer, &proc, PMIX_INTERNAL, cd, &pkt, &fetched);
+        if (PMIX_SUCCESS != rc && fetched) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&pkt);
+            PMIX_DESTRUCT(&pbkt);
+            return rc;
+        }
         if (PMIX_SUCCESS == rc) {
-            PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
-            /* assemble the provided data into a byte object */
-            PMIX_GDS_ASSEMB_KVS_REQ(rc, cd->peer, &proc, &cb.kvs, &pkt, cd);
-            if (rc != PMIX_SUCCESS) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&pkt);
-                PMIX_DESTRUCT(&pbkt);
-                PMIX_DESTRUCT(&cb);
-                return rc;
-            }
             if (PMIX_PROC_IS_V1(cd->peer)) {
                 /* if the client is using v1, then it expects the
                  * data returned to it as the rank followed by abyte object containing
@@ -693,7 +715,6 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
                     PMIX_DESTRUCT(&pkt);
                     PMIX_DESTRUCT(&pbkt);
                     PMIX_DESTRUCT(&xfer);
-                    PMIX_DESTRUCT(&cb);
                     return rc;
                 }
                 PMIX_UNLOAD_BUFFER(&xfer, bo.bytes, bo.size);
@@ -707,11 +728,11 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_DESTRUCT(&pbkt);
-                PMIX_DESTRUCT(&cb);
                 return rc;
             }
+        } else {
+            PMIX_DESTRUCT(&pkt);
         }
-        PMIX_DESTRUCT(&cb);
         if (rank == PMIX_RANK_WILDCARD) {
             found = true;
         }
@@ -730,26 +751,16 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
             return PMIX_ERR_NOT_FOUND;
         }
         proc.rank = rank;
-        PMIX_CONSTRUCT(&cb, pmix_cb_t);
-        /* this is a local request, so give the gds the option
-         * of returning a copy of the data, or a pointer to
-         * local storage */
-        cb.proc = &proc;
-        cb.scope = scope;
-        cb.copy = false;
-        PMIX_GDS_FETCH_KV(rc, peer, &cb);
+        PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
+        rc = pack_proc_data(peer, &proc, scope, cd, &pkt, &fetched);
+        if (PMIX_SUCCESS != rc && fetched) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&pkt);
+            PMIX_DESTRUCT(&pbkt);
+            return rc;
+        }
         if (PMIX_SUCCESS == rc) {
             found = true;
-            PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
-            /* assemble the provided data into a byte object */
-            PMIX_GDS_ASSEMB_KVS_REQ(rc, cd->peer, &proc, &cb.kvs, &pkt, cd);
-            if (rc != PMIX_SUCCESS) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&pkt);
-                PMIX_DESTRUCT(&pbkt);
-                PMIX_DESTRUCT(&cb);
-                return rc;
-            }
             if (PMIX_PROC_IS_V1(cd->peer)) {
                 /* if the client is using v1, then it expects the
                  * data returned to it in a different order than v2
@@ -760,7 +771,6 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
                     PMIX_ERROR_LOG(rc);
                     PMIX_DESTRUCT(&pkt);
                     PMIX_DESTRUCT(&pbkt);
-                    PMIX_DESTRUCT(&cb);
                     return rc;
                 }
                 /* now pack the data itself as a buffer */
@@ -769,7 +779,6 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
                     PMIX_ERROR_LOG(rc);
                     PMIX_DESTRUCT(&pkt);
                     PMIX_DESTRUCT(&pbkt);
-                    PMIX_DESTRUCT(&cb);
                     return rc;
                 }
                 PMIX_DESTRUCT(&pkt);
@@ -781,12 +790,12 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_DESTRUCT(&pbkt);
-                    PMIX_DESTRUCT(&cb);
                     return rc;
                 }
             }
+        } else {
+            PMIX_DESTRUCT(&pkt);
         }
-        PMIX_DESTRUCT(&cb);
     }
     PMIX_UNLOAD_BUFFER(&pbkt, data, sz);
     PMIX_DESTRUCT(&pbkt);
@@ -877,7 +886,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
     pmix_rank_info_t *rinfo;
     int32_t cnt;
     pmix_kval_t *kv;
-    pmix_namespace_t *ns, *nptr;
+    pmix_namespace_t *nptr;
     pmix_status_t rc;
     pmix_list_t nspaces;
     pmix_nspace_caddy_t *nm;
@@ -894,13 +903,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
                     caddy->lcd->proc.nspace, caddy->lcd->proc.rank);
 
     /* find the nspace object for the proc whose data is being received */
-    nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(caddy->lcd->proc.nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_server_nspace_lookup(caddy->lcd->proc.nspace);
 
     if (NULL == nptr) {
         /* We may not have this namespace because there are no local
@@ -910,6 +913,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
         nptr->nspace = strdup(caddy->lcd->proc.nspace);
         /* add to the list */
         pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_server_nspace_index(nptr);
     }
 
     /* if the request was successfully satisfied, then store the data.
@@ -26,6 +26,7 @@
 #ifdef HAVE_STRING_H
 #include <string.h>
 #endif
+#include <limits.h>
 #ifdef HAVE_SYS_STAT_H
 #include <sys/stat.h>
 #endif
@@ -58,6 +59,7 @@
 #include "src/mca/psensor/psensor.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
+#include "src/util/nspace_registry.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/mca/gds/base/base.h"
@@ -255,13 +257,14 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
         if (dcd->cd->proc.rank == info->pname.rank) {
            /* we can now fulfill this request - collect the
              * remote/global data from this proc - note that there
-             * may not be a contribution */
+             * may not be a contribution. It is only packed,
+             * so no copy is needed */
             data = NULL;
             sz = 0;
             PMIX_CONSTRUCT(&cb, pmix_cb_t);
             cb.proc = &proc;
             cb.scope = PMIX_REMOTE;
-            cb.copy = true;
+            cb.copy = false;
             PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
             if (PMIX_SUCCESS == rc) {
                 /* package it up */
@@ -389,7 +392,7 @@ static pmix_server_trkr_t* new_tracker(char *id, pmix_proc_t *procs,
     pmix_server_trkr_t *trk;
     size_t i;
     bool all_def;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     pmix_rank_info_t *info;
     pmix_nspace_caddy_t *nm;
 
@@ -440,13 +443,7 @@ static pmix_server_trkr_t* new_tracker(char *id, pmix_proc_t *procs,
             continue;
         }
         /* is this nspace known to us? */
-        nptr = NULL;
-        PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(procs[i].nspace, ns->nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_server_nspace_lookup(procs[i].nspace);
         if (NULL == nptr) {
             /* cannot be a local proc */
             pmix_output_verbose(5, pmix_server_globals.base_output,
@@ -567,7 +564,8 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
                 PMIX_CONSTRUCT(&cb, pmix_cb_t);
                 cb.proc = &pcs;
                 cb.scope = PMIX_REMOTE;
-                cb.copy = true;
+                /* only the keys are looked at */
+                cb.copy = false;
                 PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
                 if (PMIX_SUCCESS == rc) {
                     int key_idx;
@@ -635,14 +633,15 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
         PMIX_CONSTRUCT(&rank_blobs, pmix_list_t);
         PMIX_LIST_FOREACH(scd, &trk->local_cbs, pmix_server_caddy_t) {
             /* get any remote contribution - note that there
-             * may not be a contribution */
+             * may not be a contribution. It is only packed,
+             * so no copy is needed */
             pmix_strncpy(pcs.nspace, scd->peer->info->pname.nspace,
                          PMIX_MAX_NSLEN);
             pcs.rank = scd->peer->info->pname.rank;
             PMIX_CONSTRUCT(&cb, pmix_cb_t);
             cb.proc = &pcs;
             cb.scope = PMIX_REMOTE;
-            cb.copy = true;
+            cb.copy = false;
             PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
             if (PMIX_SUCCESS == rc) {
                 /* calculate the throughout rank */
@@ -2800,7 +2799,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
     int32_t cnt, m;
     pmix_status_t rc;
     pmix_query_caddy_t *cd;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_peer_t *pr;
     pmix_proc_t proc;
     size_t n;
@@ -2850,13 +2849,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
     } else {
         for (n=0; n < cd->ntargets; n++) {
             /* find the nspace of this proc */
-            nptr = NULL;
-            PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-                if (0 == strcmp(tmp->nspace, cd->targets[n].nspace)) {
-                    nptr = tmp;
-                    break;
-                }
-            }
+            nptr = pmix_server_nspace_lookup(cd->targets[n].nspace);
             if (NULL == nptr) {
                 nptr = PMIX_NEW(pmix_namespace_t);
                 if (NULL == nptr) {
@@ -2865,6 +2858,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
                 }
                 nptr->nspace = strdup(cd->targets[n].nspace);
                 pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+                pmix_server_nspace_index(nptr);
             }
             /* if the rank is wildcard, then we use the epilog for the nspace */
             if (PMIX_RANK_WILDCARD == cd->targets[n].rank) {
@@ -3653,8 +3647,8 @@ static void _grpcbfunc(int sd, short argc, void *cbdata)
     pmix_group_t *grp = (pmix_group_t*)trk->cbdata;
     pmix_byte_object_t *bo = NULL;
     pmix_nspace_caddy_t *nptr;
-    pmix_list_t nslist;
-    bool found;
+    pmix_list_t nslist, replies;
+    bool found, created;
 
     PMIX_ACQUIRE_OBJECT(scd);
 
@@ -3734,35 +3728,38 @@ static void _grpcbfunc(int sd, short argc, void *cbdata)
     }
 
     /* loop across all procs in the tracker, sending them the reply */
+    PMIX_CONSTRUCT(&replies, pmix_list_t);
     PMIX_LIST_FOREACH(cd, &trk->local_cbs, pmix_server_caddy_t) {
-        reply = PMIX_NEW(pmix_buffer_t);
+        reply = pmix_server_shared_reply(&replies, cd->peer, false, &created);
         if (NULL == reply) {
             break;
         }
-        /* setup the reply, starting with the returned status */
-        PMIX_BFROPS_PACK(ret, cd->peer, reply, &scd->status, 1, PMIX_STATUS);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            PMIX_RELEASE(reply);
-            break;
-        }
-        if (!trk->hybrid) {
-            /* if a ctxid was provided, pass it along */
-            PMIX_BFROPS_PACK(ret, cd->peer, reply, &ctxid, 1, PMIX_SIZE);
+        if (created) {
+            /* setup the reply, starting with the returned status */
+            PMIX_BFROPS_PACK(ret, cd->peer, reply, &scd->status, 1, PMIX_STATUS);
             if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
-                PMIX_RELEASE(reply);
                 break;
             }
+            if (!trk->hybrid) {
+                /* if a ctxid was provided, pass it along */
+                PMIX_BFROPS_PACK(ret, cd->peer, reply, &ctxid, 1, PMIX_SIZE);
+                if (PMIX_SUCCESS != ret) {
+                    PMIX_ERROR_LOG(ret);
+                    break;
+                }
+            }
         }
         pmix_output_verbose(2, pmix_server_globals.connect_output,
                             "server:grp_cbfunc reply being sent to %s:%u",
                             cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
+        PMIX_RETAIN(reply);
         PMIX_SERVER_QUEUE_REPLY(ret, cd->peer, cd->hdr.tag, reply);
         if (PMIX_SUCCESS != ret) {
             PMIX_RELEASE(reply);
         }
     }
+    PMIX_LIST_DESTRUCT(&replies);
 
     /* remove the tracker from the list */
     pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
@@ -4296,6 +4293,93 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
     return rc;
 }
 
+/* the nspaces list is searched by name in most of the server
+ * operations, so keep the list entries indexed by their id in
+ * the nspace registry. The index doesn't hold a reference on the
+ * nspace object - the list does - but each indexed entry holds
+ * a reference on its registry id until it is unindexed */
+void pmix_server_nspace_index(pmix_namespace_t *nptr)
+{
+    uint32_t id;
+
+    if (NULL == nptr->nspace) {
+        return;
+    }
+    id = pmix_nspace_registry_add(nptr->nspace);
+    if (PMIX_NSPACE_INVALID_ID == id || (uint32_t)INT_MAX < id) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        return;
+    }
+    if (NULL != pmix_pointer_array_get_item(&pmix_server_globals.nspace_index, (int)id)) {
+        /* the slot already holds the reference */
+        pmix_nspace_registry_release(id);
+    }
+    pmix_pointer_array_set_item(&pmix_server_globals.nspace_index, (int)id, nptr);
+}
+
+void pmix_server_nspace_unindex(pmix_namespace_t *nptr)
+{
+    uint32_t id;
+
+    if (NULL == nptr->nspace) {
+        return;
+    }
+    id = pmix_nspace_registry_lookup(nptr->nspace);
+    if (PMIX_NSPACE_INVALID_ID == id || (uint32_t)INT_MAX < id) {
+        return;
+    }
+    if (nptr == pmix_pointer_array_get_item(&pmix_server_globals.nspace_index, (int)id)) {
+        pmix_pointer_array_set_item(&pmix_server_globals.nspace_index, (int)id, NULL);
+        pmix_nspace_registry_release(id);
+    }
+}
+
+pmix_namespace_t* pmix_server_nspace_lookup(const char *nspace)
+{
+    uint32_t id;
+
+    id = pmix_nspace_registry_lookup(nspace);
+    if (PMIX_NSPACE_INVALID_ID == id || (uint32_t)INT_MAX < id) {
+        return NULL;
+    }
+    return (pmix_namespace_t*)pmix_pointer_array_get_item(&pmix_server_globals.nspace_index, (int)id);
+}
+
+pmix_buffer_t* pmix_server_shared_reply(pmix_list_t *replies,
+                                        pmix_peer_t *peer,
+                                        bool by_nspace,
+                                        bool *created)
+{
+    pmix_server_shared_reply_t *srp;
+
+    *created = false;
+    PMIX_LIST_FOREACH(srp, replies, pmix_server_shared_reply_t) {
+        if (srp->bfrops == peer->nptr->compat.bfrops &&
+            srp->type == peer->nptr->compat.type &&
+            (!by_nspace || srp->nptr == peer->nptr)) {
+            return srp->reply;
+        }
+    }
+
+    srp = PMIX_NEW(pmix_server_shared_reply_t);
+    if (NULL == srp) {
+        return NULL;
+    }
+    srp->reply = PMIX_NEW(pmix_buffer_t);
+    if (NULL == srp->reply) {
+        PMIX_RELEASE(srp);
+        return NULL;
+    }
+    srp->bfrops = peer->nptr->compat.bfrops;
+    srp->type = peer->nptr->compat.type;
+    if (by_nspace) {
+        srp->nptr = peer->nptr;
+    }
+    pmix_list_append(replies, &srp->super);
+    *created = true;
+    return srp->reply;
+}
+
 /*****    INSTANCE SERVER LIBRARY CLASSES    *****/
 static void tcon(pmix_server_trkr_t *t)
 {
@@ -4596,3 +4680,20 @@ static void iodes(pmix_iof_cache_t *p)
 PMIX_CLASS_INSTANCE(pmix_iof_cache_t,
                     pmix_list_item_t,
                     iocon, iodes);
+
+static void srpcon(pmix_server_shared_reply_t *p)
+{
+    p->bfrops = NULL;
+    p->type = PMIX_BFROP_BUFFER_UNDEF;
+    p->nptr = NULL;
+    p->reply = NULL;
+}
+static void srpdes(pmix_server_shared_reply_t *p)
+{
+    if (NULL != p->reply) {
+        PMIX_RELEASE(p->reply);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_server_shared_reply_t,
+                    pmix_list_item_t,
+                    srpcon, srpdes);
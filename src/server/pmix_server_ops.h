@@ -167,8 +167,20 @@ typedef struct {
 } pmix_iof_cache_t;
 PMIX_CLASS_DECLARATION(pmix_iof_cache_t);
 
+/* reply to the local participants of a collective - those
+ * that are to be sent the same bytes share the buffer */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_bfrops_module_t *bfrops;
+    pmix_bfrop_buffer_type_t type;
+    pmix_namespace_t *nptr;     // only set if the reply depends on the nspace
+    pmix_buffer_t *reply;
+} pmix_server_shared_reply_t;
+PMIX_CLASS_DECLARATION(pmix_server_shared_reply_t);
+
 typedef struct {
     pmix_list_t nspaces;                    // list of pmix_nspace_t for the nspaces we know about
+    pmix_pointer_array_t nspace_index;      // nspaces on the list, indexed by nspace registry id
     pmix_pointer_array_t clients;           // array of pmix_peer_t local clients
     pmix_list_t collectives;                // list of active pmix_server_trkr_t
     pmix_list_t remote_pnd;                 // list of pmix_dmdx_remote_t awaiting arrival of data fror servicing remote req's
@@ -354,6 +366,25 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata);
 
 pmix_status_t pmix_server_initialize(void);
 
+/* maintain the index of the nspaces list - an nspace must be
+ * indexed once it is on the list and has its name assigned,
+ * and unindexed when it is removed from the list */
+PMIX_EXPORT void pmix_server_nspace_index(pmix_namespace_t *nptr);
+PMIX_EXPORT void pmix_server_nspace_unindex(pmix_namespace_t *nptr);
+/* find an nspace on the list by name */
+PMIX_EXPORT pmix_namespace_t* pmix_server_nspace_lookup(const char *nspace);
+
+/* return the reply on the list of pmix_server_shared_reply_t that
+ * is meant for peers using the same bfrops as this one - and, if
+ * by_nspace is set, in the same nspace. If there is none yet, an
+ * empty one is added and created is set so the caller packs it.
+ * The list holds a reference to the reply, so the caller must retain
+ * it for each peer it is queued to */
+PMIX_EXPORT pmix_buffer_t* pmix_server_shared_reply(pmix_list_t *replies,
+                                                    pmix_peer_t *peer,
+                                                    bool by_nspace,
+                                                    bool *created);
+
 void pmix_server_message_handler(struct pmix_peer_t *pr,
                                  pmix_ptl_hdr_t *hdr,
                                  pmix_buffer_t *buf, void *cbdata);
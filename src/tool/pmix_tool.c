@@ -445,8 +445,13 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc,
     rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
     rcv->tag = PMIX_PTL_TAG_IOF;
     rcv->cbfunc = tool_iof_handler;
-    /* add it to the end of the list of recvs */
-    pmix_list_append(&pmix_ptl_globals.posted_recvs, &rcv->super);
+    /* add it to the recvs */
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_add_posted_recv(rcv))) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(rcv);
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return rc;
+    }
 
 
     /* setup the globals */
@@ -615,8 +620,13 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc,
         rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
         rcv->tag = UINT32_MAX;
         rcv->cbfunc = pmix_server_message_handler;
-        /* add it to the end of the list of recvs */
-        pmix_list_append(&pmix_ptl_globals.posted_recvs, &rcv->super);
+        /* add it to the recvs */
+        if (PMIX_SUCCESS != (rc = pmix_ptl_base_add_posted_recv(rcv))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(rcv);
+            PMIX_RELEASE_THREAD(&pmix_global_lock);
+            return rc;
+        }
         /* open the pnet framework so we can harvest envars */
         rc = pmix_mca_base_framework_open(&pmix_pnet_base_framework, 0);
         if (PMIX_SUCCESS != rc){
@@ -1206,6 +1216,7 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
         PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
+        PMIX_DESTRUCT(&pmix_server_globals.nspace_index);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.nspaces);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
     }
@@ -36,6 +36,19 @@
 
 #include "src/util/hash.h"
 
+/* slot of the per-proc key table, keyed by the hash of the
+ * key string - an empty slot has a NULL kv, a slot whose key
+ * was removed holds the tombstone. The key itself is the one
+ * of the stored kval, so the table holds no copy of it */
+typedef struct {
+    uint32_t hash;
+    pmix_kval_t *kv;
+} pmix_proc_key_slot_t;
+
+#define PMIX_PROC_KEYS_INIT_SIZE   16
+#define PMIX_PROC_KEY_TOMBSTONE    ((pmix_kval_t*)&pmix_proc_key_tombstone)
+static char pmix_proc_key_tombstone;
+
 /**
  * Data for a particular pmix process
  * The name association is maintained in the
@@ -45,23 +58,68 @@ typedef struct {
     /** Structure can be put on lists (including in hash tables) */
     pmix_list_item_t super;
     /* List of pmix_kval_t structures containing all data
-       received from this process */
+       received from this process, in the order of arrival */
     pmix_list_t data;
+    /* open-addressing index of the data list by key. The
+     * number of slots is a power of two, allocated on the
+     * first store */
+    pmix_proc_key_slot_t *keys;
+    uint32_t nslots;
+    uint32_t nused;
+    uint32_t ntombs;
 } pmix_proc_data_t;
 static void pdcon(pmix_proc_data_t *p)
 {
     PMIX_CONSTRUCT(&p->data, pmix_list_t);
+    p->keys = NULL;
+    p->nslots = 0;
+    p->nused = 0;
+    p->ntombs = 0;
 }
 static void pddes(pmix_proc_data_t *p)
 {
     PMIX_LIST_DESTRUCT(&p->data);
+    if (NULL != p->keys) {
+        free(p->keys);
+    }
 }
 static PMIX_CLASS_INSTANCE(pmix_proc_data_t,
                            pmix_list_item_t,
                            pdcon, pddes);
 
-static pmix_kval_t* lookup_keyval(pmix_list_t *data,
-                                  const char *key);
+/**
+ * Reference to the key and value of a stored pmix_kval_t, handed
+ * out by pmix_hash_fetch_shared. The stored kval is retained for the
+ * life of the reference, so a later replacement of the data does not
+ * pull it from under the caller.
+ */
+typedef struct {
+    pmix_kval_t super;
+    pmix_kval_t *kv;
+} pmix_hash_shared_kval_t;
+static void skcon(pmix_hash_shared_kval_t *p)
+{
+    p->kv = NULL;
+}
+static void skdes(pmix_hash_shared_kval_t *p)
+{
+    /* the key and value belong to the stored kval */
+    p->super.key = NULL;
+    p->super.value = NULL;
+    if (NULL != p->kv) {
+        PMIX_RELEASE(p->kv);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_hash_shared_kval_t,
+                           pmix_kval_t,
+                           skcon, skdes);
+
+static pmix_proc_key_slot_t* lookup_keyval(pmix_proc_data_t *proc_data,
+                                           const char *key, uint32_t hash);
+static pmix_status_t add_keyval(pmix_proc_data_t *proc_data,
+                                pmix_kval_t *kv, uint32_t hash);
+static void remove_keyval(pmix_proc_data_t *proc_data,
+                          const char *key);
 static pmix_proc_data_t* lookup_proc(pmix_hash_table_t *jtable,
                                      uint64_t id, bool create);
 
@@ -70,13 +128,14 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
 {
     pmix_proc_data_t *proc_data;
     uint64_t id;
-    pmix_kval_t *hv;
+    pmix_proc_key_slot_t *slot;
+    uint32_t hash;
 
     pmix_output_verbose(10, pmix_globals.debug_output,
                         "HASH:STORE rank %d key %s",
                         rank, (NULL == kin) ? "NULL KVAL" : kin->key);
 
-    if (NULL == kin) {
+    if (NULL == kin || NULL == kin->key) {
         return PMIX_ERR_BAD_PARAM;
     }
 
@@ -89,12 +148,16 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
     }
 
     /* see if we already have this key-value */
-    hv = lookup_keyval(&proc_data->data, kin->key);
-    if (NULL != hv) {
+    PMIX_HASH_STR(kin->key, hash);
+    slot = lookup_keyval(proc_data, kin->key, hash);
+    if (NULL != slot) {
         /* yes we do - so remove the current value
-         * and replace it */
-        pmix_list_remove_item(&proc_data->data, &hv->super);
-        PMIX_RELEASE(hv);
+         * and replace it in place */
+        pmix_list_remove_item(&proc_data->data, &slot->kv->super);
+        PMIX_RELEASE(slot->kv);
+        slot->kv = kin;
+    } else if (PMIX_SUCCESS != add_keyval(proc_data, kin, hash)) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
     }
     PMIX_RETAIN(kin);
     pmix_list_append(&proc_data->data, &kin->super);
@@ -108,17 +171,22 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_proc_data_t *proc_data;
     pmix_kval_t *hv;
+    pmix_proc_key_slot_t *slot;
     uint64_t id;
     char *node;
     pmix_info_t *info;
     size_t ninfo, n;
     pmix_value_t *val;
+    uint32_t hash = 0;
 
     pmix_output_verbose(10, pmix_globals.debug_output,
                         "HASH:FETCH rank %d key %s",
                         rank, (NULL == key) ? "NULL" : key);
 
     id = (uint64_t)rank;
+    if (NULL != key) {
+        PMIX_HASH_STR(key, hash);
+    }
 
     /* - PMIX_RANK_UNDEF should return following statuses
      *     PMIX_ERR_PROC_ENTRY_NOT_FOUND | PMIX_SUCCESS
@@ -182,11 +250,11 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
             return PMIX_SUCCESS;
         } else {
             /* find the value from within this proc_data object */
-            hv = lookup_keyval(&proc_data->data, key);
-            if (NULL != hv) {
+            slot = lookup_keyval(proc_data, key, hash);
+            if (NULL != slot) {
                 /* create the copy */
                 PMIX_BFROPS_COPY(rc, pmix_globals.mypeer,
-                                 (void**)kvs, hv->value, PMIX_VALUE);
+                                 (void**)kvs, slot->kv->value, PMIX_VALUE);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     return rc;
@@ -211,14 +279,77 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
     return rc;
 }
 
+static pmix_status_t share_keyval(pmix_kval_t *kv, pmix_list_t *kvs)
+{
+    pmix_hash_shared_kval_t *skv;
+
+    if (NULL == (skv = PMIX_NEW(pmix_hash_shared_kval_t))) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_RETAIN(kv);
+    skv->kv = kv;
+    skv->super.key = kv->key;
+    skv->super.value = kv->value;
+    pmix_list_append(kvs, &skv->super.super);
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_hash_fetch_shared(pmix_hash_table_t *table, pmix_rank_t rank,
+                                     const char *key, pmix_list_t *kvs)
+{
+    pmix_proc_data_t *proc_data;
+    pmix_proc_key_slot_t *slot;
+    pmix_kval_t *hv;
+    pmix_status_t rc;
+    uint32_t hash;
+
+    pmix_output_verbose(10, pmix_globals.debug_output,
+                        "HASH:FETCH SHARED rank %d key %s",
+                        rank, (NULL == key) ? "NULL" : key);
+
+    if (PMIX_RANK_UNDEF == rank) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    if (NULL == (proc_data = lookup_proc(table, (uint64_t)rank, false))) {
+        pmix_output_verbose(10, pmix_globals.debug_output,
+                            "HASH:FETCH SHARED proc data for rank %d not found",
+                            rank);
+        return PMIX_ERR_PROC_ENTRY_NOT_FOUND;
+    }
+
+    /* if the key is NULL, then the user wants -all- data
+     * put by the specified rank */
+    if (NULL == key) {
+        if (0 == pmix_list_get_size(&proc_data->data)) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+        PMIX_LIST_FOREACH(hv, &proc_data->data, pmix_kval_t) {
+            if (PMIX_SUCCESS != (rc = share_keyval(hv, kvs))) {
+                return rc;
+            }
+        }
+        return PMIX_SUCCESS;
+    }
+
+    PMIX_HASH_STR(key, hash);
+    if (NULL == (slot = lookup_keyval(proc_data, key, hash))) {
+        pmix_output_verbose(10, pmix_globals.debug_output,
+                            "HASH:FETCH SHARED data for key %s not found", key);
+        return PMIX_ERR_NOT_FOUND;
+    }
+    return share_keyval(slot->kv, kvs);
+}
+
 pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
                                      pmix_rank_t *rank, pmix_value_t **kvs, void **last)
 {
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_proc_data_t *proc_data;
-    pmix_kval_t *hv;
+    pmix_proc_key_slot_t *slot;
     uint64_t id;
     char *node;
+    uint32_t hash;
     static const char *key_r = NULL;
 
     if (key == NULL && (node = *last) == NULL) {
@@ -250,11 +381,12 @@ pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
     }
 
     /* find the value from within this proc_data object */
-    hv = lookup_keyval(&proc_data->data, key_r);
-    if (hv) {
+    PMIX_HASH_STR(key_r, hash);
+    slot = lookup_keyval(proc_data, key_r, hash);
+    if (NULL != slot) {
         /* create the copy */
         PMIX_BFROPS_COPY(rc, pmix_globals.mypeer,
-                         (void**)kvs, hv->value, PMIX_VALUE);
+                         (void**)kvs, slot->kv->value, PMIX_VALUE);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
@@ -290,13 +422,7 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
                 if (NULL == key) {
                     PMIX_RELEASE(proc_data);
                 } else {
-                    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
-                        if (0 == strcmp(key, kv->key)) {
-                            pmix_list_remove_item(&proc_data->data, &kv->super);
-                            PMIX_RELEASE(kv);
-                            break;
-                        }
-                    }
+                    remove_keyval(proc_data, key);
                 }
             }
             rc = pmix_hash_table_get_next_key_uint64(table, &id,
@@ -324,33 +450,127 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     }
 
     /* remove this item */
-    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
-        if (0 == strcmp(key, kv->key)) {
-            pmix_list_remove_item(&proc_data->data, &kv->super);
-            PMIX_RELEASE(kv);
-            break;
-        }
-    }
+    remove_keyval(proc_data, key);
 
     return PMIX_SUCCESS;
 }
 
 /**
- * Find data for a given key in a given pmix_list_t.
+ * Find the key table slot holding data for a given key
+ * of a given proc.
  */
-static pmix_kval_t* lookup_keyval(pmix_list_t *data,
-                                  const char *key)
+static pmix_proc_key_slot_t* lookup_keyval(pmix_proc_data_t *proc_data,
+                                           const char *key, uint32_t hash)
 {
-    pmix_kval_t *kv;
+    pmix_proc_key_slot_t *slot;
+    uint32_t mask, n;
 
-    PMIX_LIST_FOREACH(kv, data, pmix_kval_t) {
-        if (0 == strcmp(key, kv->key)) {
-            return kv;
+    if (0 == proc_data->nused) {
+        return NULL;
+    }
+    mask = proc_data->nslots - 1;
+    for (n = hash & mask; NULL != (slot = &proc_data->keys[n])->kv; n = (n + 1) & mask) {
+        if (PMIX_PROC_KEY_TOMBSTONE != slot->kv && hash == slot->hash &&
+            0 == strcmp(key, slot->kv->key)) {
+            return slot;
         }
     }
     return NULL;
 }
 
+/**
+ * Rebuild the key table of a proc with the given number of slots,
+ * dropping the tombstones.
+ */
+static pmix_status_t resize_keyval(pmix_proc_data_t *proc_data, uint32_t nslots)
+{
+    pmix_proc_key_slot_t *keys, *slot;
+    uint32_t mask, n, m;
+
+    keys = (pmix_proc_key_slot_t*)calloc(nslots, sizeof(pmix_proc_key_slot_t));
+    if (NULL == keys) {
+        return PMIX_ERR_NOMEM;
+    }
+    mask = nslots - 1;
+    for (n=0; n < proc_data->nslots; n++) {
+        slot = &proc_data->keys[n];
+        if (NULL == slot->kv || PMIX_PROC_KEY_TOMBSTONE == slot->kv) {
+            continue;
+        }
+        for (m = slot->hash & mask; NULL != keys[m].kv; m = (m + 1) & mask);
+        keys[m] = *slot;
+    }
+    if (NULL != proc_data->keys) {
+        free(proc_data->keys);
+    }
+    proc_data->keys = keys;
+    proc_data->nslots = nslots;
+    proc_data->ntombs = 0;
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Index a new key of a proc. The key must not be present yet.
+ */
+static pmix_status_t add_keyval(pmix_proc_data_t *proc_data,
+                                pmix_kval_t *kv, uint32_t hash)
+{
+    pmix_proc_key_slot_t *slot;
+    uint32_t mask, n, nslots;
+    pmix_status_t rc;
+
+    /* keep the load, tombstones included, under 3/4 so
+     * the probe sequences stay short */
+    if (4 * (proc_data->nused + proc_data->ntombs + 1) > 3 * proc_data->nslots) {
+        nslots = proc_data->nslots;
+        if (0 == nslots) {
+            nslots = PMIX_PROC_KEYS_INIT_SIZE;
+        } else if (2 * (proc_data->nused + 1) > nslots) {
+            /* mostly live keys - grow, otherwise it is enough
+             * to get rid of the tombstones */
+            nslots *= 2;
+        }
+        if (PMIX_SUCCESS != (rc = resize_keyval(proc_data, nslots))) {
+            return rc;
+        }
+    }
+    mask = proc_data->nslots - 1;
+    for (n = hash & mask; ; n = (n + 1) & mask) {
+        slot = &proc_data->keys[n];
+        if (NULL == slot->kv) {
+            break;
+        }
+        if (PMIX_PROC_KEY_TOMBSTONE == slot->kv) {
+            proc_data->ntombs--;
+            break;
+        }
+    }
+    slot->hash = hash;
+    slot->kv = kv;
+    proc_data->nused++;
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Remove data for a given key of a given proc
+ */
+static void remove_keyval(pmix_proc_data_t *proc_data,
+                          const char *key)
+{
+    pmix_proc_key_slot_t *slot;
+    uint32_t hash;
+
+    PMIX_HASH_STR(key, hash);
+    if (NULL == (slot = lookup_keyval(proc_data, key, hash))) {
+        return;
+    }
+    pmix_list_remove_item(&proc_data->data, &slot->kv->super);
+    PMIX_RELEASE(slot->kv);
+    slot->kv = PMIX_PROC_KEY_TOMBSTONE;
+    proc_data->nused--;
+    proc_data->ntombs++;
+}
+
 
 /**
  * Find proc_data_t container associated with given
@@ -32,6 +32,15 @@ PMIX_EXPORT pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
 PMIX_EXPORT pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
                                           const char *key, pmix_value_t **kvs);
 
+/* Fetch the stored data for a specified key and rank without
+ * copying it. Each match is appended to the list as a pmix_kval_t
+ * that refers to the stored key and value and keeps them alive
+ * until it is released - the caller must not modify them. A NULL
+ * key returns all data of the rank in the order it was stored.
+ * The rank may not be PMIX_RANK_UNDEF */
+PMIX_EXPORT pmix_status_t pmix_hash_fetch_shared(pmix_hash_table_t *table, pmix_rank_t rank,
+                                                 const char *key, pmix_list_t *kvs);
+
 /* Fetch the value for a specified key from within
  * the given hash_table
  * It gets the next portion of data from table, where matching key.
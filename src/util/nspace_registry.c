@@ -0,0 +1,154 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+#include "include/pmix_common.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_pointer_array.h"
+#include "src/util/error.h"
+
+#include "src/util/nspace_registry.h"
+
+typedef struct {
+    char *name;
+    uint32_t refs;
+} pmix_nspace_registry_entry_t;
+
+/* name -> id */
+static pmix_hash_table_t nspace_ids;
+/* id -> entry, the pointer array hands out the lowest free
+ * index so the ids of released nspaces get recycled */
+static pmix_pointer_array_t nspace_names;
+static bool initialized = false;
+
+pmix_status_t pmix_nspace_registry_init(void)
+{
+    pmix_status_t rc;
+
+    if (initialized) {
+        return PMIX_SUCCESS;
+    }
+    PMIX_CONSTRUCT(&nspace_ids, pmix_hash_table_t);
+    if (PMIX_SUCCESS != (rc = pmix_hash_table_init(&nspace_ids, 256))) {
+        PMIX_DESTRUCT(&nspace_ids);
+        return rc;
+    }
+    PMIX_CONSTRUCT(&nspace_names, pmix_pointer_array_t);
+    if (PMIX_SUCCESS != (rc = pmix_pointer_array_init(&nspace_names, 256, INT_MAX, 256))) {
+        PMIX_DESTRUCT(&nspace_ids);
+        PMIX_DESTRUCT(&nspace_names);
+        return rc;
+    }
+    initialized = true;
+    return PMIX_SUCCESS;
+}
+
+void pmix_nspace_registry_finalize(void)
+{
+    int n;
+    pmix_nspace_registry_entry_t *ent;
+
+    if (!initialized) {
+        return;
+    }
+    for (n=0; n < nspace_names.size; n++) {
+        if (NULL != (ent = (pmix_nspace_registry_entry_t*)pmix_pointer_array_get_item(&nspace_names, n))) {
+            free(ent->name);
+            free(ent);
+        }
+    }
+    PMIX_DESTRUCT(&nspace_names);
+    PMIX_DESTRUCT(&nspace_ids);
+    initialized = false;
+}
+
+uint32_t pmix_nspace_registry_add(const char *nspace)
+{
+    void *value;
+    pmix_nspace_registry_entry_t *ent;
+    int id;
+
+    if (!initialized || NULL == nspace) {
+        return PMIX_NSPACE_INVALID_ID;
+    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&nspace_ids, nspace,
+                                                      strlen(nspace), &value)) {
+        id = (int)(uintptr_t)value;
+        ent = (pmix_nspace_registry_entry_t*)pmix_pointer_array_get_item(&nspace_names, id);
+        ++ent->refs;
+        return (uint32_t)id;
+    }
+    if (NULL == (ent = (pmix_nspace_registry_entry_t*)malloc(sizeof(*ent)))) {
+        return PMIX_NSPACE_INVALID_ID;
+    }
+    if (NULL == (ent->name = strdup(nspace))) {
+        free(ent);
+        return PMIX_NSPACE_INVALID_ID;
+    }
+    ent->refs = 1;
+    if (0 > (id = pmix_pointer_array_add(&nspace_names, ent))) {
+        free(ent->name);
+        free(ent);
+        return PMIX_NSPACE_INVALID_ID;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_set_value_ptr(&nspace_ids, ent->name, strlen(ent->name),
+                                                      (void*)(uintptr_t)id)) {
+        pmix_pointer_array_set_item(&nspace_names, id, NULL);
+        free(ent->name);
+        free(ent);
+        return PMIX_NSPACE_INVALID_ID;
+    }
+    return (uint32_t)id;
+}
+
+void pmix_nspace_registry_release(uint32_t id)
+{
+    pmix_nspace_registry_entry_t *ent;
+
+    if (!initialized || (uint32_t)INT_MAX < id) {
+        return;
+    }
+    ent = (pmix_nspace_registry_entry_t*)pmix_pointer_array_get_item(&nspace_names, (int)id);
+    if (NULL == ent || 0 < --ent->refs) {
+        return;
+    }
+    pmix_hash_table_remove_value_ptr(&nspace_ids, ent->name, strlen(ent->name));
+    pmix_pointer_array_set_item(&nspace_names, (int)id, NULL);
+    free(ent->name);
+    free(ent);
+}
+
+uint32_t pmix_nspace_registry_lookup(const char *nspace)
+{
+    void *value;
+
+    if (!initialized || NULL == nspace) {
+        return PMIX_NSPACE_INVALID_ID;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&nspace_ids, nspace,
+                                                      strlen(nspace), &value)) {
+        return PMIX_NSPACE_INVALID_ID;
+    }
+    return (uint32_t)(uintptr_t)value;
+}
+
+const char* pmix_nspace_registry_name(uint32_t id)
+{
+    pmix_nspace_registry_entry_t *ent;
+
+    if (!initialized || (uint32_t)INT_MAX < id) {
+        return NULL;
+    }
+    ent = (pmix_nspace_registry_entry_t*)pmix_pointer_array_get_item(&nspace_names, (int)id);
+    return (NULL == ent) ? NULL : ent->name;
+}
@@ -0,0 +1,50 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_NSPACE_REGISTRY_H
+#define PMIX_NSPACE_REGISTRY_H
+
+#include <src/include/pmix_config.h>
+#include "include/pmix_common.h"
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h>
+#endif
+
+BEGIN_C_DECLS
+
+/* The namespace registry interns namespace names, handing out a
+ * small integer id for each of them. Subsystems tracking per-nspace
+ * objects index them by the id instead of walking a list and
+ * comparing the names. Each add holds a reference on the name that
+ * must be given back with a release once the holder drops the nspace.
+ * The name is freed and its id recycled when the last reference goes
+ * away, so the id must not be used after releasing it */
+
+#define PMIX_NSPACE_INVALID_ID  UINT32_MAX
+
+PMIX_EXPORT pmix_status_t pmix_nspace_registry_init(void);
+PMIX_EXPORT void pmix_nspace_registry_finalize(void);
+
+/* return the id of the nspace, registering it if necessary,
+ * and take a reference on it */
+PMIX_EXPORT uint32_t pmix_nspace_registry_add(const char *nspace);
+
+/* drop a reference taken by pmix_nspace_registry_add */
+PMIX_EXPORT void pmix_nspace_registry_release(uint32_t id);
+
+/* return the id of the nspace or PMIX_NSPACE_INVALID_ID
+ * if it was never registered */
+PMIX_EXPORT uint32_t pmix_nspace_registry_lookup(const char *nspace);
+
+/* return the name of a registered nspace */
+PMIX_EXPORT const char* pmix_nspace_registry_name(uint32_t id);
+
+END_C_DECLS
+
+#endif /* PMIX_NSPACE_REGISTRY_H */
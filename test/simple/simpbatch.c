@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2013-2019 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "src/class/pmix_object.h"
+#include "src/util/output.h"
+#include "src/util/printf.h"
+
+static pmix_proc_t myproc;
+
+/* check a value returned by the batch against the one
+ * returned by PMIx_Get for the same request */
+static int check_value(const pmix_proc_t *proc, const char *key,
+                       const pmix_info_t *info, size_t ninfo,
+                       pmix_value_t *val, pmix_status_t status)
+{
+    pmix_value_t *ref = NULL;
+    pmix_status_t rc;
+    int ret = 0;
+
+    rc = PMIx_Get(proc, key, info, ninfo, &ref);
+    if (rc != status) {
+        pmix_output(0, "Client ns %s rank %d: batch status %s for %s:%d key %s, PMIx_Get returned %s",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(status),
+                    proc->nspace, proc->rank, key, PMIx_Error_string(rc));
+        ret = 1;
+    } else if (PMIX_SUCCESS == rc) {
+        if (val->type != ref->type ||
+            (PMIX_STRING == val->type && 0 != strcmp(val->data.string, ref->data.string)) ||
+            (PMIX_UINT64 == val->type && val->data.uint64 != ref->data.uint64)) {
+            pmix_output(0, "Client ns %s rank %d: batch value mismatch for %s:%d key %s",
+                        myproc.nspace, myproc.rank, proc->nspace, proc->rank, key);
+            ret = 1;
+        }
+    }
+    if (NULL != ref) {
+        PMIX_VALUE_RELEASE(ref);
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int rc, errs = 0;
+    pmix_value_t value;
+    pmix_value_t *val = &value;
+    pmix_value_t **vals = NULL;
+    pmix_status_t *status = NULL;
+    pmix_proc_t proc, *procs = NULL;
+    const char **keys = NULL;
+    char **names = NULL;
+    pmix_info_t info;
+    pmix_scope_t scope;
+    char *tmp;
+    bool collect = true;
+    uint32_t nprocs, n;
+    size_t nreqs = 0, m;
+
+    /* init us */
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Init failed: %d", myproc.nspace, myproc.rank, rc);
+        exit(0);
+    }
+    pmix_output(0, "Client ns %s rank %d: Running", myproc.nspace, myproc.rank);
+
+    /* get our universe size */
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_UNIV_SIZE, NULL, 0, &val))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get universe size failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    /* put a local and a global value */
+    (void)asprintf(&tmp, "%s-%d-local", myproc.nspace, myproc.rank);
+    value.type = PMIX_UINT64;
+    value.data.uint64 = 1234 + myproc.rank;
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_LOCAL, tmp, &value))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Put local failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    free(tmp);
+    (void)asprintf(&tmp, "%s-%d-remote", myproc.nspace, myproc.rank);
+    value.type = PMIX_STRING;
+    value.data.string = tmp;
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, tmp, &value))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Put global failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    free(tmp);
+    if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Commit failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+
+    /* exchange the data */
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &collect, PMIX_BOOL);
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, &info, 1))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
+    /* ask for both keys of every proc plus the job size */
+    nreqs = 2 * nprocs + 1;
+    procs = (pmix_proc_t*)calloc(nreqs, sizeof(pmix_proc_t));
+    keys = (const char**)calloc(nreqs, sizeof(char*));
+    names = (char**)calloc(nreqs, sizeof(char*));
+    vals = (pmix_value_t**)calloc(nreqs, sizeof(pmix_value_t*));
+    status = (pmix_status_t*)calloc(nreqs, sizeof(pmix_status_t));
+    for (n=0, m=0; n < nprocs; n++) {
+        PMIX_LOAD_PROCID(&procs[m], myproc.nspace, n);
+        (void)asprintf(&names[m], "%s-%d-local", myproc.nspace, n);
+        keys[m] = names[m];
+        ++m;
+        PMIX_LOAD_PROCID(&procs[m], myproc.nspace, n);
+        (void)asprintf(&names[m], "%s-%d-remote", myproc.nspace, n);
+        keys[m] = names[m];
+        ++m;
+    }
+    PMIX_LOAD_PROCID(&procs[m], myproc.nspace, PMIX_RANK_WILDCARD);
+    keys[m] = PMIX_JOB_SIZE;
+
+    rc = pmix_get_batch(procs, keys, nreqs, NULL, 0, vals, status);
+    if (PMIX_SUCCESS != rc) {
+        pmix_output(0, "Client ns %s rank %d: pmix_get_batch failed: %s",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        errs++;
+    }
+    for (m=0; m < nreqs; m++) {
+        errs += check_value(&procs[m], keys[m], NULL, 0, vals[m], status[m]);
+        if (NULL != vals[m]) {
+            PMIX_VALUE_RELEASE(vals[m]);
+        }
+    }
+
+    /* a data scope must be honored the same way as by PMIx_Get */
+    scope = PMIX_REMOTE;
+    PMIX_INFO_LOAD(&info, PMIX_DATA_SCOPE, &scope, PMIX_SCOPE);
+    rc = pmix_get_batch(procs, keys, nreqs - 1, &info, 1, vals, status);
+    for (m=0; m < nreqs - 1; m++) {
+        errs += check_value(&procs[m], keys[m], &info, 1, vals[m], status[m]);
+        if (NULL != vals[m]) {
+            PMIX_VALUE_RELEASE(vals[m]);
+        }
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
+    /* a NULL key must be rejected */
+    keys[0] = NULL;
+    if (PMIX_ERR_BAD_PARAM != pmix_get_batch(procs, keys, 1, NULL, 0, vals, status)) {
+        pmix_output(0, "Client ns %s rank %d: pmix_get_batch accepted a NULL key",
+                    myproc.nspace, myproc.rank);
+        errs++;
+    }
+
+    if (0 == errs) {
+        pmix_output(0, "Client ns %s rank %d: pmix_get_batch of %d requests returned correctly",
+                    myproc.nspace, myproc.rank, (int)nreqs);
+    }
+
+    /* call fence again so everyone waits before leaving */
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(&proc, 1, NULL, 0))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Fence failed: %d", myproc.nspace, myproc.rank, rc);
+        goto done;
+    }
+
+ done:
+    if (NULL != names) {
+        for (m=0; m < nreqs; m++) {
+            if (NULL != names[m]) {
+                free(names[m]);
+            }
+        }
+        free(names);
+    }
+    if (NULL != procs) {
+        free(procs);
+    }
+    if (NULL != keys) {
+        free(keys);
+    }
+    if (NULL != vals) {
+        free(vals);
+    }
+    if (NULL != status) {
+        free(status);
+    }
+    /* finalize us */
+    pmix_output(0, "Client ns %s rank %d: Finalizing", myproc.nspace, myproc.rank);
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize failed: %d\n", myproc.nspace, myproc.rank, rc);
+    } else {
+        fprintf(stderr, "Client ns %s rank %d:PMIx_Finalize successfully completed\n", myproc.nspace, myproc.rank);
+    }
+    fflush(stderr);
+    return(errs);
+}
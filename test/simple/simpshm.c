@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Checks the segments of the ptl/shm transport: the server creates one
+ * per client when it sets up the fork, the clients exchange data over
+ * them, and each segment is removed when its client is deregistered.
+ *
+ *  simpshm -d DIR [-n N] [-s]
+ *
+ * DIR is used as the server tmpdir, -s tells that the transport is
+ * expected to be used (otherwise no segment may show up).
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "src/util/argv.h"
+#include "src/util/pmix_environ.h"
+
+#include "simptest.h"
+
+#define SIMPSHM_NSPACE  "simpshm"
+
+static pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
+                                const pmix_info_t info[], size_t ninfo,
+                                char *data, size_t ndata,
+                                pmix_modex_cbfunc_t cbfunc, void *cbdata);
+
+static pmix_server_module_t mymodule = {
+    .fence_nb = fencenb_fn
+};
+
+static void fencbfn(int sd, short args, void *cbdata)
+{
+    pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
+
+    /* all participants are local - pass the data back */
+    scd->cbfunc.modexcbfunc(scd->status, scd->data, scd->ndata, scd->cbdata, NULL, NULL);
+    PMIX_RELEASE(scd);
+}
+
+static pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
+                                const pmix_info_t info[], size_t ninfo,
+                                char *data, size_t ndata,
+                                pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_shift_caddy_t *scd;
+
+    scd = PMIX_NEW(pmix_shift_caddy_t);
+    scd->status = PMIX_SUCCESS;
+    scd->data = data;
+    scd->ndata = ndata;
+    scd->cbfunc.modexcbfunc = cbfunc;
+    scd->cbdata = cbdata;
+    PMIX_THREADSHIFT(scd, fencbfn);
+    return PMIX_SUCCESS;
+}
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    mylock_t *lock = (mylock_t*)cbdata;
+
+    lock->status = status;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+/* wait for an operation that was started with opcbfunc */
+static pmix_status_t wait_op(mylock_t *lock, pmix_status_t rc)
+{
+    if (PMIX_SUCCESS == rc) {
+        DEBUG_WAIT_THREAD(lock);
+        rc = lock->status;
+    } else if (PMIX_OPERATION_SUCCEEDED == rc) {
+        rc = PMIX_SUCCESS;
+    }
+    DEBUG_DESTRUCT_LOCK(lock);
+    return rc;
+}
+
+/* count the segments in the tmpdir */
+static int count_segments(const char *dir)
+{
+    DIR *dp;
+    struct dirent *ent;
+    int cnt = 0;
+
+    if (NULL == (dp = opendir(dir))) {
+        return -1;
+    }
+    while (NULL != (ent = readdir(dp))) {
+        if (0 == strncmp(ent->d_name, "pmix_ptl_shm.", strlen("pmix_ptl_shm."))) {
+            ++cnt;
+        }
+    }
+    closedir(dp);
+    return cnt;
+}
+
+/* each client puts its rank, fences and reads the rank of its
+ * neighbor - the exit status tells if that worked */
+static int run_client(void)
+{
+    pmix_proc_t myproc, proc;
+    pmix_value_t value, *val = NULL;
+    pmix_info_t info;
+    pmix_key_t key;
+    bool collect = true;
+    uint32_t nprocs;
+    int ret = 1;
+
+    if (PMIX_SUCCESS != PMIx_Init(&myproc, NULL, 0)) {
+        return 1;
+    }
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    if (PMIX_SUCCESS != PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val)) {
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    PMIX_LOAD_KEY(key, "simpshm.rank");
+    value.type = PMIX_UINT32;
+    value.data.uint32 = myproc.rank;
+    if (PMIX_SUCCESS != PMIx_Put(PMIX_GLOBAL, key, &value) ||
+        PMIX_SUCCESS != PMIx_Commit()) {
+        goto done;
+    }
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &collect, PMIX_BOOL);
+    if (PMIX_SUCCESS != PMIx_Fence(&proc, 1, &info, 1)) {
+        goto done;
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
+    proc.rank = (myproc.rank + 1) % nprocs;
+    if (PMIX_SUCCESS != PMIx_Get(&proc, key, NULL, 0, &val)) {
+        goto done;
+    }
+    if (PMIX_UINT32 == val->type && proc.rank == val->data.uint32) {
+        ret = 0;
+    }
+    PMIX_VALUE_RELEASE(val);
+
+  done:
+    if (PMIX_SUCCESS != PMIx_Finalize(NULL, 0)) {
+        ret = 1;
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    char **client_env = NULL, *client_argv[3];
+    char *dir = NULL, *ranks, **atmp = NULL, *tmp;
+    char hostname[PMIX_MAXHOSTNAMELEN], *regex, *ppn;
+    bool use_shm = false;
+    int nprocs = 2, n, status, nsegs, errs = 0;
+    uint32_t jsize;
+    pid_t *pids;
+    pmix_nspace_t nspace;
+    pmix_proc_t proc;
+    pmix_info_t *info;
+    mylock_t lock;
+    pmix_status_t rc;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-c", argv[n])) {
+            return run_client();
+        } else if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-d", argv[n]) && NULL != argv[n+1]) {
+            dir = argv[++n];
+        } else if (0 == strcmp("-s", argv[n])) {
+            use_shm = true;
+        }
+    }
+    if (NULL == dir || 0 >= nprocs) {
+        fprintf(stderr, "usage: simpshm -d DIR [-n N] [-s]\n");
+        exit(1);
+    }
+
+    PMIX_INFO_CREATE(info, 1);
+    PMIX_INFO_LOAD(&info[0], PMIX_SERVER_TMPDIR, dir, PMIX_STRING);
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, info, 1))) {
+        fprintf(stderr, "Init failed with error %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_INFO_FREE(info, 1);
+
+    /* a single namespace for all clients */
+    for (n=0; n < nprocs; n++) {
+        if (0 > asprintf(&tmp, "%d", n)) {
+            exit(1);
+        }
+        pmix_argv_append_nosize(&atmp, tmp);
+        free(tmp);
+    }
+    ranks = pmix_argv_join(atmp, ',');
+    pmix_argv_free(atmp);
+    gethostname(hostname, sizeof(hostname));
+    PMIx_generate_regex(hostname, &regex);
+    PMIx_generate_ppn(ranks, &ppn);
+    jsize = nprocs;
+    PMIX_INFO_CREATE(info, 6);
+    PMIX_INFO_LOAD(&info[0], PMIX_UNIV_SIZE, &jsize, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[1], PMIX_JOB_SIZE, &jsize, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[2], PMIX_LOCAL_SIZE, &jsize, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[3], PMIX_LOCAL_PEERS, ranks, PMIX_STRING);
+    PMIX_INFO_LOAD(&info[4], PMIX_NODE_MAP, regex, PMIX_STRING);
+    PMIX_INFO_LOAD(&info[5], PMIX_PROC_MAP, ppn, PMIX_STRING);
+    PMIX_LOAD_NSPACE(nspace, SIMPSHM_NSPACE);
+    DEBUG_CONSTRUCT_LOCK(&lock);
+    rc = wait_op(&lock, PMIx_server_register_nspace(nspace, nprocs, info, 6,
+                                                    opcbfunc, &lock));
+    PMIX_INFO_FREE(info, 6);
+    free(ranks);
+    free(regex);
+    free(ppn);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "Register nspace failed with error %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    /* the server creates the segment of a client with its environment */
+    client_env = pmix_argv_copy(environ);
+    client_argv[0] = argv[0];
+    client_argv[1] = "-c";
+    client_argv[2] = NULL;
+    pids = (pid_t*)calloc(nprocs, sizeof(pid_t));
+    PMIX_LOAD_NSPACE(proc.nspace, nspace);
+    for (n=0; n < nprocs; n++) {
+        proc.rank = n;
+        DEBUG_CONSTRUCT_LOCK(&lock);
+        rc = wait_op(&lock, PMIx_server_register_client(&proc, getuid(), getgid(),
+                                                        NULL, opcbfunc, &lock));
+        if (PMIX_SUCCESS != rc ||
+            PMIX_SUCCESS != (rc = PMIx_server_setup_fork(&proc, &client_env))) {
+            fprintf(stderr, "Client %d setup failed with error %s\n", n, PMIx_Error_string(rc));
+            exit(1);
+        }
+        nsegs = count_segments(dir);
+        if (nsegs != (use_shm ? n + 1 : 0)) {
+            fprintf(stderr, "%d segments after the setup of client %d\n", nsegs, n);
+            ++errs;
+        }
+        if (0 > (pids[n] = fork())) {
+            fprintf(stderr, "Fork failed\n");
+            exit(1);
+        }
+        if (0 == pids[n]) {
+            execve(argv[0], client_argv, client_env);
+            exit(1);
+        }
+    }
+    pmix_argv_free(client_env);
+
+    for (n=0; n < nprocs; n++) {
+        if (pids[n] != waitpid(pids[n], &status, 0) ||
+            !WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+            fprintf(stderr, "Client %d failed\n", n);
+            ++errs;
+        }
+    }
+    free(pids);
+
+    /* the segment of a client goes away with its registration */
+    for (n=0; n < nprocs; n++) {
+        proc.rank = n;
+        DEBUG_CONSTRUCT_LOCK(&lock);
+        PMIx_server_deregister_client(&proc, opcbfunc, &lock);
+        (void)wait_op(&lock, PMIX_SUCCESS);
+        nsegs = count_segments(dir);
+        if (nsegs != (use_shm ? nprocs - n - 1 : 0)) {
+            fprintf(stderr, "%d segments after the deregistration of client %d\n", nsegs, n);
+            ++errs;
+        }
+    }
+    DEBUG_CONSTRUCT_LOCK(&lock);
+    PMIx_server_deregister_nspace(nspace, opcbfunc, &lock);
+    (void)wait_op(&lock, PMIX_SUCCESS);
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_finalize())) {
+        fprintf(stderr, "Finalize failed with error %s\n", PMIx_Error_string(rc));
+        ++errs;
+    }
+    if (0 != (nsegs = count_segments(dir))) {
+        fprintf(stderr, "%d segments left behind\n", nsegs);
+        ++errs;
+    }
+
+    if (0 == errs) {
+        fprintf(stderr, "Test finished OK!\n");
+    }
+    return (0 == errs) ? 0 : 1;
+}
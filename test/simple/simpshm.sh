@@ -0,0 +1,39 @@
+#!/bin/bash
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+# Run simpshm with the ptl/shm transport on and then off, each time
+# in a fresh tmpdir that must be empty of segments afterwards.
+#
+#  ./simpshm.sh [nprocs]
+#
+
+NPROCS=${1:-4}
+rc=0
+
+run() {
+    dir=$(mktemp -d "${TMPDIR:-/tmp}/simpshm.XXXXXX") || exit 1
+    ./simpshm -d "$dir" -n $NPROCS "$@"
+    status=$?
+    if [ 0 -ne $status ]; then
+        echo "simpshm $* failed with PMIX_MCA_ptl=$PMIX_MCA_ptl: status $status"
+        rc=1
+    fi
+    if [ -n "$(find "$dir" -name 'pmix_ptl_shm.*')" ]; then
+        echo "simpshm $* left segments behind with PMIX_MCA_ptl=$PMIX_MCA_ptl"
+        rc=1
+    fi
+    rm -rf "$dir"
+}
+
+export PMIX_MCA_ptl=tcp,shm
+run -s
+
+export PMIX_MCA_ptl=tcp
+run
+
+exit $rc